@@ -0,0 +1,251 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/nmsTileQueue.h"
+#include "common/topKSelect.h"
+#include "deploy/vision/decode.hpp"
+#include "efficientIdxNMSPlugin/efficientIdxNMSReference.h"
+#include "efficientRotatedNMSPlugin/efficientRotatedNMSReference.h"
+#include "efficientTopKPlugin/efficientTopKReference.h"
+
+namespace {
+
+constexpr int kAnchors       = 8400;  // YOLOv8 / YOLO11 at 640x640
+constexpr int kClasses       = 80;
+constexpr int kSelectedBoxes = 5000;  // numSelectedBoxes of the NMS plugins on most devices
+
+// Synthetic class scores: mostly close to zero with a long tail, like sigmoid outputs of a detection head
+std::vector<float> makeScores(int count, unsigned seed = 42) {
+    std::mt19937                          gen(seed);
+    std::uniform_real_distribution<float> dist(0.0F, 1.0F);
+    std::vector<float>                    scores(count);
+    for (auto& score : scores) {
+        float u = dist(gen);
+        score   = u * u * u * u * u * u * u * u;
+    }
+    return scores;
+}
+
+std::vector<float> makeBoxes(int count, unsigned seed = 7) {
+    std::mt19937                          gen(seed);
+    std::uniform_real_distribution<float> center(0.0F, 640.0F);
+    std::uniform_real_distribution<float> size(8.0F, 160.0F);
+    std::vector<float>                    boxes(static_cast<size_t>(count) * 4);
+    for (int i = 0; i < count; ++i) {
+        float x = center(gen), y = center(gen), w = size(gen), h = size(gen);
+        boxes[i * 4 + 0] = x - w / 2;
+        boxes[i * 4 + 1] = y - h / 2;
+        boxes[i * 4 + 2] = x + w / 2;
+        boxes[i * 4 + 3] = y + h / 2;
+    }
+    return boxes;
+}
+
+std::vector<float> makeRotatedBoxes(int count, unsigned seed = 7) {
+    std::mt19937                          gen(seed);
+    std::uniform_real_distribution<float> angle(-1.57F, 1.57F);
+    auto                                  corners = makeBoxes(count, seed);
+    std::vector<float>                    boxes(static_cast<size_t>(count) * 5);
+    for (int i = 0; i < count; ++i) {
+        std::copy_n(corners.begin() + i * 4, 4, boxes.begin() + i * 5);
+        boxes[i * 5 + 4] = angle(gen);
+    }
+    return boxes;
+}
+
+}  // namespace
+
+// Candidate ordering as done before the top-K stage: a stable descending sort of every score of the image
+static void BM_ScoreSortFull(benchmark::State& state) {
+    auto                 scores = makeScores(kAnchors * kClasses);
+    std::vector<int32_t> order(scores.size());
+
+    for (auto _ : state) {
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int32_t a, int32_t b) { return scores[a] > scores[b]; });
+        benchmark::DoNotOptimize(order.data());
+    }
+    state.SetItemsProcessed(state.iterations() * scores.size());
+}
+BENCHMARK(BM_ScoreSortFull)->Unit(benchmark::kMillisecond);
+
+// Radix select of the top numSelectedBoxes scores, then a stable sort of the selection only
+static void BM_ScoreTopKSelect(benchmark::State& state) {
+    auto                  scores = makeScores(kAnchors * kClasses);
+    int32_t               k      = static_cast<int32_t>(state.range(0));
+    std::vector<uint32_t> keys(scores.size());
+    std::vector<int32_t>  selected(k);
+
+    for (auto _ : state) {
+        std::transform(scores.begin(), scores.end(), keys.begin(), nvinfer1::plugin::topKSelectKey);
+        int32_t count = nvinfer1::plugin::topKSelectReference(keys.data(), static_cast<int32_t>(keys.size()), k, 32, selected.data());
+        std::stable_sort(selected.begin(), selected.begin() + count, [&](int32_t a, int32_t b) { return scores[a] > scores[b]; });
+        benchmark::DoNotOptimize(selected.data());
+    }
+    state.SetItemsProcessed(state.iterations() * scores.size());
+}
+BENCHMARK(BM_ScoreTopKSelect)->Arg(1000)->Arg(kSelectedBoxes)->Arg(8192)->Unit(benchmark::kMillisecond);
+
+// Host reference of EfficientIdxNMS on one image, at the evaluation (0.001) and deployment (0.25) thresholds
+static void BM_EfficientIdxNMSReference(benchmark::State& state) {
+    nvinfer1::plugin::EfficientIdxNMSParameters param;
+    param.scoreThreshold   = static_cast<float>(state.range(0)) / 1000.0F;
+    param.iouThreshold     = 0.45F;
+    param.numOutputBoxes   = 300;
+    param.numSelectedBoxes = kSelectedBoxes;
+    param.nmsAlgorithm     = static_cast<int32_t>(state.range(1));
+    param.batchSize        = 1;
+    param.numClasses       = kClasses;
+    param.numAnchors       = kAnchors;
+    param.numScoreElements = kAnchors * kClasses;
+    param.numBoxElements   = kAnchors * 4;
+
+    auto                 scores = makeScores(param.numScoreElements);
+    auto                 boxes  = makeBoxes(kAnchors);
+    int32_t              numDetections;
+    std::vector<float>   nmsBoxes(param.numOutputBoxes * 4), nmsScores(param.numOutputBoxes);
+    std::vector<int32_t> nmsClasses(param.numOutputBoxes), nmsIndices(param.numOutputBoxes);
+
+    for (auto _ : state) {
+        EfficientIdxNMSReference(param, boxes.data(), scores.data(), nullptr, &numDetections, nmsBoxes.data(),
+                                 nmsScores.data(), nmsClasses.data(), nmsIndices.data(), 1);
+        benchmark::DoNotOptimize(numDetections);
+    }
+    state.counters["detections"] = numDetections;
+}
+BENCHMARK(BM_EfficientIdxNMSReference)
+    ->ArgNames({"threshold_x1000", "nms_algorithm"})
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({250, 0})
+    ->Args({250, 1})
+    ->Unit(benchmark::kMillisecond);
+
+// Host reference of EfficientRotatedNMS on one image (YOLO OBB at 1024x1024, 15 classes), exact polygon IoU vs ProbIoU
+static void BM_EfficientRotatedNMSReference(benchmark::State& state) {
+    nvinfer1::plugin::EfficientRotatedNMSParameters param;
+    param.scoreThreshold   = 0.25F;
+    param.iouThreshold     = 0.45F;
+    param.numOutputBoxes   = 300;
+    param.numSelectedBoxes = kSelectedBoxes;
+    param.iouMode          = static_cast<int32_t>(state.range(0));
+    param.batchSize        = 1;
+    param.numClasses       = 15;
+    param.numAnchors       = 21504;
+    param.numScoreElements = param.numAnchors * param.numClasses;
+    param.numBoxElements   = param.numAnchors * 5;
+
+    auto                 scores = makeScores(param.numScoreElements);
+    auto                 boxes  = makeRotatedBoxes(param.numAnchors);
+    int32_t              numDetections;
+    std::vector<float>   nmsBoxes(param.numOutputBoxes * 5), nmsScores(param.numOutputBoxes);
+    std::vector<int32_t> nmsClasses(param.numOutputBoxes);
+
+    for (auto _ : state) {
+        EfficientRotatedNMSReference(param, boxes.data(), scores.data(), nullptr, &numDetections, nmsBoxes.data(),
+                                     nmsScores.data(), nmsClasses.data(), 1);
+        benchmark::DoNotOptimize(numDetections);
+    }
+    state.counters["detections"] = numDetections;
+}
+BENCHMARK(BM_EfficientRotatedNMSReference)->ArgName("iou_mode")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Host decode of a raw YOLOv8 / YOLO11 head on one image, for engines exported without the NMS plugin, at the
+// same thresholds as BM_EfficientIdxNMSReference
+static void BM_DecodeRawHead(benchmark::State& state) {
+    deploy::RawHead head;
+    head.numClasses     = kClasses;
+    head.numAnchors     = kAnchors;
+    head.scoreThreshold = static_cast<float>(state.range(0)) / 1000.0F;
+    head.iouThreshold   = 0.45F;
+    head.maxDets        = 300;
+
+    // [4 + classes, anchors]: box centers and sizes, then the class scores
+    auto               scores = makeScores(kAnchors * kClasses);
+    auto               boxes  = makeBoxes(kAnchors);
+    std::vector<float> output(static_cast<size_t>(4 + kClasses) * kAnchors);
+    for (int i = 0; i < kAnchors; ++i) {
+        output[i]                = (boxes[i * 4 + 0] + boxes[i * 4 + 2]) / 2;
+        output[kAnchors + i]     = (boxes[i * 4 + 1] + boxes[i * 4 + 3]) / 2;
+        output[2 * kAnchors + i] = boxes[i * 4 + 2] - boxes[i * 4 + 0];
+        output[3 * kAnchors + i] = boxes[i * 4 + 3] - boxes[i * 4 + 1];
+        for (int c = 0; c < kClasses; ++c) {
+            output[static_cast<size_t>(4 + c) * kAnchors + i] = scores[i * kClasses + c];
+        }
+    }
+
+    deploy::RawDecodeWorkspace workspace;
+    int                        numDetections = 0;
+    for (auto _ : state) {
+        numDetections = deploy::decodeRawHead(output.data(), head, workspace);
+        benchmark::DoNotOptimize(numDetections);
+    }
+    state.counters["detections"] = numDetections;
+}
+BENCHMARK(BM_DecodeRawHead)->ArgName("threshold_x1000")->Arg(1)->Arg(250)->Unit(benchmark::kMillisecond);
+
+// Host reference of EfficientTopK on one image (YOLOv10 head, 300 detections)
+static void BM_EfficientTopKReference(benchmark::State& state) {
+    nvinfer1::plugin::EfficientTopKParameters param;
+    param.scoreThreshold   = static_cast<float>(state.range(0)) / 1000.0F;
+    param.numOutputBoxes   = 300;
+    param.batchSize        = 1;
+    param.numClasses       = kClasses;
+    param.numAnchors       = kAnchors;
+    param.numScoreElements = kAnchors * kClasses;
+
+    auto                 scores = makeScores(param.numScoreElements);
+    auto                 boxes  = makeBoxes(kAnchors);
+    int32_t              numDetections;
+    std::vector<float>   topKBoxes(param.numOutputBoxes * 4), topKScores(param.numOutputBoxes);
+    std::vector<int32_t> topKClasses(param.numOutputBoxes);
+
+    for (auto _ : state) {
+        EfficientTopKReference(param, boxes.data(), scores.data(), &numDetections, topKBoxes.data(), topKScores.data(),
+                               topKClasses.data());
+        benchmark::DoNotOptimize(numDetections);
+    }
+    state.counters["detections"] = numDetections;
+}
+BENCHMARK(BM_EfficientTopKReference)->ArgName("threshold_x1000")->Arg(1)->Arg(250)->Unit(benchmark::kMillisecond);
+
+// Bitmask NMS mask pass over a batch of 32 cameras where 4 crowded frames have 8192 candidates and the others
+// 64, 1 or none. Compares the makespan, in IOU evaluations, of one block per image with the work queue drained
+// by a persistent grid of 512 blocks.
+static void BM_NMSTileQueueSchedule(benchmark::State& state) {
+    constexpr int        kBatch = 32, kTileSize = 64, kBlocks = 512;
+    std::vector<int32_t> numBoxes(kBatch);
+    for (int i = 0; i < kBatch; ++i) {
+        numBoxes[i] = i % 8 == 0 ? 8192 : (i % 3 == 0 ? 0 : (i % 3 == 1 ? 64 : 1));
+    }
+
+    // -1 means the queue did not cover the tiles of every image exactly once, the makespans would be meaningless
+    int64_t perImage = 0;
+    for (int i = 0; i < kBatch; ++i) {
+        int64_t makespan = nvinfer1::plugin::nmsTileQueueReference(&numBoxes[i], 1, kTileSize, 1, nullptr);
+        if (makespan < 0) {
+            state.SkipWithError(("Tile queue coverage error on image " + std::to_string(i)).c_str());
+            return;
+        }
+        perImage = std::max(perImage, makespan);
+    }
+
+    int64_t makespan = 0;
+    for (auto _ : state) {
+        makespan = nvinfer1::plugin::nmsTileQueueReference(numBoxes.data(), kBatch, kTileSize, kBlocks, nullptr);
+        benchmark::DoNotOptimize(makespan);
+    }
+    if (makespan < 0) {
+        state.SkipWithError("Tile queue coverage error on the batch");
+        return;
+    }
+    state.counters["per_image_makespan"] = static_cast<double>(perImage);
+    state.counters["queue_makespan"]     = static_cast<double>(makespan);
+}
+BENCHMARK(BM_NMSTileQueueSchedule)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "deploy/vision/devicePool.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+constexpr int kDevices = 4;
+constexpr int kBatches = 64;
+constexpr int kBatch   = 4;
+
+// Mock latency per image of each device: two cards, then two cards slower by the factor given as argument
+float imageLatency(int device, int64_t slowdown) {
+    return device < kDevices / 2 ? 1.0F : static_cast<float>(slowdown);
+}
+
+}  // namespace
+
+// Burst of batches spread by the device pool over mocked devices of mixed speeds
+static void BM_DevicePoolMixedSpeeds(benchmark::State& state) {
+    int64_t                               slowdown = state.range(0);
+    deploy::DevicePool<deploy::DetResult> pool(
+        [slowdown](int device) -> std::unique_ptr<deploy::BaseTemplate<deploy::DetResult>> {
+            return std::make_unique<bench::MockTemplate<deploy::DetResult>>(kBatch, 2.0F, imageLatency(device, slowdown));
+        },
+        {0, 1, 2, 3});
+    std::vector<deploy::Image> images(kBatch);
+
+    for (auto _ : state) {
+        std::vector<std::future<std::vector<deploy::DetResult>>> futures;
+        for (int i = 0; i < kBatches; ++i) {
+            futures.push_back(pool.submit(images));
+        }
+        for (auto& future : futures) {
+            benchmark::DoNotOptimize(future.get());
+        }
+    }
+
+    auto loads = pool.loads();
+    for (const auto& load : loads) {
+        state.counters["device" + std::to_string(load.device) + "_batches"] = static_cast<double>(load.completed);
+    }
+    state.SetItemsProcessed(state.iterations() * kBatches * kBatch);
+}
+BENCHMARK(BM_DevicePoolMixedSpeeds)->ArgName("slowdown")->Arg(1)->Arg(3)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Same burst dealt round-robin to one thread per device, as done by hand before the pool
+static void BM_RoundRobinMixedSpeeds(benchmark::State& state) {
+    int64_t                                                              slowdown = state.range(0);
+    std::vector<std::unique_ptr<bench::MockTemplate<deploy::DetResult>>> models;
+    for (int device = 0; device < kDevices; ++device) {
+        models.push_back(std::make_unique<bench::MockTemplate<deploy::DetResult>>(kBatch, 2.0F, imageLatency(device, slowdown)));
+    }
+    std::vector<deploy::Image> images(kBatch);
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (int device = 0; device < kDevices; ++device) {
+            threads.emplace_back([&, device]() {
+                for (int i = device; i < kBatches; i += kDevices) {
+                    benchmark::DoNotOptimize(models[device]->predict(images));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kBatches * kBatch);
+}
+BENCHMARK(BM_RoundRobinMixedSpeeds)->ArgName("slowdown")->Arg(1)->Arg(3)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include "synthetic.hpp"
+
+// Post-processing of one image with a given number of detections
+template <typename T>
+static void BM_PostProcess(benchmark::State& state) {
+    int                         numDets = static_cast<int>(state.range(0));
+    bench::SyntheticTemplate<T> model(numDets);
+
+    for (auto _ : state) {
+        auto result = model.run();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * numDets);
+}
+
+BENCHMARK_TEMPLATE(BM_PostProcess, deploy::DetResult)->Arg(0)->Arg(10)->Arg(100)->Arg(300);
+BENCHMARK_TEMPLATE(BM_PostProcess, deploy::OBBResult)->Arg(0)->Arg(10)->Arg(100)->Arg(300);
+BENCHMARK_TEMPLATE(BM_PostProcess, deploy::SegResult)->Arg(0)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_PostProcess, deploy::PoseResult)->Arg(0)->Arg(10)->Arg(100)->Arg(300);
+
+// Post-processing of one image into the result of the previous iteration, as done by predictInto
+template <typename T>
+static void BM_PostProcessInto(benchmark::State& state) {
+    int                         numDets = static_cast<int>(state.range(0));
+    bench::SyntheticTemplate<T> model(numDets);
+    T                           result;
+
+    for (auto _ : state) {
+        model.runInto(result);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * numDets);
+}
+
+BENCHMARK_TEMPLATE(BM_PostProcessInto, deploy::DetResult)->Arg(0)->Arg(10)->Arg(100)->Arg(300);
+BENCHMARK_TEMPLATE(BM_PostProcessInto, deploy::OBBResult)->Arg(0)->Arg(10)->Arg(100)->Arg(300);
+BENCHMARK_TEMPLATE(BM_PostProcessInto, deploy::SegResult)->Arg(0)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_PostProcessInto, deploy::PoseResult)->Arg(0)->Arg(10)->Arg(100)->Arg(300);
+
+// Post-processing of a full batch, as done after each predict call, serially or on a thread pool
+template <typename T>
+static void BM_PostProcessBatch(benchmark::State& state) {
+    int                         batch = static_cast<int>(state.range(0));
+    bench::SyntheticTemplate<T> model(100, batch);
+    model.setPostProcessThreads(static_cast<int>(state.range(1)));
+
+    for (auto _ : state) {
+        auto results = model.predict(std::vector<deploy::Image>{});
+        benchmark::DoNotOptimize(results);
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK_TEMPLATE(BM_PostProcessBatch, deploy::DetResult)
+    ->ArgNames({"batch", "threads"})
+    ->Args({1, 1})
+    ->Args({8, 1})
+    ->Args({32, 1})
+    ->Args({32, 4})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PostProcessBatch, deploy::SegResult)
+    ->ArgNames({"batch", "threads"})
+    ->Args({1, 1})
+    ->Args({8, 1})
+    ->Args({16, 1})
+    ->Args({16, 4})
+    ->Args({16, 8})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PostProcessBatch, deploy::PoseResult)
+    ->ArgNames({"batch", "threads"})
+    ->Args({16, 1})
+    ->Args({16, 4})
+    ->UseRealTime();
+
+// Device-resident results on the host contract of the mocked backend: the batch is only mapped back to the
+// source images, without building result vectors
+template <typename T>
+static void BM_PredictDevice(benchmark::State& state) {
+    int                         batch = static_cast<int>(state.range(0));
+    bench::SyntheticTemplate<T> model(100, batch);
+    deploy::DeviceDetections    detections;
+
+    for (auto _ : state) {
+        model.predictDevice(std::vector<deploy::Image>{}, detections);
+        benchmark::DoNotOptimize(detections.boxes);
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK_TEMPLATE(BM_PredictDevice, deploy::DetResult)->ArgName("batch")->Arg(1)->Arg(8)->Arg(32);
+BENCHMARK_TEMPLATE(BM_PredictDevice, deploy::SegResult)->ArgName("batch")->Arg(1)->Arg(8);
+BENCHMARK_TEMPLATE(BM_PredictDevice, deploy::PoseResult)->ArgName("batch")->Arg(16);
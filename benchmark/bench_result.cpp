@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "synthetic.hpp"
+
+// Deep copy of a result, as done when results are returned to Python or stored by callers
+template <typename T>
+static void BM_ResultCopy(benchmark::State& state) {
+    bench::SyntheticTemplate<T> model(static_cast<int>(state.range(0)));
+    T                           source = model.run();
+
+    for (auto _ : state) {
+        T copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ResultCopy, deploy::DetResult)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_ResultCopy, deploy::OBBResult)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_ResultCopy, deploy::SegResult)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_ResultCopy, deploy::PoseResult)->Arg(10)->Arg(100);
+
+// Move construction and move assignment of a result, which should not depend on its size
+template <typename T>
+static void BM_ResultMove(benchmark::State& state) {
+    bench::SyntheticTemplate<T> model(static_cast<int>(state.range(0)));
+    T                           source = model.run();
+
+    for (auto _ : state) {
+        T moved(std::move(source));
+        source = std::move(moved);
+        benchmark::DoNotOptimize(source);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ResultMove, deploy::DetResult)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_ResultMove, deploy::OBBResult)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_ResultMove, deploy::SegResult)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(BM_ResultMove, deploy::PoseResult)->Arg(10)->Arg(100);
+
+// Same validation and copy into a contiguous array as Mask2PyArray in the Python bindings
+static void BM_MaskToArray(benchmark::State& state) {
+    int          size = static_cast<int>(state.range(0));
+    deploy::Mask mask(size, size);
+
+    std::vector<uint8_t> array;
+    for (auto _ : state) {
+        if (mask.width <= 0 || mask.height <= 0 || static_cast<size_t>(mask.width * mask.height) != mask.data.size()) {
+            throw std::invalid_argument("Invalid mask.");
+        }
+        array.resize(static_cast<size_t>(mask.height) * mask.width);
+        std::memcpy(array.data(), mask.data.data(), array.size());
+        benchmark::DoNotOptimize(array.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(mask.data.size()));
+}
+BENCHMARK(BM_MaskToArray)->Arg(160)->Arg(640)->Arg(1920);
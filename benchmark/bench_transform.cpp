@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "deploy/vision/cudaWarp.hpp"
+#include "synthetic.hpp"
+
+// Recomputes the warp matrix on every call by alternating the source size
+static void BM_TransformMatrixUpdate(benchmark::State& state) {
+    deploy::TransformMatrix matrix{};
+    bool                    flip = false;
+
+    for (auto _ : state) {
+        matrix.update(flip ? 1920 : 1280, flip ? 1080 : 720, 640, 640);
+        benchmark::DoNotOptimize(matrix);
+        flip = !flip;
+    }
+}
+BENCHMARK(BM_TransformMatrixUpdate);
+
+// Early exit when the source size did not change
+static void BM_TransformMatrixUpdateCached(benchmark::State& state) {
+    deploy::TransformMatrix matrix{};
+
+    for (auto _ : state) {
+        matrix.update(1920, 1080, 640, 640);
+        benchmark::DoNotOptimize(matrix);
+    }
+}
+BENCHMARK(BM_TransformMatrixUpdateCached);
+
+// Maps points from the model input back to the source image
+static void BM_TransformMatrixTransform(benchmark::State& state) {
+    deploy::TransformMatrix matrix{};
+    matrix.update(1920, 1080, 640, 640);
+
+    std::vector<float> points(static_cast<size_t>(state.range(0)) * 2);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i] = static_cast<float>(i % 640);
+    }
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < points.size(); i += 2) {
+            float x, y;
+            matrix.transform(points[i], points[i + 1], &x, &y);
+            benchmark::DoNotOptimize(x);
+            benchmark::DoNotOptimize(y);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransformMatrixTransform)->Arg(100)->Arg(1700)->Arg(10000);
+
+// Maps a packed buffer of boxes back to the source image and clips them, as done by postProcess
+static void BM_TransformMatrixTransformBoxes(benchmark::State& state) {
+    deploy::TransformMatrix matrix{};
+    matrix.update(1920, 1080, 640, 640);
+
+    std::vector<float> boxes(static_cast<size_t>(state.range(0)) * 4);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        boxes[i] = static_cast<float>(i % 640);
+    }
+    std::vector<float> mapped(boxes.size());
+
+    for (auto _ : state) {
+        mapped = boxes;
+        matrix.transformBoxes(mapped.data(), static_cast<int>(state.range(0)), 4, true);
+        benchmark::DoNotOptimize(mapped.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransformMatrixTransformBoxes)->Arg(100)->Arg(1700)->Arg(10000);
+
+// Host reference of the letterbox warp from a source image to the model input
+static void BM_CpuWarpAffine(benchmark::State& state) {
+    int width  = static_cast<int>(state.range(0));
+    int height = static_cast<int>(state.range(1));
+
+    deploy::TransformMatrix matrix{};
+    matrix.update(width, height, 640, 640);
+
+    auto               image = bench::makeImage(width, height);
+    std::vector<float> output(3 * 640 * 640);
+
+    for (auto _ : state) {
+        deploy::cpuWarpAffine(image.data(), width, height, output.data(), 640, 640, matrix.matrix);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(image.size()));
+}
+BENCHMARK(BM_CpuWarpAffine)->Args({640, 480})->Args({1280, 720})->Args({1920, 1080})->Unit(benchmark::kMillisecond);
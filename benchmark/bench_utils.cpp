@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "deploy/utils/utils.hpp"
+
+namespace fs = std::filesystem;
+
+// Reads a serialized engine of a given size in MiB, as done by every inference template constructor
+static void BM_LoadFile(benchmark::State& state) {
+    int64_t  bytes = state.range(0) << 20;
+    fs::path path  = fs::temp_directory_path() / ("deploy_bench_" + std::to_string(state.range(0)) + ".bin");
+    {
+        std::ofstream     file(path, std::ios::binary);
+        std::vector<char> content(bytes, 'x');
+        file.write(content.data(), bytes);
+    }
+
+    for (auto _ : state) {
+        auto data = deploy::loadFile(path.string());
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+
+    fs::remove(path);
+}
+BENCHMARK(BM_LoadFile)->Arg(1)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace check {
+
+/**
+ * @brief Failed check, carrying the location and the condition that did not hold.
+ */
+class Failure : public std::runtime_error {
+public:
+    Failure(const char* file, int line, const std::string& message)
+        : std::runtime_error(std::string(file) + ":" + std::to_string(line) + ": " + message) {}
+};
+
+/**
+ * @brief Gets the checks registered by the translation units of deploy_check, in registration order.
+ */
+inline std::vector<std::pair<std::string, std::function<void()>>>& registry() {
+    static std::vector<std::pair<std::string, std::function<void()>>> checks;
+    return checks;
+}
+
+/**
+ * @brief Registers a check at static initialization.
+ */
+struct Registrar {
+    Registrar(const char* name, std::function<void()> body) {
+        registry().emplace_back(name, std::move(body));
+    }
+};
+
+/**
+ * @brief Formats the values of a failed comparison.
+ */
+template <typename A, typename B>
+std::string describe(const char* expression, const A& a, const B& b) {
+    std::ostringstream os;
+    os << expression << " (" << a << " vs " << b << ")";
+    return os.str();
+}
+
+}  // namespace check
+
+// Defines and registers a check, the body runs once and fails by throwing
+#define CHECK_CASE(name)                                       \
+    static void            name();                             \
+    static check::Registrar name##Registrar(#name, &name);     \
+    static void            name()
+
+// Fails the running check when the condition does not hold
+#define CHECK(condition)                                                       \
+    do {                                                                       \
+        if (!(condition)) throw check::Failure(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+// Fails the running check when the values differ, reporting both
+#define CHECK_EQ(a, b)                                                                          \
+    do {                                                                                        \
+        const auto& checkA = (a);                                                               \
+        const auto& checkB = (b);                                                               \
+        if (!(checkA == checkB)) {                                                              \
+            throw check::Failure(__FILE__, __LINE__, check::describe(#a " == " #b, checkA, checkB)); \
+        }                                                                                       \
+    } while (0)
@@ -0,0 +1,170 @@
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "deploy/vision/autotune.hpp"
+
+namespace {
+
+// Known latency of a batch: 4 ms per batch plus 1 ms per image
+constexpr double kFixedMs    = 4.0;
+constexpr double kPerImageMs = 1.0;
+
+bool near(double a, double b) {
+    return std::abs(a - b) < 1e-3;
+}
+
+// Sweeps a synthetic run callback following the known curve, slower while warming up
+deploy::LatencyCurve sweepLinear(std::map<int, int>& calls, const deploy::AutotuneOptions& options) {
+    return deploy::sweepBatches(
+        8,
+        [&](int batch) {
+            bool warmup = calls[batch]++ < options.warmup;
+            return static_cast<float>(warmup ? 100.0 : kFixedMs + kPerImageMs * batch);
+        },
+        options);
+}
+
+}  // namespace
+
+// The sweep measures each requested batch size once in increasing order, drops the warmup and fits the curve
+CHECK_CASE(AutotuneSweepFitsLinearCurve) {
+    deploy::AutotuneOptions options;
+    options.batches    = {8, 1, 4, 4, 2};
+    options.warmup     = 2;
+    options.iterations = 5;
+
+    std::map<int, int> calls;
+    auto               curve = sweepLinear(calls, options);
+    CHECK_EQ(curve.points.size(), size_t(4));
+    int previous = 0;
+    for (const auto& point : curve.points) {
+        CHECK(point.batch > previous);
+        previous = point.batch;
+        CHECK_EQ(calls[point.batch], options.warmup + options.iterations);
+        CHECK(near(point.latency, kFixedMs + kPerImageMs * point.batch));
+        CHECK_EQ(point.summary.count, uint64_t(options.iterations));
+    }
+    CHECK(near(curve.model.fixedMs, kFixedMs));
+    CHECK(near(curve.model.perImageMs, kPerImageMs));
+
+    calls.clear();
+    options.batches.clear();
+    CHECK_EQ(sweepLinear(calls, options).points.size(), size_t(8));
+}
+
+// Batch sizes out of range and failed runs are reported
+CHECK_CASE(AutotuneSweepRejectsInvalidRuns) {
+    deploy::AutotuneOptions options;
+    options.batches = {9};
+    std::map<int, int> calls;
+    bool               thrown = false;
+    try {
+        sweepLinear(calls, options);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    thrown = false;
+    try {
+        deploy::sweepBatches(4, [](int) { return -1.0f; }, deploy::AutotuneOptions());
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+// The fit recovers exact points and keeps the costs non-negative otherwise
+CHECK_CASE(LatencyModelFit) {
+    std::vector<deploy::LatencyPoint> points;
+    for (int batch : {1, 2, 3, 6}) points.push_back({batch, static_cast<float>(kFixedMs + kPerImageMs * batch), {}});
+    auto model = deploy::LatencyModel::fit(points);
+    CHECK(near(model.fixedMs, kFixedMs));
+    CHECK(near(model.perImageMs, kPerImageMs));
+
+    model = deploy::LatencyModel::fit({{4, 10.0f, {}}});
+    CHECK(near(model.fixedMs, 0.0));
+    CHECK(near(model.perImageMs, 2.5));
+
+    // Latencies falling with the batch would give a negative cost per image
+    model = deploy::LatencyModel::fit({{1, 6.0f, {}}, {2, 4.0f, {}}});
+    CHECK(near(model.fixedMs, 5.0));
+    CHECK(near(model.perImageMs, 0.0));
+
+    model = deploy::LatencyModel::fit({});
+    CHECK_EQ(model.fixedMs, 0.0);
+    CHECK_EQ(model.perImageMs, 0.0);
+}
+
+// The largest batch fitting a budget follows the line, bounded by the maximum batch
+CHECK_CASE(LatencyModelLargestBatch) {
+    deploy::LatencyModel model{kFixedMs, kPerImageMs};
+    CHECK_EQ(model.largestBatch(10.5, 16), 6);
+    CHECK_EQ(model.largestBatch(10.5, 4), 4);
+    CHECK_EQ(model.largestBatch(4.5, 16), 0);
+
+    deploy::LatencyModel constant{kFixedMs, 0.0};
+    CHECK_EQ(constant.largestBatch(10.5, 16), 16);
+    CHECK_EQ(constant.largestBatch(3.5, 16), 0);
+}
+
+// Decisions fit the batch in what is left of the budget, and observations move the whole curve
+CHECK_CASE(BatchPolicyDecideAndObserve) {
+    deploy::AutotuneOptions options;
+    options.batches = {1, 2, 4, 8};
+    std::map<int, int>  calls;
+    deploy::BatchPolicy policy(sweepLinear(calls, options), 12.5, 0, 1.0);
+
+    CHECK_EQ(policy.decide(0, 0.0), 0);
+    CHECK_EQ(policy.decide(3, 0.0), 3);
+    CHECK_EQ(policy.decide(20, 0.0), 8);
+    CHECK_EQ(policy.decide(20, 4.0), 4);
+    CHECK_EQ(policy.decide(20, 20.0), 8);
+
+    auto decisions = policy.decisions();
+    CHECK_EQ(decisions.size(), size_t(5));
+    CHECK(decisions[3].withinBudget);
+    CHECK(near(decisions[3].predictedMs, 8.0));
+    CHECK(!decisions[4].withinBudget);
+
+    // A batch of 4 twice as slow as estimated doubles every estimate with no smoothing
+    policy.observe(4, 16.0);
+    auto model = policy.model();
+    CHECK(near(model.fixedMs, 2 * kFixedMs));
+    CHECK(near(model.perImageMs, 2 * kPerImageMs));
+    CHECK_EQ(policy.decide(20, 0.0), 2);
+
+    // A batch size missing from the curve is added from the model before it is updated
+    policy.observe(3, 14.0);
+    CHECK(near(policy.model().predict(3), 14.0));
+}
+
+// Writing the JSON documents leaves the formatting of the stream as the caller set it
+CHECK_CASE(AutotuneWriteJsonRestoresStream) {
+    deploy::AutotuneOptions options;
+    options.batches = {1, 2};
+    std::map<int, int>  calls;
+    auto                curve = sweepLinear(calls, options);
+    deploy::BatchPolicy policy(curve, 12.5);
+    policy.decide(2, 0.0);
+
+    std::ostringstream os;
+    os << std::scientific << std::setprecision(2);
+    auto flags = os.flags();
+    curve.writeJson(os);
+    CHECK(os.str().find("\"fixed_ms\":4.0000") != std::string::npos);
+    CHECK(os.flags() == flags);
+    CHECK_EQ(os.precision(), std::streamsize(2));
+
+    policy.writeJson(os);
+    CHECK(os.str().find("\"budget_ms\":12.5000") != std::string::npos);
+    CHECK(os.flags() == flags);
+    CHECK_EQ(os.precision(), std::streamsize(2));
+}
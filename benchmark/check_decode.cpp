@@ -0,0 +1,80 @@
+#include <cmath>
+#include <vector>
+
+#include "check.hpp"
+#include "deploy/vision/decode.hpp"
+
+namespace {
+
+// Raw head output of one image with two classes, [channels, anchors], from center boxes and per anchor classes
+std::vector<float> makeOutput(const std::vector<std::vector<float>>& boxes, const std::vector<int>& classes, const std::vector<float>& scores) {
+    const size_t       anchors = boxes.size();
+    std::vector<float> output(6 * anchors, 0.0f);
+    for (size_t i = 0; i < anchors; ++i) {
+        for (size_t c = 0; c < 4; ++c) output[c * anchors + i] = boxes[i][c];
+        output[(4 + classes[i]) * anchors + i] = scores[i];
+    }
+    return output;
+}
+
+deploy::RawHead makeHead(int anchors, float iouThreshold) {
+    deploy::RawHead head;
+    head.numClasses   = 2;
+    head.numAnchors   = anchors;
+    head.iouThreshold = iouThreshold;
+    return head;
+}
+
+}  // namespace
+
+// A box whose IoU with a kept box of its class equals the threshold is suppressed, as by the NMS plugins, and kept
+// just below it
+CHECK_CASE(RawHeadSuppressesAtIoUThreshold) {
+    // [0, 0, 4, 4] and [0, 0, 4, 2] overlap by exactly half, both values are exact in float
+    auto output = makeOutput({{2, 2, 4, 4}, {2, 1, 4, 2}}, {0, 0}, {0.9f, 0.8f});
+
+    deploy::RawDecodeWorkspace workspace;
+    CHECK_EQ(deploy::decodeRawHead(output.data(), makeHead(2, 0.5f), workspace), 1);
+    CHECK_EQ(workspace.scores[0], 0.9f);
+    CHECK_EQ(deploy::decodeRawHead(output.data(), makeHead(2, 0.50001f), workspace), 2);
+}
+
+// Equal scores keep the lower anchor, and boxes of another class are never suppressed
+CHECK_CASE(RawHeadTiesKeepAnchorOrder) {
+    auto output = makeOutput({{2, 2, 4, 4}, {2.5f, 2, 4, 4}, {2, 2, 4, 4}}, {0, 0, 1}, {0.7f, 0.7f, 0.7f});
+
+    deploy::RawDecodeWorkspace workspace;
+    CHECK_EQ(deploy::decodeRawHead(output.data(), makeHead(3, 0.45f), workspace), 2);
+    CHECK_EQ(workspace.classes[0], 0);
+    CHECK_EQ(workspace.classes[1], 1);
+    CHECK_EQ(workspace.boxes[0], 0.0f);
+    CHECK_EQ(workspace.boxes[4], 0.0f);
+}
+
+// A score equal to the threshold is kept, as by the NMS plugins, and the float just below it is dropped, in the
+// vector lanes and in the scalar tail, for the global and the per class thresholds
+CHECK_CASE(RawHeadKeepsScoresAtThreshold) {
+    const float                     below = std::nextafter(0.25f, 0.0f);
+    std::vector<std::vector<float>> boxes;
+    std::vector<int>                classes;
+    std::vector<float>              scores;
+    for (int i = 0; i < 11; ++i) {
+        boxes.push_back({10.0f * i + 2, 2, 4, 4});
+        classes.push_back(i % 2);
+        scores.push_back(i % 2 == 0 ? 0.25f : below);
+    }
+    auto output = makeOutput(boxes, classes, scores);
+
+    deploy::RawDecodeWorkspace workspace;
+    CHECK_EQ(deploy::decodeRawHead(output.data(), makeHead(11, 0.45f), workspace), 6);
+    for (int i = 0; i < 6; ++i) CHECK_EQ(workspace.boxes[i * 4], 20.0f * i);
+
+    // Class 0 needs 0.5, class 1 keeps the global threshold
+    output = makeOutput({{2, 2, 4, 4}, {12, 2, 4, 4}, {22, 2, 4, 4}, {32, 2, 4, 4}}, {0, 1, 0, 1},
+                        {0.5f, 0.25f, std::nextafter(0.5f, 0.0f), below});
+    auto head                 = makeHead(4, 0.45f);
+    head.classScoreThresholds = {0.5f, 0.25f};
+    CHECK_EQ(deploy::decodeRawHead(output.data(), head, workspace), 2);
+    CHECK_EQ(workspace.scores[0], 0.5f);
+    CHECK_EQ(workspace.scores[1], 0.25f);
+}
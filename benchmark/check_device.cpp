@@ -0,0 +1,160 @@
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "check.hpp"
+#include "deploy/vision/cudaWarp.hpp"
+#include "deploy/vision/deviceResult.hpp"
+#include "deploy/vision/executor.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+// Host copy of the outputs of a view, as downloaded by a consumer
+struct HostDetections {
+    std::vector<int>   numDets;
+    std::vector<float> boxes;
+    std::vector<float> kpts;
+};
+
+HostDetections copyToHost(const deploy::DeviceDetections& view) {
+    HostDetections copy;
+    size_t         slots = static_cast<size_t>(view.batch) * view.maxDets;
+    copy.numDets.assign(view.numDets, view.numDets + view.batch);
+    copy.boxes.assign(view.boxes, view.boxes + slots * view.boxSize);
+    if (view.kpts != nullptr) copy.kpts.assign(view.kpts, view.kpts + slots * view.nkpt * view.ndim);
+    return copy;
+}
+
+// Compares the results of predict with the detections of a view, mapped to the source images
+template <typename T>
+void checkSameResults(const std::vector<T>& results, const deploy::DeviceDetections& view, const HostDetections& mapped, const std::string& label) {
+    CHECK_EQ(static_cast<int>(results.size()), view.batch);
+    for (int i = 0; i < view.batch; ++i) {
+        const T& result = results[i];
+        CHECK_EQ(result.num, mapped.numDets[i]);
+        for (int j = 0; j < result.num; ++j) {
+            size_t       det = static_cast<size_t>(i) * view.maxDets + j;
+            const float* box = mapped.boxes.data() + det * view.boxSize;
+            const auto&  out = result.boxes[j];
+            if (out.left != box[0] || out.top != box[1] || out.right != box[2] || out.bottom != box[3]) {
+                throw check::Failure(__FILE__, __LINE__, label + ": box " + std::to_string(j) + " of image " + std::to_string(i) + " differs");
+            }
+            if constexpr (std::is_same<T, deploy::OBBResult>::value) {
+                CHECK_EQ(out.theta, box[4]);
+            }
+            CHECK_EQ(result.scores[j], view.scores[det]);
+            CHECK_EQ(result.classes[j], view.classes[det]);
+            if constexpr (std::is_same<T, deploy::PoseResult>::value) {
+                size_t values = static_cast<size_t>(view.nkpt) * view.ndim;
+                for (size_t k = 0; k < values; ++k) {
+                    if (result.kpts[j * values + k] != mapped.kpts[det * values + k]) {
+                        throw check::Failure(__FILE__, __LINE__, label + ": key point value " + std::to_string(k) + " of box " + std::to_string(j) + " differs");
+                    }
+                }
+            }
+        }
+    }
+}
+
+// A raw view copied to the host and mapped there, as a consumer without the mapping kernel would, gives the results
+// of predict, and so does the view mapped by predictDevice itself
+template <typename T>
+void checkHostCopyMatchesPredict() {
+    for (int batch : {1, 3}) {
+        bench::SyntheticTemplate<T> model(37, batch, 1920, 1080, 640);
+        std::vector<deploy::Image>  images(batch);
+        std::vector<T>              results = model.predict(images);
+
+        deploy::DeviceDetections raw;
+        CHECK(model.predictDevice(images, raw, false));
+        CHECK(!raw.device && !raw.sourceCoordinates);
+        HostDetections mapped = copyToHost(raw);
+        deploy::cpuTransformDetections(mapped.boxes.data(), mapped.numDets.data(), raw.batch, raw.maxDets, 1, raw.boxSize, 4, raw.boxSize == 4,
+                                       raw.transforms.data());
+        if (!mapped.kpts.empty()) {
+            deploy::cpuTransformDetections(mapped.kpts.data(), mapped.numDets.data(), raw.batch, raw.maxDets, raw.nkpt, raw.ndim, 2, false,
+                                           raw.transforms.data());
+        }
+        checkSameResults(results, raw, mapped, "host copy, batch " + std::to_string(batch));
+
+        deploy::DeviceDetections source;
+        CHECK(model.predictDevice(images, source, true));
+        CHECK(source.sourceCoordinates);
+        checkSameResults(results, source, copyToHost(source), "mapped view, batch " + std::to_string(batch));
+    }
+}
+
+}  // namespace
+
+CHECK_CASE(DeviceDetectionsHostCopyMatchesPredictDet) {
+    checkHostCopyMatchesPredict<deploy::DetResult>();
+}
+
+CHECK_CASE(DeviceDetectionsHostCopyMatchesPredictOBB) {
+    checkHostCopyMatchesPredict<deploy::OBBResult>();
+}
+
+CHECK_CASE(DeviceDetectionsHostCopyMatchesPredictPose) {
+    checkHostCopyMatchesPredict<deploy::PoseResult>();
+}
+
+// A view stays unchanged for the next ring size - 1 calls of predictDevice, each of which gets another slot, and its
+// slot is handed out again by the call after them
+CHECK_CASE(DeviceDetectionsRingSlotLifetime) {
+    bench::SyntheticTemplate<deploy::PoseResult> model(20, 2);
+    std::vector<deploy::Image>                   images(2);
+    for (int ringSize = 1; ringSize <= 4; ++ringSize) {
+        model.setDeviceRingSize(ringSize);
+
+        deploy::DeviceDetections view;
+        CHECK(model.predictDevice(images, view, true));
+        HostDetections snapshot = copyToHost(view);
+
+        // Unmapped outputs differ from the mapped ones, so a reused slot would show in the view
+        for (int call = 1; call < ringSize; ++call) {
+            deploy::DeviceDetections other;
+            CHECK(model.predictDevice(images, other, false));
+            CHECK(other.slot != view.slot);
+            CHECK(other.boxes != view.boxes);
+            HostDetections current = copyToHost(view);
+            CHECK(current.boxes == snapshot.boxes);
+            CHECK(current.kpts == snapshot.kpts);
+        }
+
+        deploy::DeviceDetections reused;
+        CHECK(model.predictDevice(images, reused, false));
+        CHECK_EQ(reused.slot, view.slot);
+        CHECK(reused.boxes == view.boxes);
+        CHECK(copyToHost(view).boxes != snapshot.boxes);
+    }
+}
+
+// Models that cannot read a letterbox written by the executor are refused when added, not at the first run
+CHECK_CASE(MultiModelExecutorRejectsModelsWithoutSharedInput) {
+    // Accepts shared inputs as far as add is concerned, it is never run
+    struct SharedInputTemplate : bench::SyntheticTemplate<deploy::DetResult> {
+        SharedInputTemplate() : bench::SyntheticTemplate<deploy::DetResult>(20, 2) {}
+        bool supportsSharedInput() const override {
+            return true;
+        }
+    };
+
+    deploy::MultiModelExecutor                  executor;
+    bench::SyntheticTemplate<deploy::DetResult> plain(20, 2);
+    std::vector<deploy::DetResult>              results;
+    CHECK(!plain.supportsSharedInput());
+    bool thrown = false;
+    try {
+        executor.add(plain, results);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK_EQ(executor.geometries(), 0);
+
+    SharedInputTemplate shared;
+    executor.add(shared, results);
+    CHECK_EQ(executor.geometries(), 1);
+}
@@ -0,0 +1,26 @@
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "check.hpp"
+
+// Runs every registered check whose name contains the first argument, all of them without argument
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : "";
+
+    int run = 0, failed = 0;
+    for (const auto& [name, body] : check::registry()) {
+        if (name.find(filter) == std::string::npos) continue;
+        ++run;
+        try {
+            body();
+            std::cout << "[  OK  ] " << name << std::endl;
+        } catch (const std::exception& e) {
+            ++failed;
+            std::cout << "[ FAIL ] " << name << ": " << e.what() << std::endl;
+        }
+    }
+
+    std::cout << run - failed << "/" << run << " checks passed" << std::endl;
+    return failed == 0 && run > 0 ? 0 : 1;
+}
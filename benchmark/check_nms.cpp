@@ -0,0 +1,464 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "common/nmsTileQueue.h"
+#include "efficientIdxNMSPlugin/efficientIdxNMSReference.h"
+
+namespace {
+
+// Outputs of EfficientIdxNMS for a batch
+struct NMSOutputs {
+    std::vector<int32_t> numDetections;
+    std::vector<float>   boxes;
+    std::vector<float>   scores;
+    std::vector<int32_t> classes;
+    std::vector<int32_t> indices;
+
+    NMSOutputs(int batch, int numOutputBoxes)
+        : numDetections(batch, 0), boxes(static_cast<size_t>(batch) * numOutputBoxes * 4, 0.0F),
+          scores(static_cast<size_t>(batch) * numOutputBoxes, 0.0F), classes(scores.size(), 0), indices(scores.size(), 0) {}
+};
+
+// Random inputs of one differential case: corner boxes shared by all classes, distinct scores
+struct NMSCase {
+    nvinfer1::plugin::EfficientIdxNMSParameters param;
+    std::vector<float>                          boxes;
+    std::vector<float>                          scores;
+};
+
+NMSCase makeCase(std::mt19937& gen, int nmsAlgorithm, int maxBatch = 4) {
+    std::uniform_int_distribution<int> batch(1, maxBatch), anchors(16, 1500), classes(1, 6), outputs(1, 200), selected(8, 600);
+    std::uniform_int_distribution<int> perClass(-1, 20), coin(0, 1);
+
+    NMSCase test;
+    auto&   param                = test.param;
+    param.batchSize              = batch(gen);
+    param.numAnchors             = anchors(gen);
+    param.numClasses             = classes(gen);
+    param.numScoreElements       = param.numAnchors * param.numClasses;
+    param.numBoxElements         = param.numAnchors * 4;
+    param.numOutputBoxes         = outputs(gen);
+    param.numOutputBoxesPerClass = perClass(gen);
+    // Now and then the cap exceeds the bound of the bitmask algorithm, which must then apply the bound
+    param.numSelectedBoxes       = selected(gen) % 8 == 0 ? 10000 : selected(gen);
+    param.scoreThreshold         = std::uniform_real_distribution<float>(0.01F, 0.6F)(gen);
+    param.iouThreshold           = std::uniform_real_distribution<float>(0.2F, 0.8F)(gen);
+    param.classAgnostic          = coin(gen) == 1;
+    param.nmsAlgorithm           = nmsAlgorithm;
+
+    // Boxes crowd a small canvas so that NMS has plenty of overlaps to resolve
+    std::uniform_real_distribution<float> center(0.0F, 160.0F), size(4.0F, 64.0F);
+    test.boxes.resize(static_cast<size_t>(param.batchSize) * param.numAnchors * 4);
+    for (size_t i = 0; i < test.boxes.size(); i += 4) {
+        float x = center(gen), y = center(gen), w = size(gen), h = size(gen);
+        test.boxes[i + 0] = x - w / 2;
+        test.boxes[i + 1] = y - h / 2;
+        test.boxes[i + 2] = x + w / 2;
+        test.boxes[i + 3] = y + h / 2;
+    }
+
+    // A shuffled ramp keeps the scores of an image distinct, so that the expected order is unique
+    std::vector<int> ramp(param.numScoreElements);
+    test.scores.resize(static_cast<size_t>(param.batchSize) * param.numScoreElements);
+    for (int image = 0; image < param.batchSize; ++image) {
+        std::iota(ramp.begin(), ramp.end(), 1);
+        std::shuffle(ramp.begin(), ramp.end(), gen);
+        for (int i = 0; i < param.numScoreElements; ++i) {
+            test.scores[static_cast<size_t>(image) * param.numScoreElements + i] = static_cast<float>(ramp[i]) / (param.numScoreElements + 1);
+        }
+    }
+    return test;
+}
+
+float iou(const float* a, const float* b) {
+    float width  = std::min(a[2], b[2]) - std::max(a[0], b[0]);
+    float height = std::min(a[3], b[3]) - std::max(a[1], b[1]);
+    if (width <= 0.0F || height <= 0.0F) return 0.0F;
+    float intersection = width * height;
+    float areaA        = (a[2] - a[0]) * (a[3] - a[1]);
+    float areaB        = (b[2] - b[0]) * (b[3] - b[1]);
+    return intersection / (areaA + areaB - intersection);
+}
+
+// Textbook greedy NMS, written independently of the reference: sort every passing score, ties in element order, keep
+// the candidate cap, then keep each box not overlapping a kept box of its class
+NMSOutputs bruteForceNMS(const NMSCase& test, int selectedCap) {
+    const auto& param = test.param;
+    NMSOutputs  outputs(param.batchSize, param.numOutputBoxes);
+
+    for (int image = 0; image < param.batchSize; ++image) {
+        const float* scores = test.scores.data() + static_cast<size_t>(image) * param.numScoreElements;
+        const float* boxes  = test.boxes.data() + static_cast<size_t>(image) * param.numAnchors * 4;
+
+        std::vector<int> candidates;
+        for (int element = 0; element < param.numScoreElements; ++element) {
+            if (scores[element] >= param.scoreThreshold) candidates.push_back(element);
+        }
+        std::stable_sort(candidates.begin(), candidates.end(), [&](int a, int b) { return scores[a] > scores[b]; });
+        if (static_cast<int>(candidates.size()) > selectedCap) candidates.resize(selectedCap);
+
+        std::vector<int> kept, perClass(param.numClasses, 0);
+        int              count = 0;
+        for (int element : candidates) {
+            if (count >= param.numOutputBoxes) break;
+            int  anchor = element / param.numClasses, cls = element % param.numClasses;
+            bool suppressed = std::any_of(kept.begin(), kept.end(), [&](int other) {
+                return (param.classAgnostic || other % param.numClasses == cls) &&
+                       iou(boxes + static_cast<size_t>(other / param.numClasses) * 4, boxes + static_cast<size_t>(anchor) * 4) >= param.iouThreshold;
+            });
+            if (suppressed) continue;
+            kept.push_back(element);
+            if (param.numOutputBoxesPerClass >= 0 && perClass[cls]++ >= param.numOutputBoxesPerClass) continue;
+
+            size_t output           = static_cast<size_t>(image) * param.numOutputBoxes + count++;
+            outputs.scores[output]  = scores[element];
+            outputs.classes[output] = cls;
+            outputs.indices[output] = anchor;
+            std::copy_n(boxes + static_cast<size_t>(anchor) * 4, 4, outputs.boxes.begin() + output * 4);
+        }
+        outputs.numDetections[image] = count;
+    }
+    return outputs;
+}
+
+NMSOutputs referenceNMS(const NMSCase& test) {
+    NMSOutputs outputs(test.param.batchSize, test.param.numOutputBoxes);
+    auto       status = EfficientIdxNMSReference(test.param, test.boxes.data(), test.scores.data(), nullptr, outputs.numDetections.data(),
+                                                 outputs.boxes.data(), outputs.scores.data(), outputs.classes.data(), outputs.indices.data());
+    CHECK_EQ(static_cast<int>(status), static_cast<int>(STATUS_SUCCESS));
+    return outputs;
+}
+
+void checkSameDetections(const NMSOutputs& expected, const NMSOutputs& actual, const std::string& label) {
+    for (size_t image = 0; image < expected.numDetections.size(); ++image) {
+        if (expected.numDetections[image] != actual.numDetections[image]) {
+            throw check::Failure(__FILE__, __LINE__,
+                                 label + ": image " + std::to_string(image) + " has " + std::to_string(actual.numDetections[image]) +
+                                     " detections instead of " + std::to_string(expected.numDetections[image]));
+        }
+    }
+    for (size_t i = 0; i < expected.scores.size(); ++i) {
+        bool same = expected.scores[i] == actual.scores[i] && expected.classes[i] == actual.classes[i] && expected.indices[i] == actual.indices[i] &&
+                    std::equal(expected.boxes.begin() + i * 4, expected.boxes.begin() + i * 4 + 4, actual.boxes.begin() + i * 4);
+        if (!same) {
+            throw check::Failure(__FILE__, __LINE__,
+                                 label + ": detection " + std::to_string(i) + " is anchor " + std::to_string(actual.indices[i]) + " class " +
+                                     std::to_string(actual.classes[i]) + " instead of anchor " + std::to_string(expected.indices[i]) + " class " +
+                                     std::to_string(expected.classes[i]));
+        }
+    }
+}
+
+// Candidate cap of the reference: numSelectedBoxes, bounded with the bitmask algorithm
+int selectedCap(const nvinfer1::plugin::EfficientIdxNMSParameters& param) {
+    if (param.nmsAlgorithm == 1) return std::min(param.numSelectedBoxes, nvinfer1::plugin::kEFFICIENT_IDX_NMS_BITMASK_MAX_BOXES);
+    return param.numSelectedBoxes;
+}
+
+void checkAgainstBruteForce(int nmsAlgorithm, unsigned seed, int trials) {
+    std::mt19937 gen(seed);
+    for (int trial = 0; trial < trials; ++trial) {
+        NMSCase test = makeCase(gen, nmsAlgorithm);
+        checkSameDetections(bruteForceNMS(test, selectedCap(test.param)), referenceNMS(test),
+                            "algorithm " + std::to_string(nmsAlgorithm) + " trial " + std::to_string(trial));
+    }
+}
+
+// Inputs full of exact ties: boxes on an even integer grid with power of two sizes, so that many pairs overlap at
+// exactly 1/4, 1/3 or 1/2, the IoU thresholds drawn, and scores on eight levels
+NMSCase makeTiedCase(std::mt19937& gen, int& pairsAtThreshold) {
+    std::uniform_int_distribution<int> batch(1, 3), anchors(16, 400), classes(1, 3), outputs(1, 100), selected(8, 400);
+    std::uniform_int_distribution<int> corner(0, 20), side(1, 3), level(1, 8), threshold(0, 2), perClass(-1, 10), coin(0, 1);
+    const float                        thresholds[] = {0.25F, 1.0F / 3.0F, 0.5F};
+
+    NMSCase test;
+    auto&   param                = test.param;
+    param.batchSize              = batch(gen);
+    param.numAnchors             = anchors(gen);
+    param.numClasses             = classes(gen);
+    param.numScoreElements       = param.numAnchors * param.numClasses;
+    param.numBoxElements         = param.numAnchors * 4;
+    param.numOutputBoxes         = outputs(gen);
+    param.numOutputBoxesPerClass = perClass(gen);
+    param.numSelectedBoxes       = selected(gen);
+    param.scoreThreshold         = 0.25F;
+    param.iouThreshold           = thresholds[threshold(gen)];
+    param.classAgnostic          = coin(gen) == 1;
+
+    test.boxes.resize(static_cast<size_t>(param.batchSize) * param.numAnchors * 4);
+    for (size_t i = 0; i < test.boxes.size(); i += 4) {
+        float x = 2.0F * corner(gen), y = 2.0F * corner(gen);
+        test.boxes[i + 0] = x;
+        test.boxes[i + 1] = y;
+        test.boxes[i + 2] = x + static_cast<float>(1 << side(gen));
+        test.boxes[i + 3] = y + static_cast<float>(1 << side(gen));
+    }
+    test.scores.resize(static_cast<size_t>(param.batchSize) * param.numScoreElements);
+    for (auto& score : test.scores) score = static_cast<float>(level(gen)) / 8.0F;
+
+    for (int image = 0; image < param.batchSize; ++image) {
+        const float* boxes = test.boxes.data() + static_cast<size_t>(image) * param.numAnchors * 4;
+        for (int a = 0; a < param.numAnchors; ++a) {
+            for (int b = a + 1; b < param.numAnchors; ++b) {
+                pairsAtThreshold += iou(boxes + a * 4, boxes + b * 4) == param.iouThreshold;
+            }
+        }
+    }
+    return test;
+}
+
+}  // namespace
+
+// Serial NMS of the reference against a brute force NMS, the candidate cap often below the passing scores so
+// that the top-K preselection decides which boxes reach NMS
+CHECK_CASE(EfficientIdxNMSReferenceTopKMatchesBruteForce) {
+    checkAgainstBruteForce(0, 31, 60);
+}
+
+// Bitmask NMS of the reference, tiles and reduce pass, against the same brute force NMS
+CHECK_CASE(EfficientIdxNMSReferenceBitmaskMatchesBruteForce) {
+    checkAgainstBruteForce(1, 131, 60);
+}
+
+// Serial and bitmask NMS of the reference on tied scores and overlaps exactly at the IoU threshold, against each other
+// and the brute force NMS: a difference in the suppression rule, the tie order or the candidate cap would show
+CHECK_CASE(EfficientIdxNMSReferenceAlgorithmsMatchOnTies) {
+    std::mt19937 gen(1103);
+    int          pairsAtThreshold = 0;
+    for (int trial = 0; trial < 40; ++trial) {
+        NMSCase test = makeTiedCase(gen, pairsAtThreshold);
+        NMSOutputs expected = bruteForceNMS(test, test.param.numSelectedBoxes);
+        checkSameDetections(expected, referenceNMS(test), "serial trial " + std::to_string(trial));
+        test.param.nmsAlgorithm = 1;
+        checkSameDetections(expected, referenceNMS(test), "bitmask trial " + std::to_string(trial));
+    }
+    CHECK(pairsAtThreshold > 0);
+}
+
+// Work queue of the bitmask mask pass on random batch shapes, with empty, single tile and crowded images: every
+// tile of every image must be decoded exactly once, and the blocks must share the cost of all its box pairs
+CHECK_CASE(NMSTileQueueCoversRandomBatches) {
+    std::mt19937                       gen(36);
+    std::uniform_int_distribution<int> batch(1, 64), kind(0, 3), few(1, 64), many(65, 8192), blocks(1, 1024);
+    for (int trial = 0; trial < 200; ++trial) {
+        std::vector<int32_t> numBoxes(batch(gen));
+        int64_t              pairs = 0;
+        for (auto& count : numBoxes) {
+            int k = kind(gen);
+            count = k == 0 ? 0 : (k == 1 ? few(gen) : many(gen));
+            pairs += static_cast<int64_t>(count) * (count - 1) / 2;
+        }
+        int32_t tileSize  = trial % 2 == 0 ? 64 : 32;
+        int32_t numBlocks = blocks(gen);
+
+        std::vector<int64_t> blockCost(numBlocks);
+        int64_t              makespan = nvinfer1::plugin::nmsTileQueueReference(numBoxes.data(), static_cast<int32_t>(numBoxes.size()), tileSize,
+                                                                                numBlocks, blockCost.data());
+        CHECK(makespan != -1);
+        CHECK_EQ(std::accumulate(blockCost.begin(), blockCost.end(), int64_t{0}), pairs);
+    }
+}
+
+// Batches with uneven candidate counts, some images without any, run at once and image by image: with the bitmask
+// algorithm the mask tiles of the batch share a single work queue, which must not change the detections of an image
+CHECK_CASE(EfficientIdxNMSReferenceBatchMatchesPerImage) {
+    std::mt19937                          gen(236);
+    std::uniform_real_distribution<float> scale(0.0F, 1.0F);
+    for (int trial = 0; trial < 40; ++trial) {
+        NMSCase test  = makeCase(gen, trial % 2, 8);
+        auto&   param = test.param;
+        for (int image = 0; image < param.batchSize; ++image) {
+            // From no candidate at all to every score kept as drawn
+            float factor = scale(gen) < 0.25F ? 0.0F : scale(gen) + 0.5F;
+            auto  begin  = test.scores.begin() + static_cast<size_t>(image) * param.numScoreElements;
+            std::transform(begin, begin + param.numScoreElements, begin, [factor](float score) { return std::min(score * factor, 1.0F); });
+        }
+        NMSOutputs batch = referenceNMS(test);
+
+        NMSCase single;
+        single.param           = param;
+        single.param.batchSize = 1;
+        for (int image = 0; image < param.batchSize; ++image) {
+            auto boxes  = test.boxes.begin() + static_cast<size_t>(image) * param.numAnchors * 4;
+            auto scores = test.scores.begin() + static_cast<size_t>(image) * param.numScoreElements;
+            single.boxes.assign(boxes, boxes + static_cast<size_t>(param.numAnchors) * 4);
+            single.scores.assign(scores, scores + param.numScoreElements);
+            NMSOutputs alone = referenceNMS(single);
+
+            NMSOutputs slice(1, param.numOutputBoxes);
+            size_t     offset     = static_cast<size_t>(image) * param.numOutputBoxes;
+            slice.numDetections[0] = batch.numDetections[image];
+            std::copy_n(batch.boxes.begin() + offset * 4, slice.boxes.size(), slice.boxes.begin());
+            std::copy_n(batch.scores.begin() + offset, slice.scores.size(), slice.scores.begin());
+            std::copy_n(batch.classes.begin() + offset, slice.classes.size(), slice.classes.begin());
+            std::copy_n(batch.indices.begin() + offset, slice.indices.size(), slice.indices.begin());
+            checkSameDetections(alone, slice, "algorithm " + std::to_string(param.nmsAlgorithm) + " trial " + std::to_string(trial) + " image " + std::to_string(image));
+        }
+    }
+}
+
+// Runtime thresholds input against the plugin attributes: values equal to the attributes, negative entries and a
+// number of boxes above the attribute change nothing, and each field set on its own acts like the attribute would
+CHECK_CASE(EfficientIdxNMSReferenceRuntimeThresholds) {
+    using namespace nvinfer1::plugin;
+    std::mt19937 gen(35);
+    for (int trial = 0; trial < 20; ++trial) {
+        NMSCase test  = makeCase(gen, trial % 2);
+        auto&   param = test.param;
+        // Room for every candidate, so that a change of threshold shows in the low scores too
+        param.numSelectedBoxes = std::min(param.numScoreElements, 1500);
+        param.numOutputBoxes   = std::min(param.numScoreElements, 1000);
+        NMSOutputs  expected   = referenceNMS(test);
+        std::string label      = "trial " + std::to_string(trial);
+
+        std::vector<float> thresholds(3 + param.numClasses, -1.0F);
+        auto               runtime = [&](NMSCase input) {
+            input.param.thresholds = thresholds.data();
+            return referenceNMS(input);
+        };
+
+        // The attributes stay in use where the input is negative, a class threshold of 0 leaves its class alone
+        checkSameDetections(expected, runtime(test), label + " negative");
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_MAX_OUTPUT_BOXES] = static_cast<float>(param.numOutputBoxes + 50);
+        std::fill(thresholds.begin() + kEFFICIENT_IDX_NMS_THRESHOLD_CLASS_SCORES, thresholds.end(), 0.0F);
+        checkSameDetections(expected, runtime(test), label + " boxes above the attribute");
+
+        // The same values from the input instead of the attributes, set far off
+        NMSCase moved                 = test;
+        moved.param.iouThreshold      = 0.99F;
+        moved.param.scoreThreshold    = 0.99F;
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_IOU]   = param.iouThreshold;
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_SCORE] = param.scoreThreshold;
+        checkSameDetections(expected, runtime(moved), label + " equivalent");
+
+        // Another IoU threshold acts like the attribute
+        NMSCase other            = test;
+        other.param.iouThreshold = param.iouThreshold > 0.5F ? param.iouThreshold - 0.15F : param.iouThreshold + 0.15F;
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_IOU] = other.param.iouThreshold;
+        checkSameDetections(referenceNMS(other), runtime(test), label + " iou");
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_IOU] = -1.0F;
+
+        // Another score threshold acts like the attribute
+        other                      = test;
+        other.param.scoreThreshold = param.scoreThreshold + 0.2F;
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_SCORE] = other.param.scoreThreshold;
+        checkSameDetections(referenceNMS(other), runtime(test), label + " score");
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_SCORE] = -1.0F;
+
+        // A class threshold below the score threshold is ignored, above it drops the lower scores of its class only
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_CLASS_SCORES] = param.scoreThreshold / 2;
+        checkSameDetections(expected, runtime(test), label + " class below");
+        float classThreshold = std::min(param.scoreThreshold + 0.25F, 0.95F);
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_CLASS_SCORES] = classThreshold;
+        other = test;
+        for (size_t element = 0; element < other.scores.size(); element += param.numClasses) {
+            if (other.scores[element] < classThreshold) other.scores[element] = 0.0F;
+        }
+        checkSameDetections(referenceNMS(other), runtime(test), label + " class above");
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_CLASS_SCORES] = 0.0F;
+
+        // Fewer boxes keep the first detections of each image
+        int boxes = std::max(param.numOutputBoxes / 2, 1);
+        thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_MAX_OUTPUT_BOXES] = static_cast<float>(boxes);
+        NMSOutputs limited = expected;
+        for (int image = 0; image < param.batchSize; ++image) {
+            limited.numDetections[image] = std::min(limited.numDetections[image], boxes);
+            for (int slot = boxes; slot < param.numOutputBoxes; ++slot) {
+                size_t output           = static_cast<size_t>(image) * param.numOutputBoxes + slot;
+                limited.scores[output]  = 0.0F;
+                limited.classes[output] = 0;
+                limited.indices[output] = 0;
+                std::fill_n(limited.boxes.begin() + output * 4, 4, 0.0F);
+            }
+        }
+        checkSameDetections(limited, runtime(test), label + " fewer boxes");
+    }
+}
+
+// DFL box coding against a decode built from separately computed softmax distances: the boxes reaching NMS through
+// the reference must be those a plain corner boxes input would give, with shared and per image anchor points
+CHECK_CASE(EfficientIdxNMSReferenceDFLMatchesBruteForce) {
+    using namespace nvinfer1::plugin;
+    std::mt19937                          gen(37);
+    std::normal_distribution<float>       logit(0.0F, 2.0F);
+    std::uniform_real_distribution<float> direct(0.0F, 6.0F);
+    std::uniform_int_distribution<int>    cell(0, 19), stride(0, 2);
+    for (int trial = 0; trial < 24; ++trial) {
+        NMSCase test         = makeCase(gen, trial % 2);
+        auto&   param        = test.param;
+        param.boxCoding      = kEFFICIENT_IDX_NMS_BOX_CODING_DFL;
+        param.boxDecoder     = true;
+        param.regMax         = trial % 3 == 0 ? 1 : 16;
+        param.shareAnchors   = trial % 4 < 2;
+        param.numBoxElements = 4 * param.regMax * param.numAnchors;
+
+        // Anchor points at grid cell centers, strides of 8, 16 or 32
+        int                anchorImages = param.shareAnchors ? 1 : param.batchSize;
+        std::vector<float> anchors(static_cast<size_t>(anchorImages) * param.numAnchors * 3);
+        for (size_t i = 0; i < anchors.size(); i += 3) {
+            anchors[i + 0] = cell(gen) + 0.5F;
+            anchors[i + 1] = cell(gen) + 0.5F;
+            anchors[i + 2] = static_cast<float>(8 << stride(gen));
+        }
+
+        // [batch, 4 * regMax, anchors] logits, or the distances themselves with a single bin
+        std::vector<float> logits(static_cast<size_t>(param.batchSize) * param.numBoxElements);
+        for (auto& value : logits) value = param.regMax == 1 ? direct(gen) : logit(gen);
+
+        // The expected corner boxes, distances as the mean of the softmax probabilities in double precision
+        NMSCase decoded              = test;
+        decoded.param.boxCoding      = 0;
+        decoded.param.boxDecoder     = false;
+        decoded.param.numBoxElements = param.numAnchors * 4;
+        for (int image = 0; image < param.batchSize; ++image) {
+            for (int anchor = 0; anchor < param.numAnchors; ++anchor) {
+                const float* point = anchors.data() + (static_cast<size_t>(param.shareAnchors ? 0 : image) * param.numAnchors + anchor) * 3;
+                double       distance[4];
+                for (int side = 0; side < 4; ++side) {
+                    auto bin = [&](int b) {
+                        return logits[(static_cast<size_t>(image) * 4 * param.regMax + side * param.regMax + b) * param.numAnchors + anchor];
+                    };
+                    if (param.regMax == 1) {
+                        distance[side] = bin(0);
+                        continue;
+                    }
+                    std::vector<double> probability(param.regMax);
+                    double              total = 0.0;
+                    for (int b = 0; b < param.regMax; ++b) total += probability[b] = std::exp(static_cast<double>(bin(b)));
+                    distance[side] = 0.0;
+                    for (int b = 0; b < param.regMax; ++b) distance[side] += b * probability[b] / total;
+                }
+                float* box = decoded.boxes.data() + (static_cast<size_t>(image) * param.numAnchors + anchor) * 4;
+                box[0]     = static_cast<float>((point[0] - distance[0]) * point[2]);
+                box[1]     = static_cast<float>((point[1] - distance[1]) * point[2]);
+                box[2]     = static_cast<float>((point[0] + distance[2]) * point[2]);
+                box[3]     = static_cast<float>((point[1] + distance[3]) * point[2]);
+            }
+        }
+        NMSOutputs expected = bruteForceNMS(decoded, selectedCap(param));
+
+        NMSOutputs actual(param.batchSize, param.numOutputBoxes);
+        auto       status = EfficientIdxNMSReference(param, logits.data(), test.scores.data(), anchors.data(), actual.numDetections.data(),
+                                                     actual.boxes.data(), actual.scores.data(), actual.classes.data(), actual.indices.data());
+        CHECK_EQ(static_cast<int>(status), static_cast<int>(STATUS_SUCCESS));
+
+        // The softmax of the reference is computed in float, so the boxes only match within its rounding
+        std::string label = "regMax " + std::to_string(param.regMax) + (param.shareAnchors ? " shared" : " per image") + " trial " + std::to_string(trial);
+        CHECK(expected.numDetections == actual.numDetections);
+        CHECK(expected.indices == actual.indices);
+        CHECK(expected.classes == actual.classes);
+        CHECK(expected.scores == actual.scores);
+        for (size_t i = 0; i < expected.boxes.size(); ++i) {
+            if (std::abs(expected.boxes[i] - actual.boxes[i]) > 1e-3F * std::max(1.0F, std::abs(expected.boxes[i]))) {
+                throw check::Failure(__FILE__, __LINE__, label + ": box value " + std::to_string(i) + " is " + std::to_string(actual.boxes[i]) +
+                                                             " instead of " + std::to_string(expected.boxes[i]));
+            }
+        }
+    }
+}
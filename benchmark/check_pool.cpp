@@ -0,0 +1,99 @@
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "deploy/vision/devicePool.hpp"
+#include "synthetic.hpp"
+
+namespace {
+
+constexpr int kBatch = 4;
+
+// Batches run by the mocked devices, counted by the width of their first image
+struct RunLog {
+    std::mutex         mutex;
+    std::map<int, int> runs;
+};
+
+// Mocked model recording the batches it runs, whose first batch can stall
+class LoggedTemplate : public bench::MockTemplate<deploy::DetResult> {
+public:
+    LoggedTemplate(float imageLatency, float stallMs, std::shared_ptr<RunLog> log)
+        : bench::MockTemplate<deploy::DetResult>(kBatch, 0.5F, imageLatency), mStallMs(stallMs), mLog(std::move(log)) {}
+
+    bool predictInto(const std::vector<deploy::Image>& images, std::vector<deploy::DetResult>& results) override {
+        if (!images.empty()) {
+            std::lock_guard<std::mutex> lock(mLog->mutex);
+            mLog->runs[images[0].width]++;
+        }
+        if (mStallMs > 0.0F) {
+            std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(mStallMs));
+            mStallMs = 0.0F;
+        }
+        return bench::MockTemplate<deploy::DetResult>::predictInto(images, results);
+    }
+
+private:
+    float                   mStallMs; /**< Delay of the next batch, in milliseconds */
+    std::shared_ptr<RunLog> mLog;     /**< Batches run by all the devices */
+};
+
+// Submits numbered batches to a pool of two mocked devices, checks that each completes exactly once, and gets the
+// loads of the devices
+std::vector<deploy::DeviceLoad> runBatches(int count, float slowLatency, float stallMs) {
+    auto log = std::make_shared<RunLog>();
+    std::vector<deploy::DeviceLoad> loads;
+    {
+        deploy::DevicePool<deploy::DetResult> pool(
+            [&](int device) -> std::unique_ptr<deploy::BaseTemplate<deploy::DetResult>> {
+                return std::make_unique<LoggedTemplate>(device == 0 ? 1.0F : slowLatency, device == 0 ? 0.0F : stallMs, log);
+            },
+            {0, 1});
+
+        std::vector<std::future<std::vector<deploy::DetResult>>> futures;
+        for (int i = 0; i < count; ++i) {
+            futures.push_back(pool.submit(std::vector<deploy::Image>(kBatch, deploy::Image(nullptr, i, 1))));
+        }
+        for (auto& future : futures) {
+            CHECK_EQ(static_cast<int>(future.get().size()), kBatch);
+        }
+        loads = pool.loads();
+    }
+
+    CHECK_EQ(static_cast<int>(log->runs.size()), count);
+    for (const auto& [batch, runs] : log->runs) {
+        CHECK(batch >= 0 && batch < count);
+        CHECK_EQ(runs, 1);
+    }
+    CHECK_EQ(loads[0].completed + loads[1].completed, static_cast<int64_t>(count));
+    for (const auto& load : loads) {
+        CHECK_EQ(load.queued, 0);
+        CHECK_EQ(load.running, 0);
+    }
+    return loads;
+}
+
+}  // namespace
+
+// Every submitted batch runs once on one device and its future receives its results
+CHECK_CASE(DevicePoolCompletesEveryBatchOnce) {
+    for (int count : {1, 7, 64}) runBatches(count, 1.0F, 0.0F);
+}
+
+// A device three times as fast per image completes well over half of the batches
+CHECK_CASE(DevicePoolFasterDeviceCompletesMore) {
+    auto loads = runBatches(64, 3.0F, 0.0F);
+    CHECK(loads[0].completed >= 2 * loads[1].completed);
+}
+
+// The batches queued behind a stalled device are taken by the idle one
+CHECK_CASE(DevicePoolStealsFromStalledDevice) {
+    auto loads = runBatches(32, 1.0F, 200.0F);
+    CHECK(loads[0].stolen > 0);
+    CHECK(loads[0].completed > loads[1].completed);
+}
@@ -0,0 +1,130 @@
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "deploy/core/profiler.hpp"
+
+namespace {
+
+// Complete event of a Chrome trace
+struct TraceEvent {
+    std::string name;
+    double      ts  = 0.0;
+    double      dur = 0.0;
+    int         run = 0;
+};
+
+// Reads the number following a key in an event, or fails
+double numberAfter(const std::string& event, const std::string& key) {
+    size_t at = event.find("\"" + key + "\":");
+    if (at == std::string::npos) throw check::Failure(__FILE__, __LINE__, "missing " + key + " in " + event);
+    return std::strtod(event.c_str() + at + key.size() + 3, nullptr);
+}
+
+// Parses the complete events of a trace written by writeChromeTrace, one event per line
+std::vector<TraceEvent> parseTrace(const std::string& trace) {
+    std::vector<TraceEvent> events;
+    std::istringstream      lines(trace);
+    std::string             line;
+    while (std::getline(lines, line)) {
+        if (line.find("\"ph\":\"X\"") == std::string::npos) continue;
+        TraceEvent event;
+        size_t     begin = line.find("\"name\":\"") + 8;
+        event.name       = line.substr(begin, line.find("\",\"cat\"") - begin);
+        event.ts         = numberAfter(line, "ts");
+        event.dur        = numberAfter(line, "dur");
+        event.run        = static_cast<int>(numberAfter(line, "run"));
+        events.push_back(event);
+    }
+    return events;
+}
+
+// Reports two runs of three layers, the second run starting when the first layer is reported again
+void reportTwoRuns(deploy::LayerProfiler& profiler) {
+    for (const auto& [name, ms] : std::vector<std::pair<const char*, float>>{
+             {"conv", 1.0F}, {"relu", 0.5F}, {"head \"1\"", 2.0F}, {"conv", 3.0F}, {"relu", 0.5F}, {"head \"1\"", 1.0F}}) {
+        profiler.reportLayerTime(name, ms);
+    }
+}
+
+}  // namespace
+
+// Layers are added up over the runs and sorted by total time
+CHECK_CASE(LayerProfilerAggregatesRuns) {
+    deploy::LayerProfiler profiler;
+    reportTwoRuns(profiler);
+    CHECK_EQ(profiler.runs(), 2);
+
+    auto layers = profiler.layers();
+    CHECK_EQ(layers.size(), size_t(3));
+    CHECK_EQ(layers[0].name, std::string("conv"));
+    CHECK_EQ(layers[0].count, 2);
+    CHECK_EQ(layers[0].total, 4.0F);
+    CHECK_EQ(layers[0].min, 1.0F);
+    CHECK_EQ(layers[0].max, 3.0F);
+    CHECK_EQ(layers[0].mean(), 2.0F);
+    CHECK_EQ(layers[1].name, std::string("head \"1\""));
+    CHECK_EQ(layers[1].total, 3.0F);
+    CHECK_EQ(layers[2].name, std::string("relu"));
+    CHECK_EQ(layers[2].count, 2);
+    CHECK_EQ(layers[2].total, 1.0F);
+
+    // Shares of the 8 ms in total
+    std::string table = profiler.table();
+    CHECK(table.find("50.00%") != std::string::npos);
+    CHECK(table.find("37.50%") != std::string::npos);
+    CHECK(table.find("12.50%") != std::string::npos);
+    CHECK(table.find("over 2 run(s)") != std::string::npos);
+
+    profiler.reset();
+    CHECK_EQ(profiler.runs(), 0);
+    CHECK(profiler.layers().empty());
+}
+
+// The trace lays the layer executions out back to back in microseconds, and keeps only the first runs
+CHECK_CASE(LayerProfilerChromeTrace) {
+    deploy::LayerProfiler profiler;
+    reportTwoRuns(profiler);
+
+    std::ostringstream os;
+    profiler.writeChromeTrace(os);
+    auto events = parseTrace(os.str());
+    CHECK_EQ(events.size(), size_t(6));
+
+    const std::vector<double> durations = {1000.0, 500.0, 2000.0, 3000.0, 500.0, 1000.0};
+    double                    ts        = 0.0;
+    for (size_t i = 0; i < events.size(); ++i) {
+        CHECK_EQ(events[i].ts, ts);
+        CHECK_EQ(events[i].dur, durations[i]);
+        CHECK_EQ(events[i].run, static_cast<int>(i / 3));
+        ts += durations[i];
+    }
+    CHECK_EQ(events[2].name, std::string("head \\\"1\\\""));
+
+    deploy::LayerProfiler firstRun(1);
+    reportTwoRuns(firstRun);
+    std::ostringstream firstOs;
+    firstRun.writeChromeTrace(firstOs);
+    CHECK_EQ(parseTrace(firstOs.str()).size(), size_t(3));
+    CHECK_EQ(firstRun.layers()[0].count, 2);
+}
+
+// Writing the trace and the table leaves the formatting of the stream as the caller set it
+CHECK_CASE(LayerProfilerRestoresStream) {
+    deploy::LayerProfiler profiler;
+    reportTwoRuns(profiler);
+
+    std::ostringstream os;
+    os << std::scientific << std::left << std::setprecision(2) << std::setfill('*');
+    auto flags = os.flags();
+    profiler.writeChromeTrace(os);
+    profiler.writeTable(os);
+    CHECK(os.flags() == flags);
+    CHECK_EQ(os.precision(), std::streamsize(2));
+    CHECK_EQ(os.fill(), '*');
+    CHECK(os.str().find("\"dur\":1000.000") != std::string::npos);
+    CHECK(os.str().find(profiler.table()) != std::string::npos);
+}
@@ -0,0 +1,134 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "efficientRotatedNMSPlugin/efficientRotatedNMSCircle.h"
+#include "efficientRotatedNMSPlugin/efficientRotatedNMSReference.h"
+
+namespace {
+
+constexpr float kHalfPi = 1.57079632679F;
+
+bool near(double a, double b, double tolerance = 1e-6) {
+    return std::abs(a - b) < tolerance;
+}
+
+// Ultralytics probiou() of two boxes with the same covariance and center: the Bhattacharyya distance is clamped to
+// its epsilon
+double probIoUSame() {
+    return 1.0 - std::sqrt(1.0 - std::exp(-1e-7) + 1e-7);
+}
+
+// Outputs of EfficientRotatedNMS for a batch
+struct RotatedOutputs {
+    std::vector<int32_t> numDetections;
+    std::vector<float>   boxes;
+    std::vector<float>   scores;
+    std::vector<int32_t> classes;
+
+    RotatedOutputs(int batch, int numOutputBoxes)
+        : numDetections(batch, 0), boxes(static_cast<size_t>(batch) * numOutputBoxes * 5, 0.0F),
+          scores(static_cast<size_t>(batch) * numOutputBoxes, 0.0F), classes(scores.size(), 0) {}
+
+    bool operator==(const RotatedOutputs& other) const {
+        return numDetections == other.numDetections && boxes == other.boxes && scores == other.scores && classes == other.classes;
+    }
+};
+
+}  // namespace
+
+// ProbIoU against hand computed values of the Ultralytics formula
+CHECK_CASE(EfficientRotatedNMSProbIoUMatchesFormula) {
+    const float rect[5] = {0.0F, 0.0F, 4.0F, 2.0F, 0.3F};
+    CHECK(near(EfficientRotatedNMSIOUReference(1, rect, rect), probIoUSame()));
+
+    // Far apart, the Bhattacharyya distance is clamped to 100
+    const float far[5] = {1000.0F, 1000.0F, 1004.0F, 1002.0F, 0.3F};
+    CHECK(near(EfficientRotatedNMSIOUReference(1, rect, far), 1.0 - std::sqrt(1.0 - std::exp(-100.0) + 1e-7)));
+
+    // A square turned by 90 degrees has the same Gaussian
+    const float square[5]       = {0.0F, 0.0F, 4.0F, 4.0F, 0.0F};
+    const float squareTurned[5] = {0.0F, 0.0F, 4.0F, 4.0F, kHalfPi};
+    CHECK(near(EfficientRotatedNMSIOUReference(1, square, squareTurned), probIoUSame()));
+
+    // A 4x2 rectangle turned by 90 degrees about its center: variances 4/3 and 1/3 swap, so the distance is
+    // 0.5 * ln((5/3)^2 / (4 * 4/9)) = 0.5 * ln(25/16) and exp(-distance) = 4/5
+    const float upright[5] = {0.0F, 1.0F, 4.0F, 3.0F, 0.0F};
+    const float turned[5]  = {0.0F, 1.0F, 4.0F, 3.0F, kHalfPi};
+    CHECK(near(EfficientRotatedNMSIOUReference(1, upright, turned), 1.0 - std::sqrt(0.2 + 1e-7)));
+
+    // The exact metric of the same pairs: full overlap, none, and the 2x2 center over a union of 12
+    CHECK(near(EfficientRotatedNMSIOUReference(0, square, squareTurned), 1.0, 1e-5));
+    CHECK_EQ(EfficientRotatedNMSIOUReference(0, rect, far), 0.0F);
+    CHECK(near(EfficientRotatedNMSIOUReference(0, upright, turned), 1.0 / 3.0, 1e-5));
+}
+
+// Boxes whose bounding circles are disjoint never overlap, whatever their angles
+CHECK_CASE(EfficientRotatedNMSCircleRejectionIsExact) {
+    std::mt19937                          gen(34);
+    std::uniform_real_distribution<float> position(0.0F, 100.0F), size(1.0F, 40.0F), angle(-kHalfPi, kHalfPi);
+    int                                   rejected = 0;
+    for (int trial = 0; trial < 20000; ++trial) {
+        float boxes[2][5];
+        for (auto& box : boxes) {
+            float x = position(gen), y = position(gen), w = size(gen), h = size(gen);
+            box[0] = x;
+            box[1] = y;
+            box[2] = x + w;
+            box[3] = y + h;
+            box[4] = angle(gen);
+        }
+        const float* a = boxes[0];
+        const float* b = boxes[1];
+        if (nvinfer1::plugin::RotatedBoundingCirclesDisjoint(a[1], a[0], a[3], a[2], b[1], b[0], b[3], b[2])) {
+            ++rejected;
+            CHECK_EQ(EfficientRotatedNMSIOUReference(0, a, b), 0.0F);
+        }
+    }
+    CHECK(rejected > 0);
+}
+
+// The reference with and without the bounding circle rejection keeps the same boxes
+CHECK_CASE(EfficientRotatedNMSCircleRejectionKeepsDetections) {
+    std::mt19937                          gen(340);
+    std::uniform_int_distribution<int>    anchors(16, 600), classes(1, 4), coin(0, 1);
+    std::uniform_real_distribution<float> position(0.0F, 200.0F), size(2.0F, 48.0F), angle(-kHalfPi, kHalfPi), score(0.0F, 1.0F);
+    for (int trial = 0; trial < 30; ++trial) {
+        nvinfer1::plugin::EfficientRotatedNMSParameters param;
+        param.batchSize        = 1 + trial % 3;
+        param.numAnchors       = anchors(gen);
+        param.numClasses       = classes(gen);
+        param.numScoreElements = param.numAnchors * param.numClasses;
+        param.numBoxElements   = param.numAnchors * 5;
+        param.numOutputBoxes   = 100;
+        param.scoreThreshold   = 0.2F;
+        param.iouThreshold     = std::uniform_real_distribution<float>(0.1F, 0.7F)(gen);
+        param.classAgnostic    = coin(gen) == 1;
+
+        std::vector<float> boxes(static_cast<size_t>(param.batchSize) * param.numBoxElements);
+        for (size_t i = 0; i < boxes.size(); i += 5) {
+            float x = position(gen), y = position(gen), w = size(gen), h = size(gen);
+            boxes[i + 0] = x;
+            boxes[i + 1] = y;
+            boxes[i + 2] = x + w;
+            boxes[i + 3] = y + h;
+            boxes[i + 4] = angle(gen);
+        }
+        std::vector<float> scores(static_cast<size_t>(param.batchSize) * param.numScoreElements);
+        for (auto& value : scores) value = score(gen);
+
+        RotatedOutputs outputs[2] = {{param.batchSize, param.numOutputBoxes}, {param.batchSize, param.numOutputBoxes}};
+        for (int rejection = 0; rejection < 2; ++rejection) {
+            auto& out    = outputs[rejection];
+            auto  status = EfficientRotatedNMSReference(param, boxes.data(), scores.data(), nullptr, out.numDetections.data(),
+                                                        out.boxes.data(), out.scores.data(), out.classes.data(), 1, rejection == 1);
+            CHECK_EQ(static_cast<int>(status), static_cast<int>(STATUS_SUCCESS));
+        }
+        if (!(outputs[0] == outputs[1])) {
+            throw check::Failure(__FILE__, __LINE__, "trial " + std::to_string(trial) + " keeps other boxes with the circle rejection");
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+#include "efficientTopKPlugin/efficientTopKReference.h"
+
+namespace {
+
+// Outputs of EfficientTopK for a batch
+struct TopKOutputs {
+    std::vector<int32_t> numDetections;
+    std::vector<float>   boxes;
+    std::vector<float>   scores;
+    std::vector<int32_t> classes;
+
+    TopKOutputs(int batch, int numOutputBoxes)
+        : numDetections(batch, 0), boxes(static_cast<size_t>(batch) * numOutputBoxes * 4, 0.0F),
+          scores(static_cast<size_t>(batch) * numOutputBoxes, 0.0F), classes(scores.size(), 0) {}
+
+    // Fills the outputs with garbage, so that the padding must be written
+    TopKOutputs& poison() {
+        std::fill(numDetections.begin(), numDetections.end(), -1);
+        std::fill(boxes.begin(), boxes.end(), -1.0F);
+        std::fill(scores.begin(), scores.end(), -1.0F);
+        std::fill(classes.begin(), classes.end(), -1);
+        return *this;
+    }
+};
+
+// Keeps every element scoring at or above the threshold, sorts them by decreasing score then increasing element
+// index, and zero pads the outputs past the detections
+TopKOutputs bruteForceTopK(const nvinfer1::plugin::EfficientTopKParameters& param, const std::vector<float>& boxes,
+                           const std::vector<float>& scores) {
+    TopKOutputs out(param.batchSize, param.numOutputBoxes);
+    for (int image = 0; image < param.batchSize; ++image) {
+        const float*                       imageScores = scores.data() + static_cast<size_t>(image) * param.numScoreElements;
+        std::vector<std::pair<float, int>> candidates;
+        for (int element = 0; element < param.numScoreElements; ++element) {
+            if (imageScores[element] >= param.scoreThreshold) candidates.emplace_back(imageScores[element], element);
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+
+        int count                = std::min(static_cast<int>(candidates.size()), param.numOutputBoxes);
+        out.numDetections[image] = count;
+        for (int i = 0; i < count; ++i) {
+            size_t       output = static_cast<size_t>(image) * param.numOutputBoxes + i;
+            int          anchor = candidates[i].second / param.numClasses;
+            const float* box    = boxes.data() + (static_cast<size_t>(image) * param.numAnchors + anchor) * 4;
+            out.scores[output]  = candidates[i].first;
+            out.classes[output] = candidates[i].second % param.numClasses;
+            if (param.boxCoding == 1) {
+                // Center and size to corners
+                out.boxes[output * 4 + 0] = box[0] - box[2] * 0.5F;
+                out.boxes[output * 4 + 1] = box[1] - box[3] * 0.5F;
+                out.boxes[output * 4 + 2] = box[0] + box[2] * 0.5F;
+                out.boxes[output * 4 + 3] = box[1] + box[3] * 0.5F;
+            } else {
+                std::copy_n(box, 4, out.boxes.data() + output * 4);
+            }
+        }
+    }
+    return out;
+}
+
+}  // namespace
+
+// The reference against a brute force sort over anchors x classes: scores on a coarse grid so that ties are common
+// and some land exactly on the threshold, more output boxes than candidates on some trials, and batches above 1
+CHECK_CASE(EfficientTopKReferenceMatchesBruteForce) {
+    std::mt19937                          gen(38);
+    std::uniform_int_distribution<int>    anchors(1, 400), classes(1, 8), batches(1, 4), outputs(1, 300), grid(0, 20);
+    std::uniform_real_distribution<float> coordinate(0.0F, 100.0F);
+    for (int trial = 0; trial < 200; ++trial) {
+        nvinfer1::plugin::EfficientTopKParameters param;
+        param.batchSize        = batches(gen);
+        param.numAnchors       = anchors(gen);
+        param.numClasses       = classes(gen);
+        param.numScoreElements = param.numAnchors * param.numClasses;
+        param.numOutputBoxes   = trial % 4 == 0 ? param.numScoreElements + 7 : outputs(gen);
+        param.boxCoding        = trial % 2;
+        param.scoreThreshold   = grid(gen) / 20.0F;
+
+        std::vector<float> boxes(static_cast<size_t>(param.batchSize) * param.numAnchors * 4);
+        for (auto& value : boxes) value = coordinate(gen);
+        std::vector<float> scores(static_cast<size_t>(param.batchSize) * param.numScoreElements);
+        for (auto& value : scores) value = grid(gen) / 20.0F;
+
+        TopKOutputs expected = bruteForceTopK(param, boxes, scores);
+        TopKOutputs actual = TopKOutputs(param.batchSize, param.numOutputBoxes).poison();
+        auto        status = EfficientTopKReference(param, boxes.data(), scores.data(), actual.numDetections.data(),
+                                                    actual.boxes.data(), actual.scores.data(), actual.classes.data());
+        CHECK_EQ(static_cast<int>(status), static_cast<int>(STATUS_SUCCESS));
+
+        std::string label = "trial " + std::to_string(trial);
+        if (expected.numDetections != actual.numDetections) throw check::Failure(__FILE__, __LINE__, label + ": detection counts differ");
+        if (expected.classes != actual.classes) throw check::Failure(__FILE__, __LINE__, label + ": classes differ");
+        if (expected.scores != actual.scores) throw check::Failure(__FILE__, __LINE__, label + ": scores differ");
+        if (expected.boxes != actual.boxes) throw check::Failure(__FILE__, __LINE__, label + ": boxes differ");
+    }
+}
+
+// Hand checked ties and threshold: equal scores come out by element index, and a score equal to the threshold is kept
+CHECK_CASE(EfficientTopKReferenceTiesAndThreshold) {
+    nvinfer1::plugin::EfficientTopKParameters param;
+    param.batchSize        = 2;
+    param.numAnchors       = 3;
+    param.numClasses       = 2;
+    param.numScoreElements = 6;
+    param.numOutputBoxes   = 8;
+    param.scoreThreshold   = 0.5F;
+
+    std::vector<float> boxes(param.batchSize * param.numAnchors * 4);
+    for (size_t i = 0; i < boxes.size(); ++i) boxes[i] = static_cast<float>(i);
+    const std::vector<float> scores = {0.5F, 0.9F, 0.9F, 0.2F, 0.49F, 0.9F,  // image 0
+                                       0.1F, 0.2F, 0.3F, 0.4F, 0.45F, 0.0F};  // image 1
+
+    TopKOutputs out = TopKOutputs(param.batchSize, param.numOutputBoxes).poison();
+    auto        status = EfficientTopKReference(param, boxes.data(), scores.data(), out.numDetections.data(), out.boxes.data(),
+                                         out.scores.data(), out.classes.data());
+    CHECK_EQ(static_cast<int>(status), static_cast<int>(STATUS_SUCCESS));
+    CHECK(out.numDetections == std::vector<int32_t>({4, 0}));
+
+    // Elements 1, 2 and 5 tie at 0.9, then element 0 sits on the threshold
+    const std::vector<int32_t> classes  = {1, 0, 1, 0};
+    const std::vector<int>     anchorOf = {0, 1, 2, 0};
+    for (int i = 0; i < 4; ++i) {
+        CHECK_EQ(out.classes[i], classes[i]);
+        CHECK_EQ(out.scores[i], i < 3 ? 0.9F : 0.5F);
+        CHECK_EQ(out.boxes[i * 4], static_cast<float>(anchorOf[i] * 4));
+    }
+
+    // Padding past the detections, and the whole second image, stays zero
+    for (size_t i = 4; i < out.scores.size(); ++i) {
+        CHECK_EQ(out.scores[i], 0.0F);
+        CHECK_EQ(out.classes[i], 0);
+    }
+    CHECK(std::all_of(out.boxes.begin() + 16, out.boxes.end(), [](float value) { return value == 0.0F; }));
+}
@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "deploy/utils/stats.hpp"
+#include "deploy/vision/inference.hpp"
+#include "synthetic.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Load test configuration
+struct Options {
+    std::string enginePath;
+    std::string csvPath;
+    std::string jsonPath;
+    int         mode         = 0;      // 0 Detect, 1 OBB, 2 Segment, 3 Pose
+    bool        useCudaGraph = false;  // Use the CUDA graph templates
+    bool        mock         = false;  // Use the mock backend instead of an engine
+    float       mockLatency  = 5.0F;   // Mock latency per batch, in milliseconds
+    float       mockPerImage = 1.0F;   // Mock latency per image, in milliseconds
+    int         imageWidth   = 1920;   // Width of the synthetic input image
+    int         imageHeight  = 1080;   // Height of the synthetic input image
+    double      rate         = 100.0;  // Offered load over all clients, in requests per second
+    bool        poisson      = true;   // Poisson arrivals, or constant rate
+    int         clients      = 4;      // Number of client threads generating arrivals
+    int         instances    = 1;      // Number of model instances, each served by one thread
+    int         maxBatch     = 0;      // Largest batch formed by a server, 0 for the model batch
+    double      batchTimeout = 2.0;    // Time a server waits to fill a batch, in milliseconds
+    double      duration     = 30.0;   // Length of the run, in seconds
+    double      warmup       = 5.0;    // Leading part of the run excluded from the statistics, in seconds
+    double      slo          = 0.0;    // p99 latency objective in milliseconds, 0 to disable
+    unsigned    seed         = 42;     // Seed of the arrival processes
+};
+
+// Single inference request and its timeline
+struct Request {
+    int64_t           id{0};
+    int               client{0};
+    Clock::time_point arrival{};   // Scheduled arrival, independent of the server progress
+    Clock::time_point dispatch{};  // Start of the batch that served the request
+    Clock::time_point finish{};    // End of the batch that served the request
+    int               batch{0};    // Size of the batch that served the request
+};
+
+// Request queue shared by the clients and the servers
+class RequestQueue {
+public:
+    void push(Request* request) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueue.push_back(request);
+        }
+        mCond.notify_one();
+    }
+
+    // Pops up to maxBatch requests, waiting at most timeout after the first one for the batch to fill.
+    // Returns false once the queue is closed and drained.
+    bool pop(std::vector<Request*>& batch, size_t maxBatch, std::chrono::microseconds timeout) {
+        batch.clear();
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (batch.empty()) {
+            mCond.wait(lock, [this] { return mClosed || !mQueue.empty(); });
+            if (mQueue.empty()) return false;
+
+            // Another server may take the pending requests while this one waits for the batch to fill
+            auto deadline = Clock::now() + timeout;
+            while (mQueue.size() < maxBatch && !mClosed && mCond.wait_until(lock, deadline) != std::cv_status::timeout) {
+            }
+
+            while (!mQueue.empty() && batch.size() < maxBatch) {
+                batch.push_back(mQueue.front());
+                mQueue.pop_front();
+            }
+        }
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mClosed = true;
+        }
+        mCond.notify_all();
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mQueue.size();
+    }
+
+private:
+    std::mutex              mMutex;
+    std::condition_variable mCond;
+    std::deque<Request*>    mQueue;
+    bool                    mClosed{false};
+};
+
+// Generates open-loop arrivals for one client until the end of the run
+void generate(int client, const Options& options, Clock::time_point start, Clock::time_point end,
+              RequestQueue& queue, std::deque<Request>& requests, std::atomic<int64_t>& nextId) {
+    double                                clientRate = options.rate / options.clients;
+    std::mt19937_64                       gen(options.seed + client);
+    std::exponential_distribution<double> interval(clientRate);
+
+    // Constant-rate clients are staggered so that the aggregated arrivals stay evenly spaced
+    double offset = options.poisson ? interval(gen) : client / options.rate;
+    while (true) {
+        auto arrival = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(offset));
+        if (arrival >= end) break;
+
+        std::this_thread::sleep_until(arrival);
+        Request request;
+        request.id      = nextId++;
+        request.client  = client;
+        request.arrival = arrival;
+        requests.push_back(request);
+        queue.push(&requests.back());
+
+        offset += options.poisson ? interval(gen) : 1.0 / clientRate;
+    }
+}
+
+// Serves batches of requests with one model instance until the queue is closed and drained
+template <typename T>
+void serve(deploy::BaseTemplate<T>& model, const Options& options, const deploy::Image& image, size_t maxBatch, RequestQueue& queue) {
+    auto timeout = std::chrono::microseconds(static_cast<int64_t>(options.batchTimeout * 1000.0));
+
+    std::vector<Request*>      batch;
+    std::vector<deploy::Image> images;
+    std::vector<T>             results;  // Reused across batches, like a long-running service would
+    while (queue.pop(batch, maxBatch, timeout)) {
+        // CUDA graph templates only accept full batches, the padding results are discarded
+        images.assign(options.useCudaGraph ? model.batch : batch.size(), image);
+
+        auto dispatch = Clock::now();
+        bool ok       = model.predictInto(images, results);
+        auto finish   = Clock::now();
+
+        if (!ok) {
+            std::cerr << "Warning: prediction failed for a batch of " << batch.size() << " requests." << std::endl;
+        }
+        for (auto* request : batch) {
+            request->dispatch = dispatch;
+            request->finish   = finish;
+            request->batch    = static_cast<int>(batch.size());
+        }
+    }
+}
+
+// Creates one model instance of the requested backend
+template <typename T, typename Deploy, typename DeployCG>
+std::unique_ptr<deploy::BaseTemplate<T>> createModel(const Options& options) {
+    if (options.mock) {
+        int batch = options.maxBatch > 0 ? options.maxBatch : 8;
+        return std::make_unique<bench::MockTemplate<T>>(batch, options.mockLatency, options.mockPerImage);
+    } else if (options.useCudaGraph) {
+        return std::make_unique<DeployCG>(options.enginePath);
+    } else {
+        return std::make_unique<Deploy>(options.enginePath);
+    }
+}
+
+double milliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Writes one line of the summary table
+void printRow(const char* name, const deploy::LatencyHistogram& histogram) {
+    auto summary = histogram.summary();
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << summary.mean << std::setw(10) << summary.p50 << std::setw(10) << histogram.percentile(95.0F)
+              << std::setw(10) << summary.p99 << std::setw(10) << summary.p999 << std::setw(10) << summary.max << std::endl;
+}
+
+// Writes the latency distribution as a JSON object
+void writeJsonLatency(std::ostream& os, const deploy::LatencyHistogram& histogram) {
+    auto summary = histogram.summary();
+    os << "{\"mean\":" << summary.mean << ",\"min\":" << summary.min << ",\"p50\":" << summary.p50
+       << ",\"p95\":" << histogram.percentile(95.0F) << ",\"p99\":" << summary.p99 << ",\"p999\":" << summary.p999
+       << ",\"max\":" << summary.max << "}";
+}
+
+template <typename T, typename Deploy, typename DeployCG>
+int run(const Options& options) {
+    std::vector<std::unique_ptr<deploy::BaseTemplate<T>>> models;
+    for (int i = 0; i < options.instances; ++i) {
+        models.emplace_back(createModel<T, Deploy, DeployCG>(options));
+    }
+
+    size_t maxBatch = options.maxBatch > 0 ? std::min(options.maxBatch, models[0]->batch) : models[0]->batch;
+    if (options.useCudaGraph && maxBatch != static_cast<size_t>(models[0]->batch)) {
+        std::cerr << "Warning: CUDA graph models run full batches of " << models[0]->batch << " images." << std::endl;
+    }
+
+    auto          pixels = bench::makeImage(options.imageWidth, options.imageHeight);
+    deploy::Image image(pixels.data(), options.imageWidth, options.imageHeight);
+
+    // Warm up every instance outside of the measured run
+    for (auto& model : models) {
+        model->predict(std::vector<deploy::Image>(options.useCudaGraph ? model->batch : 1, image));
+    }
+
+    RequestQueue                     queue;
+    std::vector<std::deque<Request>> requests(options.clients);
+    std::atomic<int64_t>             nextId{0};
+
+    auto start = Clock::now() + std::chrono::milliseconds(100);
+    auto end   = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.duration));
+
+    std::vector<std::thread> servers;
+    for (auto& model : models) {
+        servers.emplace_back(serve<T>, std::ref(*model), std::cref(options), std::cref(image), maxBatch, std::ref(queue));
+    }
+
+    std::vector<std::thread> clients;
+    for (int i = 0; i < options.clients; ++i) {
+        clients.emplace_back(generate, i, std::cref(options), start, end, std::ref(queue), std::ref(requests[i]), std::ref(nextId));
+    }
+    for (auto& client : clients) client.join();
+
+    size_t backlog = queue.size();
+    queue.close();
+    for (auto& server : servers) server.join();
+
+    // Throughput counts the completions within the measurement window, while latencies cover the requests
+    // scheduled in it; latency is measured from the scheduled arrival to avoid coordinated omission
+    auto windowStart = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.warmup));
+    auto windowSecs  = std::max(options.duration - options.warmup, 1e-3);
+
+    deploy::LatencyHistogram latency, queueing, service;
+    int64_t                  offered = 0, completed = 0, batched = 0;
+    for (auto& clientRequests : requests) {
+        for (auto& request : clientRequests) {
+            if (request.finish >= windowStart && request.finish <= end) completed++;
+            if (request.arrival < windowStart) continue;
+            offered++;
+            batched += request.batch;
+            latency.record(static_cast<float>(milliseconds(request.finish - request.arrival)));
+            queueing.record(static_cast<float>(milliseconds(request.dispatch - request.arrival)));
+            service.record(static_cast<float>(milliseconds(request.finish - request.dispatch)));
+        }
+    }
+
+    double offeredQps  = offered / windowSecs;
+    double achievedQps = completed / windowSecs;
+    double meanBatch   = offered > 0 ? static_cast<double>(batched) / offered : 0.0;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Arrivals:        " << (options.poisson ? "poisson" : "constant") << ", " << options.clients << " client(s), "
+              << options.instances << " instance(s), max batch " << maxBatch << std::endl;
+    std::cout << "Offered load:    " << offeredQps << " req/s" << std::endl;
+    std::cout << "Achieved QPS:    " << achievedQps << " req/s" << std::endl;
+    std::cout << "Requests:        " << offered << " measured, mean batch " << meanBatch << std::endl;
+    std::cout << "Backlog at end:  " << backlog << " request(s)" << std::endl;
+    std::cout << std::left << std::setw(16) << "(ms)" << std::right << std::setw(10) << "mean" << std::setw(10) << "p50"
+              << std::setw(10) << "p95" << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::endl;
+    printRow("Latency", latency);
+    printRow("Queueing delay", queueing);
+    printRow("Service", service);
+
+    bool sloMet = options.slo <= 0.0 || latency.summary().p99 <= options.slo;
+    if (options.slo > 0.0) {
+        std::cout << "SLO p99 <= " << options.slo << " ms: " << (sloMet ? "met" : "violated") << std::endl;
+    }
+
+    if (!options.csvPath.empty()) {
+        std::ofstream csv(options.csvPath);
+        if (!csv.is_open()) throw std::runtime_error("Failed to open CSV file: " + options.csvPath);
+        csv << std::fixed << std::setprecision(4);
+        csv << "id,client,arrival_ms,queue_ms,service_ms,latency_ms,batch\n";
+        for (auto& clientRequests : requests) {
+            for (auto& request : clientRequests) {
+                csv << request.id << "," << request.client << "," << milliseconds(request.arrival - start) << ","
+                    << milliseconds(request.dispatch - request.arrival) << "," << milliseconds(request.finish - request.dispatch) << ","
+                    << milliseconds(request.finish - request.arrival) << "," << request.batch << "\n";
+            }
+        }
+    }
+
+    if (!options.jsonPath.empty()) {
+        std::ofstream json(options.jsonPath);
+        if (!json.is_open()) throw std::runtime_error("Failed to open JSON file: " + options.jsonPath);
+        json << std::fixed << std::setprecision(4);
+        json << "{\"arrival\":\"" << (options.poisson ? "poisson" : "constant") << "\",\"rate\":" << options.rate
+             << ",\"clients\":" << options.clients << ",\"instances\":" << options.instances << ",\"max_batch\":" << maxBatch
+             << ",\"duration\":" << options.duration << ",\"warmup\":" << options.warmup
+             << ",\"offered_qps\":" << offeredQps << ",\"achieved_qps\":" << achievedQps << ",\"requests\":" << offered
+             << ",\"mean_batch\":" << meanBatch << ",\"backlog\":" << backlog << ",\"latency_ms\":";
+        writeJsonLatency(json, latency);
+        json << ",\"queue_ms\":";
+        writeJsonLatency(json, queueing);
+        json << ",\"service_ms\":";
+        writeJsonLatency(json, service);
+        if (options.slo > 0.0) json << ",\"slo_ms\":" << options.slo << ",\"slo_met\":" << (sloMet ? "true" : "false");
+        json << "}\n";
+    }
+
+    return sloMet ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " (-e <engine> | --mock) [options]\n"
+              << "  -e, --engine <path>       Engine file to load\n"
+              << "  -m, --mode <0-3>          0 Detect, 1 OBB, 2 Segment, 3 Pose (default 0)\n"
+              << "  --cudaGraph               Use the CUDA graph templates\n"
+              << "  --mock                    Use a mock backend instead of an engine\n"
+              << "  --mock-latency <ms>       Mock latency per batch (default 5)\n"
+              << "  --mock-per-image <ms>     Mock latency per image (default 1)\n"
+              << "  --size <W>x<H>            Size of the synthetic input image (default 1920x1080)\n"
+              << "  --rate <req/s>            Offered load over all clients (default 100)\n"
+              << "  --arrival <poisson|constant>  Arrival process (default poisson)\n"
+              << "  --clients <n>             Client threads generating arrivals (default 4)\n"
+              << "  --instances <n>           Model instances, one server thread each (default 1)\n"
+              << "  --max-batch <n>           Largest batch formed by a server (default model batch)\n"
+              << "  --batch-timeout <ms>      Time a server waits to fill a batch (default 2)\n"
+              << "  --duration <s>            Length of the run (default 30)\n"
+              << "  --warmup <s>              Leading part excluded from the statistics (default 5)\n"
+              << "  --slo <ms>                p99 latency objective, sets the exit status\n"
+              << "  --seed <n>                Seed of the arrival processes (default 42)\n"
+              << "  --csv <path>              Per-request timeline as CSV\n"
+              << "  --json <path>             Summary as JSON" << std::endl;
+}
+
+// Parse arguments
+Options parseArguments(int argc, char** argv) {
+    Options options;
+    auto    value = [&](int& i) -> std::string {
+        if (i + 1 >= argc) throw std::runtime_error(std::string("Missing value for ") + argv[i]);
+        return argv[++i];
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-e" || arg == "--engine") {
+            options.enginePath = value(i);
+        } else if (arg == "-m" || arg == "--mode") {
+            options.mode = std::stoi(value(i));
+        } else if (arg == "--cudaGraph") {
+            options.useCudaGraph = true;
+        } else if (arg == "--mock") {
+            options.mock = true;
+        } else if (arg == "--mock-latency") {
+            options.mockLatency = std::stof(value(i));
+        } else if (arg == "--mock-per-image") {
+            options.mockPerImage = std::stof(value(i));
+        } else if (arg == "--size") {
+            std::string size = value(i);
+            size_t      sep  = size.find('x');
+            if (sep == std::string::npos) throw std::runtime_error("Invalid size: " + size);
+            options.imageWidth  = std::stoi(size.substr(0, sep));
+            options.imageHeight = std::stoi(size.substr(sep + 1));
+        } else if (arg == "--rate") {
+            options.rate = std::stod(value(i));
+        } else if (arg == "--arrival") {
+            std::string arrival = value(i);
+            if (arrival != "poisson" && arrival != "constant") throw std::runtime_error("Unknown arrival process: " + arrival);
+            options.poisson = arrival == "poisson";
+        } else if (arg == "--clients") {
+            options.clients = std::stoi(value(i));
+        } else if (arg == "--instances") {
+            options.instances = std::stoi(value(i));
+        } else if (arg == "--max-batch") {
+            options.maxBatch = std::stoi(value(i));
+        } else if (arg == "--batch-timeout") {
+            options.batchTimeout = std::stod(value(i));
+        } else if (arg == "--duration") {
+            options.duration = std::stod(value(i));
+        } else if (arg == "--warmup") {
+            options.warmup = std::stod(value(i));
+        } else if (arg == "--slo") {
+            options.slo = std::stod(value(i));
+        } else if (arg == "--seed") {
+            options.seed = static_cast<unsigned>(std::stoul(value(i)));
+        } else if (arg == "--csv") {
+            options.csvPath = value(i);
+        } else if (arg == "--json") {
+            options.jsonPath = value(i);
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(EXIT_SUCCESS);
+        } else {
+            printUsage(argv[0]);
+            throw std::runtime_error("Unknown argument: " + arg);
+        }
+    }
+
+    if (!options.mock && options.enginePath.empty()) {
+        printUsage(argv[0]);
+        throw std::runtime_error("Please provide an engine file using -e or use --mock.");
+    }
+    if (options.mock && options.useCudaGraph) throw std::runtime_error("--cudaGraph cannot be combined with --mock.");
+    if (options.mode < 0 || options.mode > 3) throw std::runtime_error("Invalid mode: " + std::to_string(options.mode));
+    if (options.rate <= 0.0 || options.clients < 1 || options.instances < 1) throw std::runtime_error("Rate, clients and instances must be positive.");
+    if (options.warmup >= options.duration) throw std::runtime_error("Warmup must be shorter than the duration.");
+    return options;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    try {
+        Options options = parseArguments(argc, argv);
+        switch (options.mode) {
+            case 1:
+                return run<deploy::OBBResult, deploy::DeployOBB, deploy::DeployCGOBB>(options);
+            case 2:
+                return run<deploy::SegResult, deploy::DeploySeg, deploy::DeployCGSeg>(options);
+            case 3:
+                return run<deploy::PoseResult, deploy::DeployPose, deploy::DeployCGPose>(options);
+            default:
+                return run<deploy::DetResult, deploy::DeployDet, deploy::DeployCGDet>(options);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
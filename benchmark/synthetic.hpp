@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "deploy/vision/inference.hpp"
+
+namespace bench {
+
+/**
+ * @brief Builds TensorRT dimensions from a list of extents.
+ */
+inline nvinfer1::Dims makeDims(std::initializer_list<int64_t> extents) {
+    nvinfer1::Dims dims{};
+    dims.nbDims = static_cast<int32_t>(extents.size());
+    std::transform(extents.begin(), extents.end(), dims.d, [](int64_t extent) { return static_cast<std::remove_reference_t<decltype(dims.d[0])>>(extent); });
+    return dims;
+}
+
+/**
+ * @brief Inference template backed by synthetic host output tensors instead of an engine.
+ *
+ * The tensors follow the layout produced by the EfficientNMS plugins: input, num_dets, boxes, scores,
+ * classes and, depending on the task, masks or keypoints. No CUDA device is required.
+ */
+template <typename T>
+class SyntheticTemplate : public deploy::BaseTemplate<T> {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param numDets Number of detections reported for every image.
+     * @param batch Batch size of the synthetic outputs.
+     * @param imageWidth Width of the source images.
+     * @param imageHeight Height of the source images.
+     * @param inputSize Width and height of the model input.
+     */
+    explicit SyntheticTemplate(int numDets, int batch = 1, int imageWidth = 1920, int imageHeight = 1080, int inputSize = 640) {
+        this->batch  = batch;
+        this->width  = inputSize;
+        this->height = inputSize;
+
+        int maxDets = std::max(numDets, 1);
+        int boxSize = std::is_same<T, deploy::OBBResult>::value ? 5 : 4;
+
+        this->tensorInfos.reserve(6);
+        addTensor("images", makeDims({batch, 3, inputSize, inputSize}), true, sizeof(float));
+        addTensor("num_dets", makeDims({batch, 1}), false, sizeof(int));
+        addTensor("det_boxes", makeDims({batch, maxDets, boxSize}), false, sizeof(float));
+        addTensor("det_scores", makeDims({batch, maxDets}), false, sizeof(float));
+        addTensor("det_classes", makeDims({batch, maxDets}), false, sizeof(int));
+        if (std::is_same<T, deploy::SegResult>::value) {
+            addTensor("det_masks", makeDims({batch, maxDets, inputSize, inputSize}), false, sizeof(uint8_t));
+        } else if (std::is_same<T, deploy::PoseResult>::value) {
+            addTensor("det_kpts", makeDims({batch, maxDets, 17, 3}), false, sizeof(float));
+        }
+
+        fill(numDets, maxDets, boxSize);
+
+        this->transforms.resize(batch);
+        for (auto& transform : this->transforms) {
+            transform.update(imageWidth, imageHeight, inputSize, inputSize);
+        }
+    }
+
+    /**
+     * @brief Runs the post-processing of one image of the batch.
+     */
+    T run(int idx = 0) {
+        T result;
+        this->postProcess(idx, result);
+        return result;
+    }
+
+    /**
+     * @brief Runs the post-processing of one image of the batch into an existing result.
+     */
+    void runInto(T& result, int idx = 0) {
+        this->postProcess(idx, result);
+    }
+
+    T predict(const deploy::Image& image) override {
+        return run();
+    }
+
+    std::vector<T> predict(const std::vector<deploy::Image>& images) override {
+        std::vector<T> results;
+        predictInto(images, results);
+        return results;
+    }
+
+    bool predictInto(const std::vector<deploy::Image>& images, std::vector<T>& results) override {
+        this->postProcessBatch(this->batch, results);
+        return true;
+    }
+
+    /**
+     * @brief Host view over the synthetic outputs, with the same contract as the device view of DeployTemplate.
+     *
+     * Boxes and key points are mapped on copies held by a ring of slots, so the outputs stay the same from one
+     * call to the next and a view stays valid for the next ring size - 1 calls, like the device ring.
+     */
+    bool predictDevice(const std::vector<deploy::Image>& images, deploy::DeviceDetections& detections, bool mapToSource = true) override {
+        int   slotIdx = mNextSlot;
+        auto& slot    = mSlots[slotIdx];
+        mNextSlot     = (slotIdx + 1) % static_cast<int>(mSlots.size());
+
+        std::vector<void*> buffers(this->tensorInfos.size());
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            buffers[i] = this->tensorInfos[i].tensor.host();
+        }
+        copyOutput(2, slot.boxes, buffers);
+        if (std::is_same<T, deploy::PoseResult>::value) copyOutput(5, slot.kpts, buffers);
+
+        this->describeOutputs(this->batch, buffers, detections);
+        detections.sourceCoordinates = mapToSource;
+        detections.device            = false;
+        detections.ready             = nullptr;
+        detections.slot              = slotIdx;
+
+        if (mapToSource) {
+            deploy::cpuTransformDetections(detections.boxes, detections.numDets, detections.batch, detections.maxDets, 1, detections.boxSize, 4,
+                                           detections.boxSize == 4, detections.transforms.data());
+            if (detections.kpts != nullptr) {
+                deploy::cpuTransformDetections(detections.kpts, detections.numDets, detections.batch, detections.maxDets, detections.nkpt,
+                                               detections.ndim, 2, false, detections.transforms.data());
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Sets the number of slots cycled through by predictDevice, as DeployTemplate::setDeviceRingSize does.
+     */
+    void setDeviceRingSize(int size) {
+        mSlots.assign(std::max(size, 1), Slot());
+        mNextSlot = 0;
+    }
+
+protected:
+    void allocate() override {}
+
+    void release() override {}
+
+    void setupTensors() override {}
+
+private:
+    /**
+     * @brief Copies of the boxes and key points handed out by one call of predictDevice.
+     */
+    struct Slot {
+        std::vector<float> boxes{};
+        std::vector<float> kpts{};
+    };
+
+    std::vector<Slot> mSlots = std::vector<Slot>(2); /**< Ring of copies, 2 slots like DeployTemplate by default */
+    int               mNextSlot{0};                  /**< Slot used by the next call of predictDevice */
+
+    void copyOutput(int idx, std::vector<float>& copy, std::vector<void*>& buffers) {
+        const auto* data = static_cast<const float*>(this->tensorInfos[idx].tensor.host());
+        copy.assign(data, data + this->tensorInfos[idx].bytes / sizeof(float));
+        buffers[idx] = copy.data();
+    }
+
+    void addTensor(const char* name, const nvinfer1::Dims& dims, bool input, size_t typeSz) {
+        int64_t bytes = deploy::calculateVolume(dims) * typeSz;
+        this->tensorInfos.emplace_back(name, dims, input, typeSz, bytes);
+        this->tensorInfos.back().tensor.host(bytes);
+    }
+
+    void fill(int numDets, int maxDets, int boxSize) {
+        std::mt19937                          gen(42);
+        std::uniform_real_distribution<float> coord(0.0F, static_cast<float>(this->width));
+        std::uniform_real_distribution<float> score(0.25F, 1.0F);
+        std::uniform_int_distribution<int>    cls(0, 79);
+
+        auto* num     = static_cast<int*>(this->tensorInfos[1].tensor.host());
+        auto* boxes   = static_cast<float*>(this->tensorInfos[2].tensor.host());
+        auto* scores  = static_cast<float*>(this->tensorInfos[3].tensor.host());
+        auto* classes = static_cast<int*>(this->tensorInfos[4].tensor.host());
+
+        for (int b = 0; b < this->batch; ++b) {
+            num[b] = numDets;
+            for (int i = 0; i < maxDets; ++i) {
+                float x0 = coord(gen), x1 = coord(gen);
+                float y0 = coord(gen), y1 = coord(gen);
+
+                float* box = boxes + (b * maxDets + i) * boxSize;
+                box[0]     = std::min(x0, x1);
+                box[1]     = std::min(y0, y1);
+                box[2]     = std::max(x0, x1);
+                box[3]     = std::max(y0, y1);
+                if (boxSize == 5) box[4] = 0.5F;
+
+                scores[b * maxDets + i]  = score(gen);
+                classes[b * maxDets + i] = cls(gen);
+            }
+        }
+
+        if (this->tensorInfos.size() > 5) {
+            auto&   extra = this->tensorInfos[5];
+            int64_t count = deploy::calculateVolume(extra.dims);
+            if (std::is_same<T, deploy::SegResult>::value) {
+                auto* masks = static_cast<uint8_t*>(extra.tensor.host());
+                for (int64_t i = 0; i < count; ++i) masks[i] = static_cast<uint8_t>(gen() & 1);
+            } else {
+                auto* kpts = static_cast<float*>(extra.tensor.host());
+                for (int64_t i = 0; i < count; ++i) kpts[i] = coord(gen);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Mock backend that emulates the latency of an engine on top of the synthetic outputs.
+ *
+ * Each predict call sleeps for a fixed per-batch latency plus a per-image latency, then post-processes
+ * the synthetic outputs of every image. It lets load tests exercise the scheduling and reporting paths
+ * without a GPU.
+ */
+template <typename T>
+class MockTemplate : public SyntheticTemplate<T> {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param batch Maximum batch size accepted by predict.
+     * @param batchLatency Latency of every predict call, in milliseconds.
+     * @param imageLatency Additional latency per image, in milliseconds.
+     * @param numDets Number of detections reported for every image.
+     */
+    MockTemplate(int batch, float batchLatency, float imageLatency, int numDets = 10)
+        : SyntheticTemplate<T>(numDets, batch), mBatchLatency(batchLatency), mImageLatency(imageLatency) {}
+
+    T predict(const deploy::Image& image) override {
+        auto results = predict(std::vector<deploy::Image>{image});
+        return results.empty() ? T() : std::move(results[0]);
+    }
+
+    std::vector<T> predict(const std::vector<deploy::Image>& images) override {
+        std::vector<T> results;
+        predictInto(images, results);
+        return results;
+    }
+
+    bool predictInto(const std::vector<deploy::Image>& images, std::vector<T>& results) override {
+        if (images.empty() || images.size() > static_cast<size_t>(this->batch)) {
+            results.clear();
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(mBatchLatency + mImageLatency * images.size()));
+        results.resize(images.size());
+        for (size_t i = 0; i < images.size(); ++i) {
+            this->runInto(results[i], static_cast<int>(i));
+        }
+        return true;
+    }
+
+private:
+    float mBatchLatency; /**< Latency of every predict call, in milliseconds */
+    float mImageLatency; /**< Additional latency per image, in milliseconds */
+};
+
+/**
+ * @brief Gets a synthetic RGB image with a deterministic pattern.
+ */
+inline std::vector<uint8_t> makeImage(int width, int height) {
+    std::vector<uint8_t> image(static_cast<size_t>(width) * height * 3);
+    for (size_t i = 0; i < image.size(); ++i) {
+        image[i] = static_cast<uint8_t>((i * 31) & 0xFF);
+    }
+    return image;
+}
+
+}  // namespace bench
@@ -42,8 +42,6 @@ void vp_trtyolo_detector::run_infer_combinations(const std::vector<std::shared_p
 
     auto prepare_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start_time);
 
-    start_time = std::chrono::system_clock::now();
-
     // Perform inference on prepared images
     std::vector<deploy::DetResult> detection_results = detector->predict(images_to_infer);
 
@@ -68,10 +66,26 @@ void vp_trtyolo_detector::run_infer_combinations(const std::vector<std::shared_p
         }
     }
 
-    auto infer_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start_time);
+    // Split the time spent in the detector by stage, using the latencies accumulated since the previous batch
+    auto stats            = detector->stats();
+    auto preprocess_time  = stage_time(stats, {"staging", "h2d", "warp"});
+    auto infer_time       = stage_time(stats, {"enqueue", "graph"});
+    auto postprocess_time = stage_time(stats, {"d2h", "postprocess"});
+
+    vp_infer_node::infer_combinations_time_cost(mats_to_infer.size(), prepare_time.count(), preprocess_time, infer_time, postprocess_time);
+}
 
-    // Cannot calculate preprocess time and postprocess time, set 0 by default.
-    vp_infer_node::infer_combinations_time_cost(mats_to_infer.size(), prepare_time.count(), 0, infer_time.count(), 0);
+int vp_trtyolo_detector::stage_time(const std::vector<deploy::StageStats>& stats, std::initializer_list<const char*> stages) {
+    float elapsed = 0.0f;
+    for (const auto& stage_stats : stats) {
+        for (const auto* stage : stages) {
+            if (stage_stats.stage == stage) {
+                elapsed                         += stage_stats.latency.total - stage_totals[stage_stats.stage];
+                stage_totals[stage_stats.stage]  = stage_stats.latency.total;
+            }
+        }
+    }
+    return static_cast<int>(elapsed);
 }
 
 void vp_trtyolo_detector::postprocess(const std::vector<cv::Mat>& raw_outputs, const std::vector<std::shared_ptr<vp_objects::vp_frame_meta>>& frame_meta_with_batch) {
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <initializer_list>
+#include <unordered_map>
+
 #include "deploy/vision/inference.hpp"
 #include "deploy/vision/result.hpp"
 #include "nodes/vp_primary_infer_node.h"
@@ -9,8 +12,12 @@ namespace vp_nodes {
 // TensorRT-YOLO detector node, based on vp_primary_infer_node
 class vp_trtyolo_detector : public vp_primary_infer_node {
 private:
-    bool                             use_cudagraph = false;
-    std::shared_ptr<deploy::BaseDet> detector      = nullptr;
+    bool                                   use_cudagraph = false;
+    std::shared_ptr<deploy::BaseDet>       detector      = nullptr;
+    std::unordered_map<std::string, float> stage_totals;  // Accumulated stage latencies seen at the previous batch
+
+    // Milliseconds spent in the given detector stages since the previous batch
+    int stage_time(const std::vector<deploy::StageStats>& stats, std::initializer_list<const char*> stages);
 
 protected:
     // Override: Run inference logic for the whole batch of frames
@@ -5,6 +5,7 @@
 #include <opencv2/opencv.hpp>
 #include <random>
 
+#include "deploy/core/profiler.hpp"
 #include "deploy/utils/utils.hpp"
 #include "deploy/vision/inference.hpp"
 #include "deploy/vision/result.hpp"
@@ -112,11 +113,11 @@ std::shared_ptr<deploy::BaseOBB> createModel(const std::string& enginePath, bool
 }
 
 // Parse arguments
-void parseArguments(int argc, char** argv, std::string& enginePath, std::string& inputPath, std::string& outputPath, std::string& labelPath, bool& useCudaGraph) {
+void parseArguments(int argc, char** argv, std::string& enginePath, std::string& inputPath, std::string& outputPath, std::string& labelPath, std::string& profilePath, bool& useCudaGraph) {
     // Using a library for argument parsing (e.g., Boost.Program_options)
     // For simplicity, manual parsing is shown here
     if (argc < 5) {
-        std::cerr << "Usage: " << argv[0] << " -e <engine> -i <input> [-o <output>] [-l <labels>] [--cudaGraph]" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " -e <engine> -i <input> [-o <output>] [-l <labels>] [--cudaGraph] [--profile <trace.json>]" << std::endl;
         std::exit(EXIT_FAILURE);
     }
 
@@ -132,6 +133,8 @@ void parseArguments(int argc, char** argv, std::string& enginePath, std::string&
             labelPath = argv[++i];
         } else if (arg == "--cudaGraph") {
             useCudaGraph = true;
+        } else if (arg == "--profile") {
+            profilePath = argv[++i];
         } else {
             std::cerr << "Unknown argument: " << arg << std::endl;
             std::exit(EXIT_FAILURE);
@@ -141,10 +144,10 @@ void parseArguments(int argc, char** argv, std::string& enginePath, std::string&
 
 int main(int argc, char** argv) {
     try {
-        std::string enginePath, inputPath, outputPath, labelPath;
+        std::string enginePath, inputPath, outputPath, labelPath, profilePath;
         bool        useCudaGraph = false;
 
-        parseArguments(argc, argv, enginePath, inputPath, outputPath, labelPath, useCudaGraph);
+        parseArguments(argc, argv, enginePath, inputPath, outputPath, labelPath, profilePath, useCudaGraph);
 
         if (!fs::exists(enginePath)) {
             throw std::runtime_error("Engine path does not exist: " + enginePath);
@@ -168,6 +171,12 @@ int main(int argc, char** argv) {
 
         auto model = createModel(enginePath, useCudaGraph);
 
+        std::shared_ptr<deploy::LayerProfiler> profiler;
+        if (!profilePath.empty()) {
+            profiler = std::make_shared<deploy::LayerProfiler>();
+            model->setProfiler(profiler);
+        }
+
         if (fs::is_regular_file(inputPath)) {
             cv::Mat cvimage = cv::imread(inputPath, cv::IMREAD_COLOR);
             if (cvimage.empty()) {
@@ -236,6 +245,13 @@ int main(int argc, char** argv) {
             }
         }
 
+        if (profiler) {
+            model->setProfiler(nullptr);
+            profiler->exportChromeTrace(profilePath);
+            std::cout << profiler->table();
+            std::cout << "Layer profile saved to " << profilePath << std::endl;
+        }
+
         std::cout << "Inference completed." << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
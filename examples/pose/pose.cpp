@@ -6,6 +6,7 @@
 #include <opencv2/opencv.hpp>
 #include <random>
 
+#include "deploy/core/profiler.hpp"
 #include "deploy/utils/utils.hpp"
 #include "deploy/vision/inference.hpp"
 #include "deploy/vision/result.hpp"
@@ -94,20 +95,22 @@ void visualize(cv::Mat& image, deploy::PoseResult& result, std::vector<std::pair
         cv::rectangle(image, cv::Point(box.left, box.top - labelSize.height), cv::Point(box.left + labelSize.width, box.top), color, -1);
         cv::putText(image, labelText, cv::Point(box.left, box.top), cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(255, 255, 255), 1);
 
-        int  nkpt = result.kpts[i].size();
-        bool pose = nkpt == 17;
-        for (size_t j = 0; j < nkpt; ++j) {
-            if (int(result.kpts[i][j].x) % image.cols != 0 && int(result.kpts[i][j].y) % image.rows != 0) {
-                if (result.kpts[i][j].conf.has_value() && result.kpts[i][j].conf.value() < 0.25) {
+        auto keypoints = result.keypoints(i);
+        int  nkpt      = keypoints.size();
+        bool pose      = nkpt == 17;
+        for (int j = 0; j < nkpt; ++j) {
+            const auto kpt = keypoints[j];
+            if (int(kpt.x) % image.cols != 0 && int(kpt.y) % image.rows != 0) {
+                if (kpt.conf.has_value() && kpt.conf.value() < 0.25) {
                     continue;
                 }
-                cv::circle(image, cv::Point(result.kpts[i][j].x, result.kpts[i][j].y), 3, color, -1, cv::LINE_AA);
+                cv::circle(image, cv::Point(kpt.x, kpt.y), 3, color, -1, cv::LINE_AA);
             }
         }
         if (pose) {
             for (const auto& sk : skeleton) {
-                const auto& kpt1 = result.kpts[i][sk.first - 1];
-                const auto& kpt2 = result.kpts[i][sk.second - 1];
+                const auto kpt1 = keypoints[sk.first - 1];
+                const auto kpt2 = keypoints[sk.second - 1];
 
                 if (kpt1.conf < 0.25 || kpt2.conf < 0.25) {
                     continue;
@@ -134,11 +137,11 @@ std::shared_ptr<deploy::BasePose> createModel(const std::string& enginePath, boo
 }
 
 // Parse arguments
-void parseArguments(int argc, char** argv, std::string& enginePath, std::string& inputPath, std::string& outputPath, std::string& labelPath, bool& useCudaGraph) {
+void parseArguments(int argc, char** argv, std::string& enginePath, std::string& inputPath, std::string& outputPath, std::string& labelPath, std::string& profilePath, bool& useCudaGraph) {
     // Using a library for argument parsing (e.g., Boost.Program_options)
     // For simplicity, manual parsing is shown here
     if (argc < 5) {
-        std::cerr << "Usage: " << argv[0] << " -e <engine> -i <input> [-o <output>] [-l <labels>] [--cudaGraph]" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " -e <engine> -i <input> [-o <output>] [-l <labels>] [--cudaGraph] [--profile <trace.json>]" << std::endl;
         std::exit(EXIT_FAILURE);
     }
 
@@ -154,6 +157,8 @@ void parseArguments(int argc, char** argv, std::string& enginePath, std::string&
             labelPath = argv[++i];
         } else if (arg == "--cudaGraph") {
             useCudaGraph = true;
+        } else if (arg == "--profile") {
+            profilePath = argv[++i];
         } else {
             std::cerr << "Unknown argument: " << arg << std::endl;
             std::exit(EXIT_FAILURE);
@@ -163,10 +168,10 @@ void parseArguments(int argc, char** argv, std::string& enginePath, std::string&
 
 int main(int argc, char** argv) {
     try {
-        std::string enginePath, inputPath, outputPath, labelPath;
+        std::string enginePath, inputPath, outputPath, labelPath, profilePath;
         bool        useCudaGraph = false;
 
-        parseArguments(argc, argv, enginePath, inputPath, outputPath, labelPath, useCudaGraph);
+        parseArguments(argc, argv, enginePath, inputPath, outputPath, labelPath, profilePath, useCudaGraph);
 
         if (!fs::exists(enginePath)) {
             throw std::runtime_error("Engine path does not exist: " + enginePath);
@@ -190,6 +195,12 @@ int main(int argc, char** argv) {
 
         auto model = createModel(enginePath, useCudaGraph);
 
+        std::shared_ptr<deploy::LayerProfiler> profiler;
+        if (!profilePath.empty()) {
+            profiler = std::make_shared<deploy::LayerProfiler>();
+            model->setProfiler(profiler);
+        }
+
         if (fs::is_regular_file(inputPath)) {
             cv::Mat cvimage = cv::imread(inputPath, cv::IMREAD_COLOR);
             if (cvimage.empty()) {
@@ -258,6 +269,13 @@ int main(int argc, char** argv) {
             }
         }
 
+        if (profiler) {
+            model->setProfiler(nullptr);
+            profiler->exportChromeTrace(profilePath);
+            std::cout << profiler->table();
+            std::cout << "Layer profile saved to " << profilePath << std::endl;
+        }
+
         std::cout << "Inference completed." << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
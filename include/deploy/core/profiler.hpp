@@ -0,0 +1,126 @@
+#pragma once
+
+#include <NvInferRuntime.h>
+
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "deploy/core/macro.hpp"
+
+namespace deploy {
+
+/**
+ * @brief Aggregated execution time of a single engine layer, in milliseconds.
+ */
+struct DEPLOYAPI LayerTiming {
+    std::string name{};      /**< Name of the layer */
+    int         count{0};    /**< Number of reported executions */
+    float       total{0.0F}; /**< Sum of the execution times */
+    float       min{0.0F};   /**< Shortest execution time */
+    float       max{0.0F};   /**< Longest execution time */
+
+    /**
+     * @brief Gets the mean execution time.
+     *
+     * @return float Mean execution time in milliseconds.
+     */
+    [[nodiscard]] float mean() const noexcept {
+        return count > 0 ? total / static_cast<float>(count) : 0.0F;
+    }
+};
+
+/**
+ * @brief TensorRT profiler that accumulates per-layer execution times over several runs.
+ *
+ * Attach it to an execution context with IExecutionContext::setProfiler (or BaseTemplate::setProfiler).
+ * TensorRT reports the layers of one enqueue in execution order; a new run starts whenever a layer
+ * is reported again. The first runs are kept individually for the Chrome trace export, while the
+ * aggregated statistics cover every run.
+ */
+class DEPLOYAPI LayerProfiler : public nvinfer1::IProfiler {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param maxTraceRuns Maximum number of runs kept for the Chrome trace export.
+     */
+    explicit LayerProfiler(int maxTraceRuns = 100) : mMaxTraceRuns(maxTraceRuns) {}
+
+    /**
+     * @brief Records the execution time of a layer, called by TensorRT.
+     *
+     * @param layerName Name of the layer.
+     * @param ms Execution time in milliseconds.
+     */
+    void reportLayerTime(const char* layerName, float ms) noexcept override;
+
+    /**
+     * @brief Discards all recorded runs.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the number of runs recorded so far.
+     *
+     * @return int Number of runs.
+     */
+    [[nodiscard]] int runs() const;
+
+    /**
+     * @brief Gets the aggregated layer timings, sorted by total time in descending order.
+     *
+     * @return std::vector<LayerTiming> Per-layer timings.
+     */
+    [[nodiscard]] std::vector<LayerTiming> layers() const;
+
+    /**
+     * @brief Writes the recorded runs as a Chrome trace_event JSON document.
+     *
+     * The output can be loaded in chrome://tracing or Perfetto. Each layer execution becomes a complete
+     * event, and runs are laid out one after another on the same track. The formatting of the stream is
+     * left unchanged.
+     *
+     * @param os Output stream.
+     */
+    void writeChromeTrace(std::ostream& os) const;
+
+    /**
+     * @brief Writes the aggregated layer timings as a text table sorted by total time.
+     *
+     * The formatting of the stream is left unchanged.
+     *
+     * @param os Output stream.
+     */
+    void writeTable(std::ostream& os) const;
+
+    /**
+     * @brief Writes the Chrome trace to a file.
+     *
+     * @param filePath Path of the JSON file to write.
+     * @throw std::runtime_error If the file cannot be written.
+     */
+    void exportChromeTrace(const std::string& filePath) const;
+
+    /**
+     * @brief Gets the aggregated layer timings as a text table.
+     *
+     * @return std::string The formatted table.
+     */
+    [[nodiscard]] std::string table() const;
+
+private:
+    int                                                mMaxTraceRuns; /**< Maximum number of runs kept for the trace */
+    int                                                mRuns{0};      /**< Number of runs recorded */
+    std::vector<bool>                                  mSeen{};       /**< Layers already reported in the current run */
+    std::vector<LayerTiming>                           mLayers{};     /**< Aggregated timings, in first-report order */
+    std::unordered_map<std::string, size_t>            mIndex{};      /**< Layer name to index in mLayers */
+    std::vector<std::vector<std::pair<size_t, float>>> mTrace{};      /**< Per-run layer executions kept for the trace */
+    mutable std::mutex                                 mMutex;        /**< Guards all recorded data */
+};
+
+}  // namespace deploy
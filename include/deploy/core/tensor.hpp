@@ -21,6 +21,12 @@ private:
     int64_t deviceBytes = 0;       /**< Size of device memory in bytes */
     int64_t hostCap     = 0;       /**< Capacity of host memory in bytes */
     int64_t deviceCap   = 0;       /**< Capacity of device memory in bytes */
+    bool    hostPinned  = false;   /**< Whether host memory is page-locked, false when it fell back to pageable memory */
+
+    /**
+     * @brief Releases host memory, whether page-locked or pageable.
+     */
+    void freeHost();
 
     /**
      * @brief Reallocates host memory to the specified size.
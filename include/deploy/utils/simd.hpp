@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+
+// Thin wrappers over the float vectors of the host compiler's target. The build sets no -march flags, so the width
+// is chosen at compile time: SSE2 is always present on x86-64 and NEON on aarch64, AVX is used when the compiler
+// targets it (-mavx2, /arch:AVX2), and other targets fall back to one float per vector.
+#if defined(__AVX__)
+#include <immintrin.h>
+#define DEPLOY_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DEPLOY_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DEPLOY_SIMD_NEON
+#endif
+
+namespace deploy {
+namespace simd {
+
+#if defined(DEPLOY_SIMD_AVX)
+using Float          = __m256;
+constexpr int kLanes = 8;
+
+inline Float load(const float* p) { return _mm256_loadu_ps(p); }
+inline void  store(float* p, Float v) { _mm256_storeu_ps(p, v); }
+inline Float set1(float v) { return _mm256_set1_ps(v); }
+inline Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+inline Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+inline Float min(Float a, Float b) { return _mm256_min_ps(a, b); }
+inline Float max(Float a, Float b) { return _mm256_max_ps(a, b); }
+inline Float greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline Float greaterEqual(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+inline Float select(Float mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+inline int   moveMask(Float mask) { return _mm256_movemask_ps(mask); }
+#elif defined(DEPLOY_SIMD_SSE)
+using Float          = __m128;
+constexpr int kLanes = 4;
+
+inline Float load(const float* p) { return _mm_loadu_ps(p); }
+inline void  store(float* p, Float v) { _mm_storeu_ps(p, v); }
+inline Float set1(float v) { return _mm_set1_ps(v); }
+inline Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+inline Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+inline Float min(Float a, Float b) { return _mm_min_ps(a, b); }
+inline Float max(Float a, Float b) { return _mm_max_ps(a, b); }
+inline Float greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+inline Float greaterEqual(Float a, Float b) { return _mm_cmpge_ps(a, b); }
+inline Float select(Float mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+inline int   moveMask(Float mask) { return _mm_movemask_ps(mask); }
+#elif defined(DEPLOY_SIMD_NEON)
+using Float          = float32x4_t;
+constexpr int kLanes = 4;
+
+inline Float load(const float* p) { return vld1q_f32(p); }
+inline void  store(float* p, Float v) { vst1q_f32(p, v); }
+inline Float set1(float v) { return vdupq_n_f32(v); }
+inline Float add(Float a, Float b) { return vaddq_f32(a, b); }
+inline Float mul(Float a, Float b) { return vmulq_f32(a, b); }
+inline Float min(Float a, Float b) { return vminq_f32(a, b); }
+inline Float max(Float a, Float b) { return vmaxq_f32(a, b); }
+inline Float greater(Float a, Float b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+inline Float greaterEqual(Float a, Float b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+inline Float select(Float mask, Float a, Float b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+inline int   moveMask(Float mask) {
+    uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+    return static_cast<int>(vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3));
+}
+#else
+using Float          = float;
+constexpr int kLanes = 1;
+
+inline Float load(const float* p) { return *p; }
+inline void  store(float* p, Float v) { *p = v; }
+inline Float set1(float v) { return v; }
+inline Float add(Float a, Float b) { return a + b; }
+inline Float mul(Float a, Float b) { return a * b; }
+inline Float min(Float a, Float b) { return a < b ? a : b; }
+inline Float max(Float a, Float b) { return a > b ? a : b; }
+inline Float greater(Float a, Float b) { return a > b ? 1.0f : 0.0f; }
+inline Float greaterEqual(Float a, Float b) { return a >= b ? 1.0f : 0.0f; }
+inline Float select(Float mask, Float a, Float b) { return mask != 0.0f ? a : b; }
+inline int   moveMask(Float mask) { return mask != 0.0f ? 1 : 0; }
+#endif
+
+}  // namespace simd
+}  // namespace deploy
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "deploy/core/macro.hpp"
+
+namespace deploy {
+
+/**
+ * @brief Summary statistics of a latency distribution, in milliseconds.
+ */
+struct DEPLOYAPI LatencySummary {
+    uint64_t count{0};    /**< Number of recorded samples */
+    float    total{0.0F}; /**< Sum of all samples */
+    float    min{0.0F};   /**< Smallest sample */
+    float    mean{0.0F};  /**< Arithmetic mean of the samples */
+    float    max{0.0F};   /**< Largest sample */
+    float    p50{0.0F};   /**< 50th percentile */
+    float    p90{0.0F};   /**< 90th percentile */
+    float    p99{0.0F};   /**< 99th percentile */
+    float    p999{0.0F};  /**< 99.9th percentile */
+};
+
+/**
+ * @brief Lock-free latency histogram with HDR-style log-linear buckets.
+ *
+ * Samples are stored with nanosecond resolution. Each power of two is split into 32 linear
+ * sub-buckets, which bounds the relative error of reported percentiles to about 3%. Recording
+ * only uses relaxed atomic operations, so it is safe to call from any number of threads.
+ */
+class DEPLOYAPI LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&)            = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Records a latency sample.
+     *
+     * @param milliseconds Latency in milliseconds.
+     */
+    void record(float milliseconds) noexcept;
+
+    /**
+     * @brief Clears all recorded samples.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Gets the number of recorded samples.
+     *
+     * @return uint64_t Number of samples.
+     */
+    [[nodiscard]] uint64_t count() const noexcept;
+
+    /**
+     * @brief Gets the value below which the given percentage of samples fall.
+     *
+     * @param percent Percentile in the range [0, 100].
+     * @return float Latency in milliseconds, or 0 if no sample has been recorded.
+     */
+    [[nodiscard]] float percentile(float percent) const noexcept;
+
+    /**
+     * @brief Gets the summary statistics of the recorded samples.
+     *
+     * @return LatencySummary Summary of the distribution.
+     */
+    [[nodiscard]] LatencySummary summary() const noexcept;
+
+private:
+    static constexpr int subBucketBits  = 5;                               /**< Linear sub-buckets per power of two, as a power of two */
+    static constexpr int subBucketCount = 1 << subBucketBits;              /**< Linear sub-buckets per power of two */
+    static constexpr int maxShift       = 40;                              /**< Largest bucket width, as a power of two */
+    static constexpr int bucketCount    = (maxShift + 2) * subBucketCount; /**< Total number of buckets */
+
+    /**
+     * @brief Maps a value in nanoseconds to its bucket index.
+     */
+    static int bucketIndex(uint64_t value) noexcept;
+
+    /**
+     * @brief Maps a bucket index to the midpoint of its value range in nanoseconds.
+     */
+    static uint64_t bucketValue(int index) noexcept;
+
+    std::array<std::atomic<uint64_t>, bucketCount> mBuckets; /**< Per-bucket sample counts */
+    std::atomic<uint64_t>                          mCount;   /**< Total number of samples */
+    std::atomic<uint64_t>                          mSum;     /**< Sum of samples in nanoseconds */
+    std::atomic<uint64_t>                          mMin;     /**< Smallest sample in nanoseconds */
+    std::atomic<uint64_t>                          mMax;     /**< Largest sample in nanoseconds */
+};
+
+/**
+ * @brief Pipeline stages timed by the inference templates.
+ */
+enum class Stage : int {
+    kStaging = 0,  /**< Host copy of an image into pinned staging memory, per image */
+    kH2D,          /**< Host to device upload of an image, per image */
+    kWarp,         /**< Affine warp of an image into the input tensor, per image */
+    kEnqueue,      /**< Engine execution, per batch */
+    kD2H,          /**< Device to host download of the outputs, per batch */
+    kPostProcess,  /**< Decoding of the outputs into results, per image */
+    kGraph,        /**< CUDA graph launch covering upload, warp, execution and download, per batch */
+    kCount         /**< Number of stages */
+};
+
+/**
+ * @brief Gets the printable name of a stage.
+ *
+ * @param stage The pipeline stage.
+ * @return const char* Name of the stage.
+ */
+DEPLOYAPI const char* stageName(Stage stage);
+
+/**
+ * @brief Latency summary of a single pipeline stage.
+ */
+struct DEPLOYAPI StageStats {
+    std::string    stage{};   /**< Name of the stage */
+    LatencySummary latency{}; /**< Latency distribution of the stage */
+};
+
+/**
+ * @brief Collects per-stage latencies of an inference pipeline.
+ *
+ * Host stages are recorded directly. Device stages are bracketed with CUDA events grouped into
+ * frames; a frame is only resolved once all its events have completed, which is checked with
+ * cudaEventQuery so that timing never adds a synchronization to the pipeline.
+ */
+class DEPLOYAPI InferenceStats {
+public:
+    InferenceStats() = default;
+
+    InferenceStats(const InferenceStats&)            = delete;
+    InferenceStats& operator=(const InferenceStats&) = delete;
+
+    /**
+     * @brief Destructor, releases the CUDA events owned by the collector.
+     */
+    ~InferenceStats();
+
+    /**
+     * @brief Enables or disables latency collection.
+     *
+     * @param enabled True to collect latencies.
+     */
+    void setEnabled(bool enabled) noexcept {
+        mEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Checks whether latency collection is enabled.
+     *
+     * @return bool True if latencies are collected.
+     */
+    [[nodiscard]] bool enabled() const noexcept {
+        return mEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Enables or disables the emission of NVTX ranges around the pipeline stages.
+     *
+     * @param enabled True to emit NVTX ranges.
+     */
+    void setNvtxEnabled(bool enabled) noexcept {
+        mNvtx.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Checks whether NVTX ranges are emitted.
+     *
+     * @return bool True if NVTX ranges are emitted.
+     */
+    [[nodiscard]] bool nvtxEnabled() const noexcept {
+        return mNvtx.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records the latency of a host stage.
+     *
+     * @param stage The pipeline stage.
+     * @param milliseconds Latency in milliseconds.
+     */
+    void record(Stage stage, float milliseconds) noexcept;
+
+    /**
+     * @brief Records a CUDA event into the current frame.
+     *
+     * @param stream CUDA stream on which the event is recorded.
+     * @return int Index of the mark in the current frame, or -1 when collection is disabled.
+     */
+    int mark(cudaStream_t stream);
+
+    /**
+     * @brief Declares a device stage delimited by two marks of the current frame.
+     *
+     * @param stage The pipeline stage.
+     * @param start Mark recorded before the stage.
+     * @param stop Mark recorded after the stage.
+     */
+    void span(Stage stage, int start, int stop);
+
+    /**
+     * @brief Closes the current frame and queues it for resolution.
+     */
+    void commit();
+
+    /**
+     * @brief Resolves every queued frame whose events have completed, without blocking.
+     */
+    void collect();
+
+    /**
+     * @brief Gets the latency summary of every stage that has samples.
+     *
+     * @return std::vector<StageStats> Per-stage latency summaries.
+     */
+    std::vector<StageStats> summary();
+
+    /**
+     * @brief Discards all recorded samples and queued frames.
+     */
+    void reset();
+
+private:
+    /**
+     * @brief Device stage pending resolution.
+     */
+    struct Span {
+        Stage stage;
+        int   start;
+        int   stop;
+    };
+
+    /**
+     * @brief Group of events recorded by one pipeline run.
+     */
+    struct Frame {
+        std::vector<cudaEvent_t> events{};
+        std::vector<Span>        spans{};
+    };
+
+    static constexpr size_t maxPendingFrames = 64; /**< Frames kept before the oldest is dropped */
+
+    /**
+     * @brief Returns the events of a frame to the free list.
+     */
+    void recycle(Frame& frame);
+
+    std::array<LatencyHistogram, static_cast<int>(Stage::kCount)> mHistograms{}; /**< Per-stage histograms */
+    std::atomic<bool>                                              mEnabled{true}; /**< Whether latencies are collected */
+    std::atomic<bool>                                              mNvtx{false};   /**< Whether NVTX ranges are emitted */
+    std::mutex                                                     mMutex;         /**< Guards the frame queue and the event pool */
+    Frame                                                          mCurrent{};     /**< Frame being recorded */
+    std::deque<Frame>                                              mPending{};     /**< Frames waiting for their events */
+    std::vector<cudaEvent_t>                                       mFreeEvents{};  /**< Events available for reuse */
+};
+
+/**
+ * @brief Scoped NVTX range, pushed on construction and popped on destruction.
+ *
+ * The range is only emitted when enabled and when the library is built with NVTX headers available.
+ */
+class DEPLOYAPI NvtxRange {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param name Name of the range.
+     * @param enabled Whether the range is emitted.
+     */
+    NvtxRange(const char* name, bool enabled);
+
+    NvtxRange(const NvtxRange&)            = delete;
+    NvtxRange& operator=(const NvtxRange&) = delete;
+
+    /**
+     * @brief Destructor, closes the range.
+     */
+    ~NvtxRange();
+
+private:
+    bool mActive{false}; /**< Whether a range was pushed */
+};
+
+}  // namespace deploy
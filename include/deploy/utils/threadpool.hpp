@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "deploy/core/macro.hpp"
+
+namespace deploy {
+
+/**
+ * @brief Callable that runs task(i) for every i in [0, count) and returns once all of them have completed.
+ *
+ * The tasks are independent and may run concurrently on any thread. This is the extension point used to hand
+ * the per-image post-processing of a batch to an executor owned by the caller.
+ */
+using ParallelFor = std::function<void(int count, const std::function<void(int)>& task)>;
+
+/**
+ * @brief Fixed-size pool of worker threads running the iterations of a parallel loop.
+ *
+ * The calling thread takes part in every loop, so a pool with N workers runs up to N + 1 iterations at once.
+ * Iterations are handed out one at a time from a shared counter, which balances images with very different
+ * numbers of detections. Loops submitted from several threads are run one after the other.
+ */
+class DEPLOYAPI ThreadPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param threads Number of worker threads, in addition to the calling thread. Zero runs every loop on the
+     * calling thread.
+     */
+    explicit ThreadPool(int threads);
+
+    /**
+     * @brief Stops and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Gets the number of worker threads.
+     *
+     * @return int Number of worker threads, not counting the calling thread.
+     */
+    [[nodiscard]] int size() const noexcept {
+        return static_cast<int>(mWorkers.size());
+    }
+
+    /**
+     * @brief Runs task(i) for every i in [0, count) and waits for all of them.
+     *
+     * If tasks throw, the remaining ones still run and the first exception is rethrown to the caller.
+     *
+     * @param count Number of iterations.
+     * @param task Iteration body, called with the iteration index.
+     */
+    void parallelFor(int count, const std::function<void(int)>& task);
+
+private:
+    /**
+     * @brief Main loop of a worker thread.
+     */
+    void worker();
+
+    /**
+     * @brief Takes iterations of the current loop until none is left.
+     */
+    void drain();
+
+    std::vector<std::thread>         mWorkers;           /**< Worker threads */
+    std::mutex                       mSubmitMutex;       /**< Serializes the loops submitted concurrently */
+    std::mutex                       mMutex;             /**< Guards the state of the current loop */
+    std::condition_variable          mWake;              /**< Signals a new loop or the shutdown to the workers */
+    std::condition_variable          mDone;              /**< Signals the last worker leaving the current loop */
+    const std::function<void(int)>*  mTask{nullptr};     /**< Body of the current loop */
+    int                              mCount{0};          /**< Number of iterations of the current loop */
+    std::atomic<int>                 mNext{0};           /**< Next iteration to hand out */
+    int                              mBusy{0};           /**< Workers still running the current loop */
+    uint64_t                         mGeneration{0};     /**< Incremented at every loop, wakes up the workers */
+    bool                             mStop{false};       /**< Set by the destructor */
+    std::exception_ptr               mError{};           /**< First exception thrown by the current loop */
+};
+
+}  // namespace deploy
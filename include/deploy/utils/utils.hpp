@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "deploy/core/macro.hpp"
+#include "deploy/utils/stats.hpp"
 
 namespace deploy {
 
@@ -73,7 +74,7 @@ public:
     /**
      * @brief Resets the timer.
      */
-    void reset() noexcept {
+    virtual void reset() noexcept {
         setMilliseconds(0.0F);
     }
 
@@ -140,6 +141,96 @@ private:
     cudaStream_t mStream;  /**< CUDA stream */
 };
 
+/**
+ * @brief Class for GPU timer that never blocks the host.
+ *
+ * Each start/stop pair records two CUDA events into a ring. Elapsed times are resolved lazily with
+ * cudaEventQuery once the events have completed and aggregated into a latency histogram, so timing
+ * does not serialize the pipeline being measured. The host only waits when the ring is full, in
+ * which case the oldest pair is resolved first.
+ *
+ * The accumulated time reported by milliseconds() and the summary only include resolved pairs;
+ * call collect() or flush() before reading them.
+ */
+class DEPLOYAPI DeferredGpuTimer : public TimerBase {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param stream CUDA stream to associate with the timer.
+     * @param capacity Number of event pairs that may be in flight.
+     */
+    explicit DeferredGpuTimer(cudaStream_t stream = nullptr, int capacity = 64);
+
+    DeferredGpuTimer(const DeferredGpuTimer&)            = delete;
+    DeferredGpuTimer(DeferredGpuTimer&&)                 = delete;
+    DeferredGpuTimer& operator=(const DeferredGpuTimer&) = delete;
+    DeferredGpuTimer& operator=(DeferredGpuTimer&&)      = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~DeferredGpuTimer() override;
+
+    /**
+     * @brief Records the start event of a new pair.
+     */
+    void start() override;
+
+    /**
+     * @brief Records the stop event of the current pair without waiting for it.
+     */
+    void stop() override;
+
+    /**
+     * @brief Discards pending pairs and all aggregated samples.
+     */
+    void reset() noexcept override;
+
+    /**
+     * @brief Resolves every pending pair whose events have completed, without blocking.
+     */
+    void collect();
+
+    /**
+     * @brief Waits for and resolves every pending pair.
+     */
+    void flush();
+
+    /**
+     * @brief Gets the number of pairs recorded but not resolved yet.
+     *
+     * @return int Number of pending pairs.
+     */
+    [[nodiscard]] int pending() const noexcept {
+        return mPending;
+    }
+
+    /**
+     * @brief Gets the distribution of the resolved elapsed times, after resolving completed pairs.
+     *
+     * @return LatencySummary Summary of the resolved samples, in milliseconds.
+     */
+    LatencySummary summary();
+
+private:
+    /**
+     * @brief Resolves the oldest pending pair, optionally waiting for it.
+     *
+     * @param wait Whether to wait for the pair to complete.
+     * @return bool True if the pair was resolved.
+     */
+    bool resolveOldest(bool wait);
+
+    std::vector<cudaEvent_t> mStarts{};       /**< Ring of start events */
+    std::vector<cudaEvent_t> mStops{};        /**< Ring of stop events */
+    LatencyHistogram         mHistogram{};    /**< Distribution of resolved samples */
+    cudaStream_t             mStream;         /**< CUDA stream */
+    int                      mHead{0};        /**< Index of the oldest pending pair */
+    int                      mPending{0};     /**< Number of pending pairs */
+    bool                     mStarted{false}; /**< Whether a pair has been started but not stopped */
+};
+
 /**
  * @brief Class for CPU timer using high resolution clock.
  */
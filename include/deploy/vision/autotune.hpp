@@ -0,0 +1,278 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "deploy/core/macro.hpp"
+#include "deploy/utils/stats.hpp"
+#include "deploy/utils/utils.hpp"
+#include "deploy/vision/inference.hpp"
+#include "deploy/vision/result.hpp"
+
+namespace deploy {
+
+/**
+ * @brief Settings of a batch size sweep.
+ */
+struct DEPLOYAPI AutotuneOptions {
+    std::vector<int> batches{};          /**< Batch sizes swept, every size from 1 to the model batch when empty */
+    int              warmup     = 3;     /**< Batches run and discarded before measuring each size */
+    int              iterations = 20;    /**< Batches measured for each size */
+    float            percentile = 90.0f; /**< Percentile of the measured latencies kept for each size, in [0, 100] */
+};
+
+/**
+ * @brief Measured latency of one batch size.
+ */
+struct DEPLOYAPI LatencyPoint {
+    int            batch   = 0;    /**< Batch size */
+    float          latency = 0.0f; /**< Latency of a batch at the percentile of the sweep, in milliseconds */
+    LatencySummary summary{};      /**< Distribution of the measured latencies */
+};
+
+/**
+ * @brief Affine model of the latency of a batch: a fixed cost per batch plus a cost per image.
+ */
+struct DEPLOYAPI LatencyModel {
+    double fixedMs    = 0.0; /**< Latency of a batch independent of its size, in milliseconds */
+    double perImageMs = 0.0; /**< Latency added by each image of a batch, in milliseconds */
+
+    /**
+     * @brief Gets the latency predicted for a batch size.
+     *
+     * @param batch Batch size.
+     * @return double Predicted latency, in milliseconds.
+     */
+    double predict(int batch) const {
+        return fixedMs + perImageMs * batch;
+    }
+
+    /**
+     * @brief Gets the largest batch predicted to complete within a time.
+     *
+     * @param budgetMs Time available, in milliseconds.
+     * @param maxBatch Largest batch size allowed.
+     * @return int Batch size, 0 if not even a single image fits.
+     */
+    int largestBatch(double budgetMs, int maxBatch) const;
+
+    /**
+     * @brief Fits the model to measured points by least squares.
+     *
+     * A negative cost, which only comes from noise, is set to 0 and the other one refitted. A single point is
+     * fitted with no fixed cost, the conservative choice for the larger batches.
+     *
+     * @param points Measured points, one per batch size.
+     * @return LatencyModel Fitted model, all zeros without points.
+     */
+    static LatencyModel fit(const std::vector<LatencyPoint>& points);
+};
+
+/**
+ * @brief Latency curve of a model over batch sizes, with the model fitted to it.
+ */
+struct DEPLOYAPI LatencyCurve {
+    std::vector<LatencyPoint> points{}; /**< Measured points, in increasing batch size */
+    LatencyModel              model{};  /**< Model fitted to the points */
+
+    /**
+     * @brief Writes the curve and its model as a JSON document.
+     *
+     * @param os Output stream, whose formatting is restored afterwards.
+     */
+    void writeJson(std::ostream& os) const;
+
+    /**
+     * @brief Writes the JSON document of the curve to a file.
+     *
+     * @param filePath Path of the JSON file to write.
+     * @throw std::runtime_error If the file cannot be written.
+     */
+    void exportJson(const std::string& filePath) const;
+};
+
+/**
+ * @brief Measures the latency of each batch size and fits a latency model to the measurements.
+ *
+ * The batch is run through a function, so that the sweep can be driven by a model as well as by a synthetic
+ * latency model.
+ *
+ * @param maxBatch Largest batch size accepted by run.
+ * @param run Runs one batch of the given size and returns its latency in milliseconds, or a negative value on failure.
+ * @param options (Optional) Settings of the sweep.
+ * @return LatencyCurve Measured curve and fitted model.
+ * @throw std::invalid_argument If the settings are out of range.
+ * @throw std::runtime_error If a batch fails.
+ */
+DEPLOYAPI LatencyCurve sweepBatches(int maxBatch, const std::function<float(int batch)>& run, const AutotuneOptions& options = {});
+
+/**
+ * @brief Measures the end-to-end latency of a model, from the images to the results, for each batch size.
+ *
+ * Meant for DeployTemplate models of dynamic batch engines: a static engine always runs its full batch, so
+ * its curve is flat.
+ *
+ * @param model Model to measure, not used by anything else during the sweep.
+ * @param images Sample images, repeated to fill the batches.
+ * @param options (Optional) Settings of the sweep.
+ * @return LatencyCurve Measured curve and fitted model.
+ * @throw std::invalid_argument If there is no image or the settings are out of range.
+ * @throw std::runtime_error If a batch fails.
+ */
+template <typename T>
+LatencyCurve autotuneBatch(BaseTemplate<T>& model, const std::vector<Image>& images, const AutotuneOptions& options = {}) {
+    if (images.empty()) {
+        throw std::invalid_argument("Autotuning needs at least one sample image.");
+    }
+
+    std::vector<Image> batchImages;
+    std::vector<T>     results;
+    return sweepBatches(
+        model.batch,
+        [&](int batch) {
+            batchImages.clear();
+            for (int i = 0; i < batch; ++i) batchImages.push_back(images[i % images.size()]);
+
+            CpuTimer timer;
+            timer.start();
+            bool success = model.predictInto(batchImages, results);
+            timer.stop();
+            return success ? timer.milliseconds() : -1.0f;
+        },
+        options);
+}
+
+/**
+ * @brief Batch size chosen by a BatchPolicy.
+ */
+struct DEPLOYAPI BatchDecision {
+    int    queued       = 0;    /**< Images waiting when the decision was made */
+    double waitMs       = 0.0;  /**< Time the oldest waiting image had already waited, in milliseconds */
+    int    batch        = 0;    /**< Batch size chosen, 0 when nothing was waiting */
+    double predictedMs  = 0.0;  /**< Predicted latency of the batch, in milliseconds */
+    bool   withinBudget = true; /**< Whether the oldest image is predicted to complete within the budget */
+};
+
+/**
+ * @brief Chooses the batch sizes of a serving loop from a latency budget and a latency model.
+ *
+ * Each decision takes the largest batch that completes within what is left of the budget of the oldest
+ * waiting image, and no more images than are waiting: small batches at low load keep the latency down, and
+ * batches grow with the queue up to the budget. When the budget cannot be met anymore, the largest batch is
+ * taken instead, to drain the queue at the highest throughput.
+ *
+ * The model starts from an autotuned curve and follows the measured latencies reported by observe: each
+ * measurement moves the whole curve by an exponential moving average of its ratio to the estimate of its batch
+ * size, so the decisions adapt when the device slows down or speeds up, under any mix of batch sizes.
+ *
+ * Calls are thread-safe.
+ */
+class DEPLOYAPI BatchPolicy {
+public:
+    /**
+     * @brief Constructor to initialize BatchPolicy with a latency curve and a budget.
+     *
+     * @param curve Latency curve, its points are the initial estimates.
+     * @param budgetMs Latency budget of an image, from its arrival to its result, in milliseconds.
+     * @param maxBatch (Optional) Largest batch size, the largest of the curve when 0. Defaults to 0.
+     * @param smoothing (Optional) Weight of an observed latency in the estimates, in (0, 1]. Defaults to 0.2.
+     * @param historySize (Optional) Number of recent decisions kept for export. Defaults to 1024.
+     * @throw std::invalid_argument If the curve is empty or the settings are out of range.
+     */
+    BatchPolicy(const LatencyCurve& curve, double budgetMs, int maxBatch = 0, double smoothing = 0.2, size_t historySize = 1024);
+
+    /**
+     * @brief Chooses the size of the next batch.
+     *
+     * @param queued Number of images waiting.
+     * @param waitMs Time the oldest waiting image has already waited, in milliseconds.
+     * @return int Batch size, between 1 and the number of waiting images, or 0 when nothing is waiting.
+     */
+    int decide(int queued, double waitMs);
+
+    /**
+     * @brief Reports the measured latency of a batch, updating the model.
+     *
+     * @param batch Batch size.
+     * @param latencyMs Measured latency of the batch, in milliseconds.
+     */
+    void observe(int batch, double latencyMs);
+
+    /**
+     * @brief Gets the latency model used by the decisions.
+     *
+     * @return LatencyModel Model fitted to the current estimates.
+     */
+    LatencyModel model() const;
+
+    /**
+     * @brief Gets the recent decisions, oldest first.
+     *
+     * @return std::vector<BatchDecision> Up to historySize decisions.
+     */
+    std::vector<BatchDecision> decisions() const;
+
+    /**
+     * @brief Writes the budget, the current estimates, the model and the recent decisions as a JSON document.
+     *
+     * @param os Output stream, whose formatting is restored afterwards.
+     */
+    void writeJson(std::ostream& os) const;
+
+    /**
+     * @brief Writes the JSON document of the policy to a file.
+     *
+     * @param filePath Path of the JSON file to write.
+     * @throw std::runtime_error If the file cannot be written.
+     */
+    void exportJson(const std::string& filePath) const;
+
+private:
+    /**
+     * @brief Latency budget of an image, in milliseconds.
+     */
+    double budgetMs{0.0};
+
+    /**
+     * @brief Largest batch size.
+     */
+    int maxBatch{0};
+
+    /**
+     * @brief Weight of an observed latency in the estimates.
+     */
+    double smoothing{0.0};
+
+    /**
+     * @brief Number of recent decisions kept.
+     */
+    size_t historySize{0};
+
+    /**
+     * @brief Estimated latency of each batch size swept or observed, in increasing batch size. The model is fitted to them.
+     */
+    std::vector<LatencyPoint> estimates{};
+
+    /**
+     * @brief Model fitted to the estimates.
+     */
+    LatencyModel fitted{};
+
+    /**
+     * @brief Recent decisions, oldest first.
+     */
+    std::deque<BatchDecision> history{};
+
+    /**
+     * @brief Guards the estimates, the model and the decisions.
+     */
+    mutable std::mutex mutex{};
+};
+
+}  // namespace deploy
@@ -10,11 +10,13 @@ namespace deploy {
  * @brief Struct representing a 2x3 transformation matrix for affine warp.
  */
 struct TransformMatrix {
-    float3 matrix[2];   // The 2x3 transformation matrix for affine warp.
-    int    lastWidth;   // Width of the last processed source image.
-    int    lastHeight;  // Height of the last processed source image.
-    int    dw;          // Destination image's width offset after transformation.
-    int    dh;          // Destination image's height offset after transformation.
+    float3 matrix[2];    // The 2x3 transformation matrix for affine warp.
+    int    lastWidth;    // Width of the last processed source image.
+    int    lastHeight;   // Height of the last processed source image.
+    int    lastToWidth;  // Width of the last target image.
+    int    lastToHeight; // Height of the last target image.
+    int    dw;           // Destination image's width offset after transformation.
+    int    dh;           // Destination image's height offset after transformation.
 
     /**
      * @brief Updates the warp matrix based on the change in source and target image dimensions.
@@ -35,6 +37,32 @@ struct TransformMatrix {
      * @param[out] oy Transformed Y-coordinate.
      */
     void transform(float x, float y, float* ox, float* oy) const;
+
+    /**
+     * @brief Transforms a buffer of interleaved points in place using the warp matrix.
+     *
+     * Point i has its x and y coordinates at points[i * stride] and points[i * stride + 1]; the values in
+     * between, such as key point confidences, are left untouched.
+     *
+     * @param points Pointer to the first x-coordinate.
+     * @param count Number of points.
+     * @param stride Distance between two consecutive points, in floats (at least 2).
+     */
+    void transformPoints(float* points, int count, int stride) const;
+
+    /**
+     * @brief Transforms a buffer of interleaved boxes in place using the warp matrix.
+     *
+     * Box i starts with its left, top, right and bottom coordinates at boxes[i * stride]; the values after
+     * them, such as the angle of a rotated box, are left untouched. Both helpers use SSE, AVX or NEON when
+     * the host compiler targets them.
+     *
+     * @param boxes Pointer to the first left coordinate.
+     * @param count Number of boxes.
+     * @param stride Distance between two consecutive boxes, in floats (at least 4).
+     * @param clip Whether to clip the coordinates to the last processed source image.
+     */
+    void transformBoxes(float* boxes, int count, int stride, bool clip) const;
 };
 
 /**
@@ -53,4 +81,51 @@ void cudaWarpAffine(
     uint8_t* input, uint32_t inputWidth, uint32_t inputHeight,
     float* output, uint32_t outputWidth, uint32_t outputHeight, float3 matrix[2], cudaStream_t stream);
 
+/**
+ * @brief Applies the same affine warp transformation as cudaWarpAffine on the CPU.
+ *
+ * Host reference of the CUDA kernel, used to validate its output and to benchmark the host-side
+ * pipeline without a GPU.
+ *
+ * @param input Pointer to the input image data (RGB, HWC).
+ * @param inputWidth Width of the input image.
+ * @param inputHeight Height of the input image.
+ * @param output Pointer to the output image data (normalized, CHW).
+ * @param outputWidth Width of the output image.
+ * @param outputHeight Height of the output image.
+ * @param matrix Affine transformation matrix.
+ */
+void cpuWarpAffine(
+    const uint8_t* input, uint32_t inputWidth, uint32_t inputHeight,
+    float* output, uint32_t outputWidth, uint32_t outputHeight, const float3 matrix[2]);
+
+/**
+ * @brief Maps the detections of a batch back to the source images on the GPU, in place.
+ *
+ * Image i owns maxDets detection slots starting at data + i * maxDets * itemsPerDet * stride, of which only the
+ * first numDets[i] are valid. Each detection holds itemsPerDet items of stride floats, and the first coords
+ * floats of an item alternate between x and y: one box (coords 4), or the key points of a pose (coords 2).
+ *
+ * @param data Device pointer to the boxes or key points of the batch.
+ * @param numDets Device pointer to the number of valid detections of each image.
+ * @param batch Number of images.
+ * @param maxDets Number of detection slots per image.
+ * @param itemsPerDet Number of items per detection.
+ * @param stride Distance between two consecutive items, in floats.
+ * @param coords Number of coordinates at the start of each item (2 or 4).
+ * @param clip Whether to clip the coordinates to the source image.
+ * @param transforms Device pointer to the transform of each image.
+ * @param stream CUDA stream for asynchronous execution.
+ */
+void cudaTransformDetections(
+    float* data, const int* numDets, int batch, int maxDets, int itemsPerDet, int stride, int coords, bool clip,
+    const TransformMatrix* transforms, cudaStream_t stream);
+
+/**
+ * @brief Applies the same mapping as cudaTransformDetections on the CPU, with host pointers.
+ */
+void cpuTransformDetections(
+    float* data, const int* numDets, int batch, int maxDets, int itemsPerDet, int stride, int coords, bool clip,
+    const TransformMatrix* transforms);
+
 }  // namespace deploy
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include "deploy/core/macro.hpp"
+
+namespace deploy {
+
+/**
+ * @brief Layout and NMS settings of a raw detection head, for engines exported without the NMS plugins.
+ *
+ * The head output of an image is laid out as [channels, anchors], like the ONNX export of YOLOv8 and YOLO11: the
+ * box center x, center y, width and height in model input pixels, one score per class, then the angle in radians
+ * for rotated boxes.
+ */
+struct DEPLOYAPI RawHead {
+    int                numClasses     = 0;     /**< Number of class score channels */
+    int                numAnchors     = 0;     /**< Number of anchors, 8400 at 640x640 */
+    bool               rotated        = false; /**< Whether an angle channel follows the class scores */
+    float              scoreThreshold = 0.25f; /**< Minimum score of a detection */
+    float              iouThreshold   = 0.45f; /**< IoU at or above which a lower scoring box of the same class is suppressed */
+    int                maxDets        = 100;   /**< Maximum number of detections per image */
+    int                maxCandidates  = 30000; /**< Maximum number of boxes entering NMS, the highest scoring are kept */
+    std::vector<float> classScoreThresholds{}; /**< Score threshold of each class, applied when higher, or empty */
+};
+
+/**
+ * @brief Scratch buffers and output of decodeRawHead, reused from one image to the next.
+ */
+struct DEPLOYAPI RawDecodeWorkspace {
+    std::vector<float> bestScores{};  /**< Highest class score of each anchor */
+    std::vector<float> bestClasses{}; /**< Class of the highest score of each anchor */
+    std::vector<int>   candidates{};  /**< Anchors reaching the score threshold, not visited by NMS yet, as a heap */
+    std::vector<float> covariances{}; /**< Covariance terms of the kept rotated boxes, for ProbIoU */
+    std::vector<float> boxes{};       /**< Kept boxes: left, top, right, bottom, then the angle of rotated boxes */
+    std::vector<float> scores{};      /**< Scores of the kept boxes */
+    std::vector<int>   classes{};     /**< Classes of the kept boxes */
+};
+
+/**
+ * @brief Decodes the raw head output of one image into detections.
+ *
+ * Each anchor keeps its highest class score, anchors below the score threshold are dropped, and a greedy
+ * NMS per class runs over the rest in decreasing score order (ties in anchor order). Axis-aligned boxes use IoU,
+ * rotated boxes use ProbIoU, the Gaussian overlap measure of YOLO OBB. The boxes stay in model input coordinates.
+ *
+ * @param output Raw head output of the image, [channels, anchors].
+ * @param head Layout and NMS settings of the head.
+ * @param workspace Scratch buffers, receiving the detections in boxes, scores and classes.
+ * @return int Number of detections.
+ */
+DEPLOYAPI int decodeRawHead(const float* output, const RawHead& head, RawDecodeWorkspace& workspace);
+
+}  // namespace deploy
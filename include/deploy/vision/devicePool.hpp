@@ -0,0 +1,251 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "deploy/core/macro.hpp"
+#include "deploy/vision/inference.hpp"
+#include "deploy/vision/result.hpp"
+
+namespace deploy {
+
+/**
+ * @brief Load of one device of a DevicePool.
+ */
+struct DEPLOYAPI DeviceLoad {
+    int     device     = 0;   /**< Device index */
+    int     instances  = 0;   /**< Number of model instances on the device */
+    int     queued     = 0;   /**< Images waiting in the queue of the device */
+    int     running    = 0;   /**< Images being inferred on the device */
+    int64_t completed  = 0;   /**< Batches completed on the device */
+    int64_t stolen     = 0;   /**< Batches taken from the queue of another device */
+    double  msPerImage = 0.0; /**< Moving average of the measured latency per image, 0 until measured */
+};
+
+/**
+ * @brief DevicePool class, spreads batches over model instances on several devices.
+ *
+ * Every device has its own queue, served by one thread per model instance. A batch goes to the device where it
+ * is expected to complete first, from the images already queued and running there and the latency per image
+ * measured on it, so faster devices receive more work. A thread with an empty queue takes the last batch of the
+ * busiest device when it can complete it sooner than that device would, which corrects the estimates of the
+ * dispatch when the load changes.
+ *
+ * The models are created by a factory, which makes the dispatch usable with mocked backends.
+ */
+template <typename T>
+class DEPLOYAPI DevicePool {
+public:
+    // Use static_assert to ensure that T is either DetResult, OBBResult, SegResult, or PoseResult..
+    static_assert(
+        std::is_same<T, DetResult>::value ||
+            std::is_same<T, OBBResult>::value ||
+            std::is_same<T, SegResult>::value ||
+            std::is_same<T, PoseResult>::value,
+        "T must be either DetResult, OBBResult, SegResult, or PoseResult.");
+
+    /**
+     * @brief Creates the model instance of a device.
+     */
+    using Factory = std::function<std::unique_ptr<BaseTemplate<T>>(int device)>;
+
+    /**
+     * @brief Constructor to initialize DevicePool with a model file loaded on each listed device.
+     *
+     * @param file The path to the model file, built for every listed device.
+     * @param devices Device indices, a device may be listed once.
+     * @param instances (Optional) Number of model instances per device. Defaults to 1.
+     * @param cudaGraph (Optional) Whether to create DeployCGTemplate models (true) or DeployTemplate models (false). Defaults to false.
+     * @param cudaMem (Optional) Flag indicating whether input data resides in GPU memory (true) or CPU memory (false). Defaults to false.
+     */
+    DevicePool(const std::string& file, const std::vector<int>& devices, int instances = 1, bool cudaGraph = false, bool cudaMem = false);
+
+    /**
+     * @brief Constructor to initialize DevicePool with models created by a factory.
+     *
+     * @param factory Creates each model instance, called with the index of its device.
+     * @param devices Device indices, a device may be listed once.
+     * @param instances (Optional) Number of model instances per device. Defaults to 1.
+     * @param setDevice (Optional) Whether the serving threads make their device current before running a model. Defaults to false.
+     */
+    DevicePool(Factory factory, const std::vector<int>& devices, int instances = 1, bool setDevice = false);
+
+    /**
+     * @brief Completes the batches already submitted, then stops the serving threads and releases the models.
+     */
+    ~DevicePool();
+
+    DevicePool(const DevicePool&)            = delete;
+    DevicePool& operator=(const DevicePool&) = delete;
+
+    /**
+     * @brief Submits a batch and returns without waiting for it.
+     *
+     * The image data is read when the batch runs, it must stay valid until the future is ready.
+     *
+     * @param images Vector containing batch of input images, at most batch() images.
+     * @return std::future<std::vector<T>> Results of the batch, empty if the inference failed.
+     * @throw std::runtime_error If the batch is empty or larger than batch().
+     */
+    std::future<std::vector<T>> submit(const std::vector<Image>& images);
+
+    /**
+     * @brief Performs inference on a batch on the device expected to complete it first, and waits for it.
+     *
+     * @param images Vector containing batch of input images, at most batch() images.
+     * @return std::vector<T> Vector of inference results for each image in the batch.
+     */
+    std::vector<T> predict(const std::vector<Image>& images);
+
+    /**
+     * @brief Gets the largest batch accepted, the smallest batch size of the models.
+     *
+     * @return int Batch size.
+     */
+    int batch() const {
+        return maxBatch;
+    }
+
+    /**
+     * @brief Gets the current load of each device, in the order they were listed.
+     *
+     * A batch is counted as completed before its future becomes ready.
+     *
+     * @return std::vector<DeviceLoad> Load of each device.
+     */
+    std::vector<DeviceLoad> loads() const;
+
+private:
+    /**
+     * @brief A submitted batch.
+     */
+    struct Job {
+        std::vector<Image>           images{};  /**< Images of the batch */
+        std::promise<std::vector<T>> promise{}; /**< Receives the results */
+    };
+
+    /**
+     * @brief Queue and statistics of one device.
+     */
+    struct Device {
+        DeviceLoad                       load{};  /**< Load of the device */
+        std::deque<std::unique_ptr<Job>> queue{}; /**< Batches waiting for the device */
+    };
+
+    /**
+     * @brief A model instance and the device it serves.
+     */
+    struct Instance {
+        std::unique_ptr<BaseTemplate<T>> model{};  /**< Model instance */
+        int                              device{}; /**< Index of the device in devices */
+    };
+
+    /**
+     * @brief Weight of the last measurement in the latency average of a device.
+     */
+    static constexpr double kLatencyWeight = 0.25;
+
+    /**
+     * @brief Devices served by the pool, in the order they were listed.
+     */
+    std::vector<Device> devices{};
+
+    /**
+     * @brief Model instances, each served by the thread of the same index.
+     */
+    std::vector<Instance> instances{};
+
+    /**
+     * @brief Serving threads.
+     */
+    std::vector<std::thread> workers{};
+
+    /**
+     * @brief Largest batch accepted.
+     */
+    int maxBatch{0};
+
+    /**
+     * @brief Whether the serving threads make their device current.
+     */
+    bool setDevice{false};
+
+    /**
+     * @brief Set when the pool is destroyed, the threads exit once the queues are empty.
+     */
+    bool stopping{false};
+
+    /**
+     * @brief Guards the queues and the loads.
+     */
+    mutable std::mutex mutex{};
+
+    /**
+     * @brief Wakes the serving threads when a batch is submitted or the pool stops.
+     */
+    std::condition_variable available{};
+
+    /**
+     * @brief Creates the models and starts the serving threads.
+     *
+     * @param factory Creates each model instance.
+     * @param deviceIds Device indices.
+     * @param count Number of model instances per device.
+     */
+    void start(const Factory& factory, const std::vector<int>& deviceIds, int count);
+
+    /**
+     * @brief Main loop of the thread serving an instance.
+     *
+     * @param index Index of the instance.
+     */
+    void serve(int index);
+
+    /**
+     * @brief Takes the next batch for a device: the head of its queue, or a batch stolen from another device.
+     *
+     * @param device Index of the device.
+     * @return std::unique_ptr<Job> Batch to run, null when there is none worth running on the device.
+     */
+    std::unique_ptr<Job> take(int device);
+
+    /**
+     * @brief Gets the latency per image expected on a device, from its measurements or those of the others.
+     *
+     * @param device Index of the device.
+     * @return double Expected latency per image, in milliseconds.
+     */
+    double latency(int device) const;
+
+    /**
+     * @brief Gets the time a device is expected to need before it completes some more images.
+     *
+     * @param device Index of the device.
+     * @param images Number of images added after those already queued and running.
+     * @return double Expected time, in milliseconds.
+     */
+    double expectedTime(int device, int images) const;
+};
+
+// Explicitly instantiate the template class
+template class DevicePool<DetResult>;
+template class DevicePool<OBBResult>;
+template class DevicePool<SegResult>;
+template class DevicePool<PoseResult>;
+
+// Use the template class to create concrete deployment classes
+typedef DevicePool<DetResult>  DevicePoolDet;
+typedef DevicePool<OBBResult>  DevicePoolOBB;
+typedef DevicePool<SegResult>  DevicePoolSeg;
+typedef DevicePool<PoseResult> DevicePoolPose;
+
+}  // namespace deploy
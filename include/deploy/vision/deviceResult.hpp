@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "deploy/core/macro.hpp"
+#include "deploy/vision/cudaWarp.hpp"
+
+namespace deploy {
+
+/**
+ * @brief View over the raw outputs of a batch, left where the engine wrote them for consumers running on the GPU.
+ *
+ * The buffers belong to one slot of the ring of output buffers of the model. They stay valid until the slot
+ * comes around again, that is for the next ring size - 1 calls of predictDevice, and the model waits for the
+ * slot's previous batch to complete before reusing it. Work queued on another stream must wait for ready first
+ * (see wait), and must be done with the buffers before the slot is reused.
+ *
+ * Only the first numDets[i] detections of image i are valid. Masks are not mapped: they cover the model input,
+ * letterbox included, and transforms[i].dw and dh give the padding to crop.
+ *
+ * The same view can describe host buffers (device is false), which is how mocked backends expose their outputs.
+ * cpuTransformDetections then maps them like the device kernel does.
+ */
+struct DEPLOYAPI DeviceDetections {
+    int                          batch             = 0;       /**< Number of images in the batch */
+    int                          maxDets           = 0;       /**< Number of detection slots per image */
+    int                          boxSize           = 0;       /**< Floats per box: left, top, right, bottom, then the angle of rotated boxes */
+    const int*                   numDets           = nullptr; /**< Number of valid detections of each image, [batch] */
+    float*                       boxes             = nullptr; /**< Boxes, [batch, maxDets, boxSize] */
+    const float*                 scores            = nullptr; /**< Scores, [batch, maxDets] */
+    const int*                   classes           = nullptr; /**< Class labels, [batch, maxDets] */
+    const uint8_t*               masks             = nullptr; /**< Segmentation masks, [batch, maxDets, maskHeight, maskWidth], null for other tasks */
+    int                          maskHeight        = 0;       /**< Height of the masks */
+    int                          maskWidth         = 0;       /**< Width of the masks */
+    float*                       kpts              = nullptr; /**< Pose key points, [batch, maxDets, nkpt, ndim], null for other tasks */
+    int                          nkpt              = 0;       /**< Number of key points per detection */
+    int                          ndim              = 0;       /**< Values per key point: x, y, then the confidence when 3 */
+    std::vector<TransformMatrix> transforms{};                /**< Letterbox transform of each image */
+    bool                         sourceCoordinates = false;   /**< Whether the boxes and key points are in source image coordinates */
+    bool                         device            = true;    /**< Whether the pointers are device pointers */
+    cudaEvent_t                  ready             = nullptr; /**< Recorded once the buffers are written, null when they already are */
+    int                          slot              = -1;      /**< Ring slot owning the buffers */
+
+    /**
+     * @brief Makes the work queued next on a stream wait until the buffers are written.
+     *
+     * @param stream CUDA stream of the consumer.
+     * @return cudaError_t Result of cudaStreamWaitEvent, or cudaSuccess when there is nothing to wait for.
+     */
+    cudaError_t wait(cudaStream_t stream) const {
+        return ready != nullptr ? cudaStreamWaitEvent(stream, ready, 0) : cudaSuccess;
+    }
+};
+
+}  // namespace deploy
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "deploy/core/macro.hpp"
+#include "deploy/core/tensor.hpp"
+#include "deploy/vision/cudaWarp.hpp"
+#include "deploy/vision/inference.hpp"
+#include "deploy/vision/result.hpp"
+
+namespace deploy {
+
+/**
+ * @brief Runs several models on the same frames, sharing the preprocessing between them.
+ *
+ * Each model would otherwise upload and letterbox every frame itself. The executor uploads each frame once,
+ * letterboxes it once per distinct model input size, and hands the result to every model of that size through
+ * enqueueInput. The models then run concurrently, each on its own stream, after an event join on their input.
+ *
+ * The models must support shared inputs (supportsSharedInput), which rules out DeployCGTemplate: its CUDA graph
+ * captures its own preprocessing, so it cannot read a letterbox written by the executor. They must be on the
+ * device of the executor and stay alive while added. They are driven by run only: do not call them directly in
+ * between.
+ */
+class DEPLOYAPI MultiModelExecutor {
+public:
+    /**
+     * @brief Constructor to initialize MultiModelExecutor with an optional CUDA memory flag and device index.
+     *
+     * @param cudaMem (Optional) Flag indicating whether input data resides in GPU memory (true) or CPU memory (false). Defaults to false.
+     * @param device (Optional) Device index of the models. Defaults to 0.
+     */
+    explicit MultiModelExecutor(bool cudaMem = false, int device = 0);
+
+    /**
+     * @brief Destructor for releasing the streams, events and buffers of the executor.
+     */
+    ~MultiModelExecutor();
+
+    MultiModelExecutor(const MultiModelExecutor&)            = delete;
+    MultiModelExecutor& operator=(const MultiModelExecutor&) = delete;
+
+    /**
+     * @brief Adds a model, run on every batch from then on.
+     *
+     * @param model Model to run, kept by reference.
+     * @param results Vector receiving the results of the model at each run, kept by reference. It is left empty
+     * if the inference of the model fails.
+     * @throw std::invalid_argument If the model does not support shared inputs (CUDA graph models).
+     */
+    template <typename T>
+    void add(BaseTemplate<T>& model, std::vector<T>& results) {
+        if (!model.supportsSharedInput()) {
+            throw std::invalid_argument("MultiModelExecutor needs models accepting preprocessed inputs, CUDA graph models preprocess inside their graph.");
+        }
+        addModel(
+            model.inputWidth(), model.inputHeight(), model.batch,
+            [&model, &results](int count, const float* input, const std::vector<TransformMatrix>& transforms, cudaStream_t stream) {
+                if (model.enqueueInput(count, input, transforms, stream)) return true;
+                results.clear();
+                return false;
+            },
+            [&model, &results]() { return model.wait(results); });
+    }
+
+    /**
+     * @brief Runs every model on a batch of images and post-processes their results.
+     *
+     * @param images Vector containing batch of input images, at most the smallest batch size of the models.
+     * @return bool True if every model succeeded.
+     */
+    bool run(const std::vector<Image>& images);
+
+    /**
+     * @brief Gets the number of distinct input sizes, that is the number of letterboxes per image and run.
+     *
+     * @return int Number of distinct input sizes among the models.
+     */
+    int geometries() const {
+        return static_cast<int>(inputs.size());
+    }
+
+private:
+    /**
+     * @brief Letterboxed batch shared by the models of one input size.
+     */
+    struct Input {
+        int                          width{0};       /**< Input width of the models */
+        int                          height{0};      /**< Input height of the models */
+        Tensor                       tensor{};       /**< Letterboxed images, float [batch, 3, height, width] */
+        std::vector<TransformMatrix> transforms{};   /**< Letterbox transform of each image */
+        cudaEvent_t                  ready{nullptr}; /**< Recorded once the letterboxes are written */
+    };
+
+    /**
+     * @brief Queues a batch of preprocessed images on a model, see BaseTemplate::enqueueInput.
+     */
+    using Enqueue = std::function<bool(int count, const float* input, const std::vector<TransformMatrix>& transforms, cudaStream_t stream)>;
+
+    /**
+     * @brief A model added to the executor, with its result type erased.
+     */
+    struct Model {
+        Enqueue               enqueue{};       /**< Queues a batch on the model */
+        std::function<bool()> wait{};          /**< Waits for and post-processes the batch */
+        int                   batch{0};        /**< Batch size of the model */
+        int                   input{0};        /**< Index of the shared input */
+        cudaStream_t          stream{nullptr}; /**< Stream running the model */
+    };
+
+    /**
+     * @brief Flag indicating whether the input image is in GPU memory (true) or CPU memory (false).
+     */
+    bool cudaMem{false};
+
+    /**
+     * @brief CUDA stream uploading and letterboxing the images.
+     */
+    cudaStream_t stream{nullptr};
+
+    /**
+     * @brief Staging buffers of the images uploaded from the host, one per image of the batch.
+     */
+    std::deque<Tensor> imageTensors{};
+
+    /**
+     * @brief Shared inputs, one per distinct input size. A deque keeps the tensors in place as it grows.
+     */
+    std::deque<Input> inputs{};
+
+    /**
+     * @brief Models run on every batch.
+     */
+    std::vector<Model> models{};
+
+    /**
+     * @brief Adds a model, sharing the input of the models of the same input size.
+     *
+     * @param width Input width of the model.
+     * @param height Input height of the model.
+     * @param batch Batch size of the model.
+     * @param enqueue Queues a batch on the model.
+     * @param wait Waits for and post-processes the batch.
+     */
+    void addModel(int width, int height, int batch, Enqueue enqueue, std::function<bool()> wait);
+};
+
+}  // namespace deploy
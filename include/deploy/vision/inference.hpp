@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -7,12 +8,27 @@
 
 #include "deploy/core/core.hpp"
 #include "deploy/core/macro.hpp"
+#include "deploy/core/profiler.hpp"
 #include "deploy/core/tensor.hpp"
+#include "deploy/utils/stats.hpp"
+#include "deploy/utils/threadpool.hpp"
 #include "deploy/vision/cudaWarp.hpp"
+#include "deploy/vision/decode.hpp"
+#include "deploy/vision/deviceResult.hpp"
 #include "deploy/vision/result.hpp"
 
 namespace deploy {
 
+/**
+ * @brief Loads a serialized engine and creates its execution context on a device.
+ *
+ * @param file The path to the model file.
+ * @param device (Optional) Device index the engine is deserialized on. Defaults to 0.
+ * @return std::shared_ptr<EngineContext> Engine and execution context, ready to construct a model from.
+ * @throw std::runtime_error If the file cannot be read or the engine cannot be deserialized.
+ */
+DEPLOYAPI std::shared_ptr<EngineContext> loadEngine(const std::string& file, int device = 0);
+
 /**
  * @brief BaseTemplate class, a template base class for YOLO series models (e.g., Det, OBB, Seg, etc.).
  *
@@ -40,6 +56,15 @@ public:
      */
     explicit BaseTemplate(const std::string& file, bool cudaMem = false, int device = 0);
 
+    /**
+     * @brief Constructor to initialize BaseTemplate with an engine loaded beforehand, for instance by loadEngine.
+     *
+     * @param engine Engine and execution context, owned by the model from then on.
+     * @param cudaMem (Optional) Flag indicating whether input data resides in GPU memory (true) or CPU memory (false). Defaults to false.
+     * @param device (Optional) Device index the engine was loaded on. Defaults to 0.
+     */
+    explicit BaseTemplate(std::shared_ptr<EngineContext> engine, bool cudaMem = false, int device = 0);
+
     /**
      * @brief Destructor for releasing allocated resources used by the BaseTemplate class.
      */
@@ -61,12 +86,208 @@ public:
      */
     virtual std::vector<T> predict(const std::vector<Image>& images) = 0;
 
+    /**
+     * @brief Performs inference on a batch of input images, writing the results into an existing vector.
+     *
+     * The vector is resized to the number of images, and each result is filled in place, reusing the storage
+     * left by the previous call. A caller that passes the same vector at every frame stops allocating once
+     * the results have held as many detections.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param results Vector receiving one result per image. It is left empty if the inference fails.
+     * @return bool True if the inference succeeded.
+     */
+    virtual bool predictInto(const std::vector<Image>& images, std::vector<T>& results) = 0;
+
+    /**
+     * @brief Performs inference on a batch of input images and leaves the outputs on the device.
+     *
+     * Nothing is copied back to the host and the call does not wait for the inference: the view points to the
+     * output buffers of a ring slot, and its ready event is recorded once they are written. See DeviceDetections
+     * for how long the buffers stay valid.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param detections View receiving the device outputs of the batch. It is reset if the inference fails.
+     * @param mapToSource (Optional) Whether to map the boxes and key points back to the source images on the
+     * device. Defaults to true.
+     * @return bool True if the inference was enqueued.
+     * @throw std::runtime_error If the model does not support device-resident results (CUDA graph models).
+     */
+    virtual bool predictDevice(const std::vector<Image>& images, DeviceDetections& detections, bool mapToSource = true);
+
+    /**
+     * @brief Performs inference on a batch of input images, ordered after the work already queued on a stream.
+     *
+     * Equivalent to enqueue followed by wait: the host only waits for the batch itself, not for the rest of the
+     * work of the stream.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param stream CUDA stream of the caller.
+     * @return std::vector<T> Vector of inference results for each image in the batch, empty on failure.
+     */
+    std::vector<T> predict(const std::vector<Image>& images, cudaStream_t stream);
+
+    /**
+     * @brief Queues the inference of a batch on a stream of the caller and returns without waiting for it.
+     *
+     * Preprocessing starts after the work already queued on the stream, the outputs are copied back to the host
+     * on it, and the completion is recorded as an event. Only one batch can be in flight: call wait before the
+     * next enqueue or predict.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param stream CUDA stream of the caller.
+     * @param onComplete (Optional) Called from a CUDA driver thread once the outputs are on the host, before
+     * wait returns. It must not call CUDA functions, and is typically used to wake up the thread that calls wait.
+     * @return bool True if the batch was queued.
+     * @throw std::runtime_error If the model does not support asynchronous inference.
+     */
+    virtual bool enqueue(const std::vector<Image>& images, cudaStream_t stream, std::function<void()> onComplete = nullptr);
+
+    /**
+     * @brief Queues the inference of a batch preprocessed by the caller on a stream, and returns without waiting
+     * for it.
+     *
+     * The input holds the images letterboxed to the input size of the model, so that models with the same
+     * input size can share the preprocessing of a frame. The engine reads it in place: it must be ready in the
+     * order of the stream and stay unchanged until the batch completes. Complete the batch with wait.
+     *
+     * @param count Number of images in the batch.
+     * @param input Preprocessed images on the device, float [count, 3, inputHeight(), inputWidth()].
+     * @param transforms Letterbox transform of each image, used to map the detections back to it.
+     * @param stream CUDA stream of the caller.
+     * @param onComplete (Optional) Called from a CUDA driver thread once the outputs are on the host.
+     * @return bool True if the batch was queued.
+     * @throw std::runtime_error If the model does not support external inputs (CUDA graph models, whose
+     * preprocessing is part of the graph).
+     */
+    virtual bool enqueueInput(int count, const float* input, const std::vector<TransformMatrix>& transforms, cudaStream_t stream, std::function<void()> onComplete = nullptr);
+
+    /**
+     * @brief Checks whether the model accepts batches preprocessed by the caller through enqueueInput.
+     *
+     * @return bool True if enqueueInput is implemented, false for models that preprocess inside their engine call
+     * (CUDA graph models).
+     */
+    virtual bool supportsSharedInput() const {
+        return false;
+    }
+
+    /**
+     * @brief Gets the width of the model input, the width images are letterboxed to.
+     *
+     * @return int Input width in pixels.
+     */
+    int inputWidth() const {
+        return width;
+    }
+
+    /**
+     * @brief Gets the height of the model input, the height images are letterboxed to.
+     *
+     * @return int Input height in pixels.
+     */
+    int inputHeight() const {
+        return height;
+    }
+
+    /**
+     * @brief Waits for the batch queued by enqueue and post-processes it.
+     *
+     * @param results Vector receiving one result per image, reusing its storage.
+     * @return bool True if a batch was in flight.
+     */
+    bool wait(std::vector<T>& results);
+
+    /**
+     * @brief Gets the latency distribution of each pipeline stage recorded so far.
+     *
+     * Device stages are resolved lazily from CUDA events, so the most recent batch may not be included yet.
+     *
+     * @return std::vector<StageStats> Latency summaries of the stages that have samples.
+     */
+    std::vector<StageStats> stats();
+
+    /**
+     * @brief Discards all recorded stage latencies.
+     */
+    void resetStats();
+
+    /**
+     * @brief Enables or disables the collection of stage latencies. Enabled by default.
+     *
+     * @param enabled True to collect stage latencies.
+     */
+    void setStatsEnabled(bool enabled);
+
+    /**
+     * @brief Enables or disables the emission of NVTX ranges for each pipeline stage. Disabled by default.
+     *
+     * @param enabled True to emit NVTX ranges.
+     */
+    void setNvtxEnabled(bool enabled);
+
+    /**
+     * @brief Attaches a layer profiler to the execution context, or detaches it when null.
+     *
+     * TensorRT reports per-layer execution times to the profiler after each inference, which adds
+     * a synchronization per layer; it should only be attached while profiling.
+     *
+     * @param profiler Shared pointer to the layer profiler, or nullptr to detach.
+     */
+    virtual void setProfiler(std::shared_ptr<LayerProfiler> profiler);
+
+    /**
+     * @brief Updates the NMS thresholds of an engine exported with runtime thresholds, without rebuilding it.
+     *
+     * A negative value keeps the threshold the engine was exported with. The number of boxes can only be
+     * lowered, since the engine outputs are sized for the exported value. The new values apply from the next
+     * inference on, including with CUDA graphs. The batch launched last keeps the thresholds it was launched
+     * with, and a batch queued by enqueue must be waited for first.
+     *
+     * Engines outputting the raw head are decoded on the host, so the number of boxes is not bounded.
+     *
+     * @param scoreThreshold Score threshold.
+     * @param iouThreshold IoU threshold.
+     * @param maxBoxes Maximum number of detections per image.
+     * @param classScoreThresholds (Optional) Score threshold of each class, applied when higher than scoreThreshold.
+     * Empty to disable, otherwise one value per class.
+     * @throw std::runtime_error If the engine has neither a thresholds input nor a raw head output, the number
+     * of classes does not match, or a batch queued by enqueue has not been waited for.
+     */
+    void setThresholds(float scoreThreshold, float iouThreshold, int maxBoxes, const std::vector<float>& classScoreThresholds = {});
+
+    /**
+     * @brief Post-processes the images of a batch on an internal thread pool instead of the calling thread.
+     *
+     * The images are independent, so each one is decoded by the first free thread and the results keep the
+     * order of the batch. Replaces any executor set with setPostProcessExecutor.
+     *
+     * @param threads Total number of threads, counting the calling thread. 1 or less post-processes serially.
+     */
+    void setPostProcessThreads(int threads);
+
+    /**
+     * @brief Post-processes the images of a batch with an executor supplied by the caller.
+     *
+     * The executor must run every task and return once all of them have completed. It is called from predict,
+     * and the tasks only read the outputs of the current batch, so it can be shared between models.
+     *
+     * @param executor Parallel loop running the per-image tasks, or an empty function to post-process serially.
+     */
+    void setPostProcessExecutor(ParallelFor executor);
+
     /**
      * @brief Sets the batch size for model inference.
      */
     int batch{};
 
 protected:
+    /**
+     * @brief Default constructor for derived classes that set up the tensors themselves without an engine,
+     * such as benchmark fixtures and mocks.
+     */
+    BaseTemplate() = default;
+
     /**
      * @brief Flag indicating whether the input image is in GPU memory (true) or CPU memory (false).
      */
@@ -92,6 +313,13 @@ protected:
      */
     std::vector<TensorInfo> tensorInfos{};
 
+    /**
+     * @brief Runtime NMS thresholds input, only present in engines exported with runtime thresholds.
+     *
+     * It is kept out of tensorInfos, whose inputs are all batched image tensors.
+     */
+    std::shared_ptr<TensorInfo> thresholdsInfo{};
+
     /**
      * @brief CUDA streams to handle input data transfer asynchronously.
      */
@@ -102,6 +330,47 @@ protected:
      */
     cudaStream_t inferStream{nullptr};
 
+    /**
+     * @brief Per-stage latency collector of the inference pipeline.
+     */
+    InferenceStats inferStats{};
+
+    /**
+     * @brief Layer profiler attached to the execution context, kept alive while attached.
+     */
+    std::shared_ptr<LayerProfiler> layerProfiler{};
+
+    /**
+     * @brief CUDA event recorded after the outputs of the last batch are copied back to the host.
+     */
+    cudaEvent_t doneEvent{nullptr};
+
+    /**
+     * @brief Number of images of the batch queued by enqueue and not waited for yet, 0 when none.
+     */
+    int pendingImages{0};
+
+    /**
+     * @brief Completion callback of the batch in flight, kept alive until the stream has run it.
+     */
+    std::function<void()> completion{};
+
+    /**
+     * @brief Parallel loop running the per-image post-processing of a batch, serial when empty.
+     */
+    ParallelFor postProcessExecutor{};
+
+    /**
+     * @brief Layout and NMS settings of the raw head output, only present in engines exported without the NMS
+     * plugin, whose single output is then decoded on the host.
+     */
+    std::shared_ptr<RawHead> rawHead{};
+
+    /**
+     * @brief Decode buffers of each image of the batch, so that images can be post-processed in parallel.
+     */
+    std::vector<RawDecodeWorkspace> decodeWorkspaces{};
+
     /**
      * @brief Allocates required resources for inference execution.
      */
@@ -117,13 +386,70 @@ protected:
      */
     virtual void setupTensors() = 0;
 
+    /**
+     * @brief Selects the host decode when tensorInfos holds a single raw head output, [batch, channels, anchors].
+     *
+     * Called at the end of setupTensors. Engines with the NMS plugin outputs are left unchanged. The images of a
+     * batch are decoded serially unless setPostProcessThreads or setPostProcessExecutor chose otherwise.
+     *
+     * @throw std::runtime_error If the raw head layout or the task is not supported.
+     */
+    void setupRawHead();
+
+    /**
+     * @brief Decodes the raw head output of an image into boxes in source image coordinates.
+     *
+     * @param idx Index of the image in the batch.
+     * @param boxes Vector receiving the boxes.
+     * @param scores Vector receiving the scores.
+     * @param classes Vector receiving the class labels.
+     * @param clip Whether to clip the boxes to the source image.
+     */
+    template <typename B>
+    void decodeRawOutput(int idx, std::vector<B>& boxes, std::vector<float>& scores, std::vector<int>& classes, bool clip);
+
     /**
      * @brief Processes the inference results for a specific index.
      *
+     * The result is overwritten in place, and the storage of its vectors is reused.
+     *
      * @param idx Index corresponding to the result to be post-processed.
-     * @return T Processed result of the specified inference output.
+     * @param result Result receiving the processed output of the specified index.
      */
-    virtual T postProcess(int idx);
+    virtual void postProcess(int idx, T& result);
+
+    /**
+     * @brief Post-processes the first count images of the batch into results, through the post-processing
+     * executor when one is set.
+     *
+     * @param count Number of images in the batch.
+     * @param results Vector receiving one result per image, resized to count.
+     */
+    void postProcessBatch(int count, std::vector<T>& results);
+
+    /**
+     * @brief Describes the output buffers of a batch as a DeviceDetections view.
+     *
+     * Fills the shapes, the transforms of the first count images and the pointers, leaving the location, the
+     * ready event and the slot to the caller.
+     *
+     * @param count Number of images in the batch.
+     * @param buffers Buffer of each entry of tensorInfos (the entry of the input is ignored).
+     * @param detections View receiving the description.
+     */
+    void describeOutputs(int count, const std::vector<void*>& buffers, DeviceDetections& detections) const;
+
+    /**
+     * @brief Marks a batch as in flight once its outputs are queued for download on a stream.
+     *
+     * Queues the completion callback, if any, then records doneEvent after it, so that wait also covers the
+     * callback.
+     *
+     * @param count Number of images in the batch.
+     * @param stream CUDA stream the batch was queued on.
+     * @param onComplete Completion callback, may be empty.
+     */
+    void finishEnqueue(int count, cudaStream_t stream, std::function<void()> onComplete);
 };
 
 /**
@@ -154,6 +480,15 @@ public:
      */
     explicit DeployTemplate(const std::string& file, bool cudaMem = false, int device = 0);
 
+    /**
+     * @brief Constructor to initialize DeployTemplate with an engine loaded beforehand, for instance by loadEngine.
+     *
+     * @param engine Engine and execution context, owned by the model from then on.
+     * @param cudaMem (Optional) Flag indicating whether input data resides in GPU memory (true) or CPU memory (false). Defaults to false.
+     * @param device (Optional) Device index the engine was loaded on. Defaults to 0.
+     */
+    explicit DeployTemplate(std::shared_ptr<EngineContext> engine, bool cudaMem = false, int device = 0);
+
     /**
      * @brief Destructor for releasing allocated resources used by the DeployTemplate class.
      */
@@ -175,17 +510,163 @@ public:
      */
     std::vector<T> predict(const std::vector<Image>& images) override;
 
+    /**
+     * @brief Performs inference on a batch of input images, writing the results into an existing vector.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param results Vector receiving one result per image, reusing its storage.
+     * @return bool True if the inference succeeded.
+     */
+    bool predictInto(const std::vector<Image>& images, std::vector<T>& results) override;
+
+    /**
+     * @brief Performs inference on a batch of input images and leaves the outputs on the device.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param detections View receiving the device outputs of the batch.
+     * @param mapToSource (Optional) Whether to map the boxes and key points back to the source images. Defaults to true.
+     * @return bool True if the inference was enqueued.
+     */
+    bool predictDevice(const std::vector<Image>& images, DeviceDetections& detections, bool mapToSource = true) override;
+
+    /**
+     * @brief Queues the inference of a batch on a stream of the caller and returns without waiting for it.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param stream CUDA stream of the caller.
+     * @param onComplete (Optional) Called from a CUDA driver thread once the outputs are on the host.
+     * @return bool True if the batch was queued.
+     */
+    bool enqueue(const std::vector<Image>& images, cudaStream_t stream, std::function<void()> onComplete = nullptr) override;
+
+    /**
+     * @brief Queues the inference of a batch preprocessed by the caller on a stream, and returns without waiting for it.
+     *
+     * @param count Number of images in the batch.
+     * @param input Preprocessed images on the device, float [count, 3, inputHeight(), inputWidth()].
+     * @param transforms Letterbox transform of each image.
+     * @param stream CUDA stream of the caller.
+     * @param onComplete (Optional) Called from a CUDA driver thread once the outputs are on the host.
+     * @return bool True if the batch was queued.
+     */
+    bool enqueueInput(int count, const float* input, const std::vector<TransformMatrix>& transforms, cudaStream_t stream, std::function<void()> onComplete = nullptr) override;
+
+    /**
+     * @brief Checks whether the model accepts batches preprocessed by the caller, always true.
+     *
+     * @return bool True.
+     */
+    bool supportsSharedInput() const override {
+        return true;
+    }
+
+    using BaseTemplate<T>::predict;
+
+    /**
+     * @brief Sets the number of output buffer sets cycled through by predictDevice. Defaults to 2.
+     *
+     * Waits for the batches still using the current buffers, then frees them.
+     *
+     * @param size Number of slots, at least 1.
+     */
+    void setDeviceRingSize(int size);
+
+    /**
+     * @brief Enables or disables rectangular inputs on engines with a dynamic input height and width.
+     *
+     * Each batch is letterboxed to the smallest multiple of the stride that holds its images at the scale of the
+     * full input size, instead of the full input size itself, so a 16:9 frame on a 640x640 engine runs at
+     * 640x384. The input size is clamped to the optimization profile selected for the batch. Enabled by default
+     * on such engines, no effect on the others.
+     *
+     * @param enabled Whether batches use rectangular inputs.
+     * @param stride (Optional) Multiple of the input height and width, the largest stride of the model. Defaults to 32.
+     */
+    void setRectInference(bool enabled, int stride = 32);
+
 private:
+    /**
+     * @brief Output buffers of one batch handed out by predictDevice.
+     */
+    struct DeviceSlot {
+        std::vector<Tensor> outputs{};      /**< Device buffer of each entry of tensorInfos, unused for the input */
+        Tensor              transforms{};   /**< Transform of each image, staged in pinned memory for the mapping kernel */
+        cudaEvent_t         ready{nullptr}; /**< Recorded after the last write of the batch to the buffers */
+    };
+
+    /**
+     * @brief Input shapes accepted by an optimization profile of a dynamic engine.
+     */
+    struct ShapeRange {
+        nvinfer1::Dims min{}; /**< Smallest input shape, kMIN */
+        nvinfer1::Dims max{}; /**< Largest input shape, kMAX */
+    };
+
     /**
      * @brief Flag indicating whether the model is dynamic.
      */
     bool dynamic{false};
 
+    /**
+     * @brief Flag indicating whether the input height and width of the model are dynamic.
+     */
+    bool dynamicSize{false};
+
+    /**
+     * @brief Whether batches are letterboxed to rectangular inputs, see setRectInference.
+     */
+    bool rect{false};
+
+    /**
+     * @brief Multiple of the rectangular input height and width.
+     */
+    int rectStride{32};
+
+    /**
+     * @brief Input shapes accepted by each optimization profile of a dynamic engine.
+     */
+    std::vector<ShapeRange> profiles{};
+
+    /**
+     * @brief Optimization profile currently selected in the execution context.
+     */
+    int profile{0};
+
+    /**
+     * @brief Width and height the images of the current batch are letterboxed to.
+     */
+    int batchWidth{0}, batchHeight{0};
+
+    /**
+     * @brief Ring of output buffers of predictDevice, allocated on first use.
+     */
+    std::vector<DeviceSlot> deviceSlots{};
+
+    /**
+     * @brief Number of slots in the ring of output buffers.
+     */
+    int deviceRingSize{2};
+
+    /**
+     * @brief Slot used by the next call of predictDevice.
+     */
+    int nextSlot{0};
+
     /**
      * @brief Vector of input tensors for holding preprocessed image data.
      */
     std::vector<Tensor> imageTensors{};
 
+    /**
+     * @brief CUDA event recorded on the stream of a batch before the per-image preprocessing forks from it.
+     */
+    cudaEvent_t forkEvent{nullptr};
+
+    /**
+     * @brief CUDA events recorded after the preprocessing of each image, joined by the stream of the batch.
+     */
+    std::vector<cudaEvent_t> inputEvents{};
+
     /**
      * @brief Allocates required resources for inference execution.
      */
@@ -209,6 +690,63 @@ private:
      * @param stream CUDA stream used to perform asynchronous operations for preprocessing.
      */
     void preProcess(int idx, const Image& image, cudaStream_t stream);
+
+    /**
+     * @brief Preprocesses a batch and enqueues the engine on a stream.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param slot Ring slot receiving the outputs, or nullptr to use the outputs of tensorInfos.
+     * @param stream CUDA stream running the inference, the per-image preprocessing joins it through events.
+     * @return bool True if the engine was enqueued.
+     */
+    bool launch(const std::vector<Image>& images, DeviceSlot* slot, cudaStream_t stream);
+
+    /**
+     * @brief Selects the optimization profile of a batch, and raises its input size to the minimum of the profile.
+     *
+     * Among the profiles accepting the batch, the one with the smallest maximum input size is selected, its
+     * kernels being tuned closest to the batch. The switch is ordered on the stream.
+     *
+     * @param count Number of images in the batch.
+     * @param height Input height of the batch, raised to the minimum of the selected profile.
+     * @param width Input width of the batch, raised to the minimum of the selected profile.
+     * @param stream CUDA stream running the inference.
+     * @return bool True if a profile accepts the batch.
+     */
+    bool selectProfile(int count, int& height, int& width, cudaStream_t stream);
+
+    /**
+     * @brief Binds the tensors of the engine for a batch, and reads back the output shapes of dynamic engines.
+     *
+     * @param count Number of images in the batch.
+     * @param height Input height of the batch.
+     * @param width Input width of the batch.
+     * @param slot Ring slot receiving the outputs, or nullptr to use the outputs of tensorInfos.
+     * @param input Preprocessed input of the batch, or nullptr to use the input of tensorInfos.
+     */
+    void bindTensors(int count, int height, int width, DeviceSlot* slot, const float* input);
+
+    /**
+     * @brief Enqueues the engine on a stream once its tensors are bound.
+     *
+     * @param stream CUDA stream running the inference.
+     * @return bool True if the engine was enqueued.
+     */
+    bool execute(cudaStream_t stream);
+
+    /**
+     * @brief Queues the copy of the outputs back to the host after the engine, then marks the batch as in flight.
+     *
+     * @param count Number of images in the batch.
+     * @param stream CUDA stream running the inference.
+     * @param onComplete Completion callback, may be empty.
+     */
+    void download(int count, cudaStream_t stream, std::function<void()> onComplete);
+
+    /**
+     * @brief Waits for the batches still using the ring of output buffers, then frees it.
+     */
+    void releaseSlots();
 };
 
 /**
@@ -239,6 +777,15 @@ public:
      */
     explicit DeployCGTemplate(const std::string& file, bool cudaMem = false, int device = 0);
 
+    /**
+     * @brief Constructor to initialize DeployCGTemplate with an engine loaded beforehand, for instance by loadEngine.
+     *
+     * @param engine Engine and execution context, owned by the model from then on.
+     * @param cudaMem (Optional) Flag indicating whether input data resides in GPU memory (true) or CPU memory (false). Defaults to false.
+     * @param device (Optional) Device index the engine was loaded on. Defaults to 0.
+     */
+    explicit DeployCGTemplate(std::shared_ptr<EngineContext> engine, bool cudaMem = false, int device = 0);
+
     /**
      * @brief Destructor for releasing allocated resources used by the DeployCGTemplate class.
      */
@@ -260,6 +807,35 @@ public:
      */
     std::vector<T> predict(const std::vector<Image>& images) override;
 
+    /**
+     * @brief Performs inference on a batch of input images, writing the results into an existing vector.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param results Vector receiving one result per image, reusing its storage.
+     * @return bool True if the inference succeeded.
+     */
+    bool predictInto(const std::vector<Image>& images, std::vector<T>& results) override;
+
+    /**
+     * @brief Queues the CUDA graph of a batch on a stream of the caller and returns without waiting for it.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param stream CUDA stream of the caller.
+     * @param onComplete (Optional) Called from a CUDA driver thread once the outputs are on the host.
+     * @return bool True if the batch was queued.
+     */
+    bool enqueue(const std::vector<Image>& images, cudaStream_t stream, std::function<void()> onComplete = nullptr) override;
+
+    using BaseTemplate<T>::predict;
+
+    /**
+     * @brief Layer profiling is not supported, TensorRT cannot report layer times from a captured CUDA graph.
+     *
+     * @param profiler Shared pointer to the layer profiler.
+     * @throw std::runtime_error Always, unless the profiler is null.
+     */
+    void setProfiler(std::shared_ptr<LayerProfiler> profiler) override;
+
 private:
     /**
      * @brief Number of elements in the input image.
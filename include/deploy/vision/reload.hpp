@@ -0,0 +1,205 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "deploy/core/core.hpp"
+#include "deploy/core/macro.hpp"
+#include "deploy/vision/inference.hpp"
+#include "deploy/vision/result.hpp"
+
+namespace deploy {
+
+/**
+ * @brief ReloadableTemplate class, serves a YOLO series model whose engine can be replaced without stopping.
+ *
+ * The engine of a model is fixed at construction, so updating it used to mean destroying the model and building
+ * a new one, with no inference possible during the deserialization, the allocations and the CUDA graph capture.
+ * reload builds the new model on a background thread while the current one keeps serving, checks up front that
+ * the new engine has the same inputs and outputs, then switches the calls made from then on to it. The previous
+ * model is destroyed once the calls already running on it have returned, so no request is dropped.
+ *
+ * Calls are thread-safe: calls running on the same model are serialized, and a call never mixes two models.
+ * Both models are in device memory during a reload.
+ */
+template <typename T>
+class DEPLOYAPI ReloadableTemplate {
+public:
+    // Use static_assert to ensure that T is either DetResult, OBBResult, SegResult, or PoseResult..
+    static_assert(
+        std::is_same<T, DetResult>::value ||
+            std::is_same<T, OBBResult>::value ||
+            std::is_same<T, SegResult>::value ||
+            std::is_same<T, PoseResult>::value,
+        "T must be either DetResult, OBBResult, SegResult, or PoseResult.");
+
+    /**
+     * @brief Constructor to initialize ReloadableTemplate with a model file, the kind of model, optional CUDA memory flag, and device index.
+     *
+     * @param file The path to the model file.
+     * @param cudaGraph (Optional) Whether to build DeployCGTemplate models (true) or DeployTemplate models (false). Defaults to false.
+     * @param cudaMem (Optional) Flag indicating whether input data resides in GPU memory (true) or CPU memory (false). Defaults to false.
+     * @param device (Optional) Device index for the inference. Defaults to 0.
+     */
+    explicit ReloadableTemplate(const std::string& file, bool cudaGraph = false, bool cudaMem = false, int device = 0);
+
+    /**
+     * @brief Waits for the reload in progress, if any, then releases the model.
+     */
+    ~ReloadableTemplate();
+
+    ReloadableTemplate(const ReloadableTemplate&)            = delete;
+    ReloadableTemplate& operator=(const ReloadableTemplate&) = delete;
+
+    /**
+     * @brief Performs inference on a single input image with the current model.
+     *
+     * @param image Input image for inference.
+     * @return T Result of inference for the single image.
+     */
+    T predict(const Image& image);
+
+    /**
+     * @brief Performs inference on a batch of input images with the current model.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @return std::vector<T> Vector of inference results for each image in the batch.
+     */
+    std::vector<T> predict(const std::vector<Image>& images);
+
+    /**
+     * @brief Performs inference on a batch of input images with the current model, writing the results into an
+     * existing vector.
+     *
+     * @param images Vector containing batch of input images for inference.
+     * @param results Vector receiving one result per image, reusing its storage.
+     * @return bool True if the inference succeeded.
+     */
+    bool predictInto(const std::vector<Image>& images, std::vector<T>& results);
+
+    /**
+     * @brief Applies settings to the current model, and to every model built by later reloads.
+     *
+     * Settings such as setThresholds or setPostProcessThreads belong to a model, so they are recorded and
+     * replayed in order on each new model before it starts serving.
+     *
+     * @param setting Function applying the settings, called with no inference running on the model.
+     */
+    void configure(std::function<void(BaseTemplate<T>&)> setting);
+
+    /**
+     * @brief Replaces the engine in the background, without interrupting the calls being served.
+     *
+     * The new engine is deserialized and compared with the current one first: the number, names, direction,
+     * data type and shape of the inputs and outputs must match, and so must the min, opt and max shapes of each
+     * optimization profile. The model is then built, including its CUDA graph,
+     * the recorded settings are applied, and new calls switch to it. A reload started while another one is in
+     * progress waits for it first.
+     *
+     * @param file The path to the new model file.
+     * @return std::future<void> Ready once the new model serves, or holding the error if the engine cannot be
+     * loaded or is not compatible, in which case the current model keeps serving.
+     */
+    std::future<void> reload(const std::string& file);
+
+    /**
+     * @brief Gets the path of the model file currently serving.
+     *
+     * @return std::string Path given to the constructor or to the last successful reload.
+     */
+    std::string file() const;
+
+    /**
+     * @brief Gets the number of images processed per batch by the current model.
+     *
+     * @return int Batch size of the model.
+     */
+    int batch() const;
+
+private:
+    /**
+     * @brief A model and what is needed to serve and replace it.
+     */
+    struct Serving {
+        std::shared_ptr<EngineContext>   engine{}; /**< Engine of the model, compared with the engine of a reload */
+        std::unique_ptr<BaseTemplate<T>> model{};  /**< Model answering the calls */
+        std::string                      file{};   /**< Path of the model file */
+        std::mutex                       mutex{};  /**< Held while a call or a setting runs on the model */
+    };
+
+    /**
+     * @brief Flag indicating whether the models use CUDA graphs.
+     */
+    bool cudaGraph{false};
+
+    /**
+     * @brief Flag indicating whether the input image is in GPU memory (true) or CPU memory (false).
+     */
+    bool cudaMem{false};
+
+    /**
+     * @brief Device index of the models.
+     */
+    int device{0};
+
+    /**
+     * @brief Model receiving the new calls.
+     */
+    std::shared_ptr<Serving> current{};
+
+    /**
+     * @brief Guards current and settings.
+     */
+    mutable std::mutex currentMutex{};
+
+    /**
+     * @brief Settings recorded by configure, replayed on each new model.
+     */
+    std::vector<std::function<void(BaseTemplate<T>&)>> settings{};
+
+    /**
+     * @brief Thread building the model of the last reload.
+     */
+    std::thread reloader{};
+
+    /**
+     * @brief Serializes the reloads.
+     */
+    std::mutex reloadMutex{};
+
+    /**
+     * @brief Builds the model of an engine, without the recorded settings.
+     *
+     * @param engine Engine of the model.
+     * @param file The path to the model file.
+     * @return std::shared_ptr<Serving> Model, not serving yet.
+     */
+    std::shared_ptr<Serving> build(std::shared_ptr<EngineContext> engine, const std::string& file);
+
+    /**
+     * @brief Gets the model receiving the new calls.
+     *
+     * @return std::shared_ptr<Serving> Current model, kept alive by the caller until its call returns.
+     */
+    std::shared_ptr<Serving> acquire() const;
+};
+
+// Explicitly instantiate the template class
+template class ReloadableTemplate<DetResult>;
+template class ReloadableTemplate<OBBResult>;
+template class ReloadableTemplate<SegResult>;
+template class ReloadableTemplate<PoseResult>;
+
+// Use the template class to create concrete deployment classes
+typedef ReloadableTemplate<DetResult>  ReloadableDet;
+typedef ReloadableTemplate<OBBResult>  ReloadableOBB;
+typedef ReloadableTemplate<SegResult>  ReloadableSeg;
+typedef ReloadableTemplate<PoseResult> ReloadablePose;
+
+}  // namespace deploy
@@ -167,6 +167,10 @@ struct DEPLOYAPI RotatedBox : public Box {
 
 /**
  * @brief Represents the result of object detection.
+ *
+ * Results are cheap to move. When predictInto fills a result again, it resizes the vectors in place instead of
+ * rebuilding them, so it stops allocating once the result has held as many detections (for segmentation and
+ * pose, the buffers of the masks and key points are reused as well).
  */
 struct DEPLOYAPI DetResult {
     int                num = 0;   /**< Number of detected objects */
@@ -174,20 +178,20 @@ struct DEPLOYAPI DetResult {
     std::vector<int>   classes{}; /**< Detected classes */
     std::vector<float> scores{};  /**< Detection scores */
 
+    DetResult()                                = default;
+    DetResult(const DetResult&)                = default;
+    DetResult(DetResult&&) noexcept            = default;
+    DetResult& operator=(const DetResult&)     = default;
+    DetResult& operator=(DetResult&&) noexcept = default;
+
     /**
-     * @brief Copy assignment operator.
-     *
-     * @param other The source DetResult to copy from.
-     * @return DetResult& Reference to the assigned DetResult.
+     * @brief Removes all detections, keeping the allocated storage.
      */
-    DetResult& operator=(const DetResult& other) {
-        if (this != &other) {
-            num     = other.num;
-            boxes   = other.boxes;
-            classes = other.classes;
-            scores  = other.scores;
-        }
-        return *this;
+    void clear() {
+        num = 0;
+        boxes.clear();
+        classes.clear();
+        scores.clear();
     }
 };
 
@@ -197,18 +201,18 @@ struct DEPLOYAPI DetResult {
 struct DEPLOYAPI OBBResult : public DetResult {
     std::vector<RotatedBox> boxes{}; /**< Detected oriented bounding boxes */
 
+    OBBResult()                                = default;
+    OBBResult(const OBBResult&)                = default;
+    OBBResult(OBBResult&&) noexcept            = default;
+    OBBResult& operator=(const OBBResult&)     = default;
+    OBBResult& operator=(OBBResult&&) noexcept = default;
+
     /**
-     * @brief Copy assignment operator.
-     *
-     * @param other The source OBBResult to copy from.
-     * @return OBBResult& Reference to the assigned OBBResult.
+     * @brief Removes all detections, keeping the allocated storage.
      */
-    OBBResult& operator=(const OBBResult& other) {
-        if (this != &other) {
-            DetResult::operator=(static_cast<const DetResult&>(other));
-            boxes = other.boxes;
-        }
-        return *this;
+    void clear() {
+        DetResult::clear();
+        boxes.clear();
     }
 };
 
@@ -218,35 +222,100 @@ struct DEPLOYAPI OBBResult : public DetResult {
 struct DEPLOYAPI SegResult : public DetResult {
     std::vector<Mask> masks{}; /**< Detected object masks (binary, 0 for background, 1 for foreground) */
 
+    SegResult()                                = default;
+    SegResult(const SegResult&)                = default;
+    SegResult(SegResult&&) noexcept            = default;
+    SegResult& operator=(const SegResult&)     = default;
+    SegResult& operator=(SegResult&&) noexcept = default;
+
     /**
-     * @brief Copy assignment operator.
-     *
-     * @param other The source SegResult to copy from.
-     * @return SegResult& Reference to the assigned SegResult.
+     * @brief Removes all detections.
      */
-    SegResult& operator=(const SegResult& other) {
-        DetResult::operator=(static_cast<const DetResult&>(other));
-        masks = other.masks;
-        return *this;
+    void clear() {
+        DetResult::clear();
+        masks.clear();
+    }
+};
+
+/**
+ * @brief Read-only view of the key points of one detection of a PoseResult.
+ *
+ * It points into PoseResult::kpts, so it is only valid as long as the result is not modified.
+ */
+struct DEPLOYAPI KeyPoints {
+    const float* data = nullptr; /**< Key points of the detection, [nkpt, ndim] */
+    int          nkpt = 0;       /**< Number of key points */
+    int          ndim = 0;       /**< Values per key point: 2 (x, y) or 3 (x, y, conf) */
+
+    /**
+     * @brief Gets the number of key points.
+     */
+    int size() const {
+        return nkpt;
+    }
+
+    /**
+     * @brief Gets the x-coordinate of key point j.
+     */
+    float x(int j) const {
+        return data[j * ndim];
+    }
+
+    /**
+     * @brief Gets the y-coordinate of key point j.
+     */
+    float y(int j) const {
+        return data[j * ndim + 1];
+    }
+
+    /**
+     * @brief Gets the confidence of key point j, if the model predicts one.
+     */
+    std::optional<float> conf(int j) const {
+        return ndim > 2 ? std::optional<float>(data[j * ndim + 2]) : std::nullopt;
+    }
+
+    /**
+     * @brief Gets key point j as a KeyPoint.
+     */
+    KeyPoint operator[](int j) const {
+        return KeyPoint(x(j), y(j), conf(j));
     }
 };
 
 /**
  * @brief Represents the result of Pose Estimation.
+ *
+ * The key points of all detections are stored in a single contiguous buffer, so a result costs no allocation
+ * per detection and can be exported to NumPy without copying.
  */
 struct DEPLOYAPI PoseResult : public DetResult {
-    std::vector<std::vector<KeyPoint>> kpts{}; /**< Container for detected key points. */
+    int                nkpt = 0; /**< Number of key points per detection */
+    int                ndim = 0; /**< Values per key point: 2 (x, y) or 3 (x, y, conf) */
+    std::vector<float> kpts{};   /**< Key points of all detections, [num, nkpt, ndim] */
+
+    PoseResult()                                 = default;
+    PoseResult(const PoseResult&)                = default;
+    PoseResult(PoseResult&&) noexcept            = default;
+    PoseResult& operator=(const PoseResult&)     = default;
+    PoseResult& operator=(PoseResult&&) noexcept = default;
 
     /**
-     * @brief Copy assignment operator.
+     * @brief Gets a view of the key points of detection i.
      *
-     * @param other The source PoseResult to copy from.
-     * @return PoseResult& Reference to the assigned PoseResult.
+     * @param i Index of the detection, in [0, num).
+     * @return KeyPoints View of the nkpt key points of the detection.
      */
-    PoseResult& operator=(const PoseResult& other) {
-        DetResult::operator=(static_cast<const DetResult&>(other));
-        kpts = other.kpts;
-        return *this;
+    KeyPoints keypoints(int i) const {
+        return KeyPoints{kpts.data() + static_cast<size_t>(i) * nkpt * ndim, nkpt, ndim};
+    }
+
+    /**
+     * @brief Removes all detections, keeping the allocated storage.
+     */
+    void clear() {
+        DetResult::clear();
+        kpts.clear();
     }
 };
 
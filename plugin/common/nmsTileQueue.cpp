@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "common/nmsTileQueue.h"
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+int64_t nmsTileQueueReference(
+    int32_t const* numBoxes, int32_t batchSize, int32_t tileSize, int32_t numBlocks, int64_t* blockCost)
+{
+    if (batchSize < 1 || tileSize < 1 || numBlocks < 1)
+    {
+        return -1;
+    }
+
+    // Same layout as the EfficientNMSBitmaskTiles kernel
+    std::vector<int32_t> tileOffsets(batchSize + 1, 0);
+    std::vector<std::vector<int8_t>> visited(batchSize);
+    for (int32_t imageIdx = 0; imageIdx < batchSize; imageIdx++)
+    {
+        int32_t const rows = (numBoxes[imageIdx] + tileSize - 1) / tileSize;
+        tileOffsets[imageIdx + 1] = tileOffsets[imageIdx] + nmsTileCount(numBoxes[imageIdx], tileSize);
+        visited[imageIdx].assign(static_cast<size_t>(rows) * rows, 0);
+    }
+
+    // Blocks ordered by the time they become free, ties taken by the lowest block index
+    using BlockState = std::pair<int64_t, int32_t>;
+    std::priority_queue<BlockState, std::vector<BlockState>, std::greater<BlockState>> blocks;
+    for (int32_t block = 0; block < numBlocks; block++)
+    {
+        blocks.push({0, block});
+        if (blockCost)
+        {
+            blockCost[block] = 0;
+        }
+    }
+
+    int64_t makespan = 0;
+    for (int32_t tile = 0; tile < tileOffsets[batchSize]; tile++)
+    {
+        int32_t imageIdx, rowBlock, colBlock;
+        nmsTileDecode(tile, tileOffsets.data(), batchSize, numBoxes, tileSize, imageIdx, rowBlock, colBlock);
+        int32_t const rows = (numBoxes[imageIdx] + tileSize - 1) / tileSize;
+        if (rowBlock < 0 || colBlock < rowBlock || colBlock >= rows
+            || visited[imageIdx][static_cast<size_t>(rowBlock) * rows + colBlock]++)
+        {
+            return -1;
+        }
+
+        // Box pairs of the tile, only the pairs above the diagonal for diagonal tiles
+        int64_t const rowBoxes = std::min(tileSize, numBoxes[imageIdx] - rowBlock * tileSize);
+        int64_t const colBoxes = std::min(tileSize, numBoxes[imageIdx] - colBlock * tileSize);
+        int64_t const cost = rowBlock == colBlock ? rowBoxes * (rowBoxes - 1) / 2 : rowBoxes * colBoxes;
+
+        BlockState block = blocks.top();
+        blocks.pop();
+        block.first += cost;
+        makespan = std::max(makespan, block.first);
+        if (blockCost)
+        {
+            blockCost[block.second] += cost;
+        }
+        blocks.push(block);
+    }
+
+    for (int32_t imageIdx = 0; imageIdx < batchSize; imageIdx++)
+    {
+        int32_t const rows = (numBoxes[imageIdx] + tileSize - 1) / tileSize;
+        for (int32_t row = 0; row < rows; row++)
+        {
+            for (int32_t col = row; col < rows; col++)
+            {
+                if (visited[imageIdx][static_cast<size_t>(row) * rows + col] != 1)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+    return makespan;
+}
+
+} // namespace plugin
+} // namespace nvinfer1
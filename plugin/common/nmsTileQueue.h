@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_NMS_TILE_QUEUE_H
+#define TRT_NMS_TILE_QUEUE_H
+
+#include <cstdint>
+
+#ifdef __CUDACC__
+#define NMS_TILE_QUEUE_FUNC __host__ __device__ inline
+#else
+#define NMS_TILE_QUEUE_FUNC inline
+#endif
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+// Work queue of the bitmask NMS mask pass. Instead of a fixed grid of tiles per image, where the blocks of
+// sparse images exit right away and a crowded image is limited to its own slice of the grid, every tile of
+// the batch gets a position in a single queue that persistent blocks drain in order. An image with N sorted
+// candidates has ceil(N / tileSize) tile rows, and row r holds the tiles (r, r) .. (r, rows - 1) of the upper
+// triangle. Images are laid out one after the other, so heavy images simply own more of the queue.
+
+// Number of upper triangle tiles of an image with numBoxes candidates.
+NMS_TILE_QUEUE_FUNC int32_t nmsTileCount(int32_t numBoxes, int32_t tileSize)
+{
+    int32_t const rows = (numBoxes + tileSize - 1) / tileSize;
+    return rows * (rows + 1) / 2;
+}
+
+// Maps a position in the queue to its image, tile row and tile column. tileOffsets holds the exclusive prefix
+// sum of nmsTileCount over the batch, with tileOffsets[batchSize] the total number of tiles.
+NMS_TILE_QUEUE_FUNC void nmsTileDecode(int32_t tile, int32_t const* tileOffsets, int32_t batchSize,
+    int32_t const* numBoxes, int32_t tileSize, int32_t& imageIdx, int32_t& rowBlock, int32_t& colBlock)
+{
+    // Last image whose first tile is at or before the queue position, skipping images without tiles.
+    int32_t lo = 0;
+    int32_t hi = batchSize - 1;
+    while (lo < hi)
+    {
+        int32_t const mid = (lo + hi + 1) / 2;
+        if (tileOffsets[mid] <= tile)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+    imageIdx = lo;
+
+    int32_t const rows = (numBoxes[imageIdx] + tileSize - 1) / tileSize;
+    int32_t local = tile - tileOffsets[imageIdx];
+    rowBlock = 0;
+    while (local >= rows - rowBlock)
+    {
+        local -= rows - rowBlock;
+        rowBlock++;
+    }
+    colBlock = rowBlock + local;
+}
+
+// Host simulation of the persistent mask grid draining the queue of a batch.
+//
+// numBlocks blocks take the tiles in queue order, each one as soon as it is done with its previous tile. A tile
+// costs as many IOU evaluations as it holds box pairs. Writes the cost processed by each block to blockCost
+// (numBlocks entries, may be null) and returns the simulated makespan, or -1 if the decoded tiles do not cover
+// the upper triangle of every image exactly once.
+int64_t nmsTileQueueReference(
+    int32_t const* numBoxes, int32_t batchSize, int32_t tileSize, int32_t numBlocks, int64_t* blockCost);
+
+} // namespace plugin
+} // namespace nvinfer1
+
+#undef NMS_TILE_QUEUE_FUNC
+
+#endif // TRT_NMS_TILE_QUEUE_H
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cstring>
+
+#include "common/topKSelect.h"
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+uint32_t topKSelectKey(float score)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &score, sizeof(bits));
+    return (bits & 0x80000000U) ? ~bits : (bits | 0x80000000U);
+}
+
+int32_t topKSelectReference(uint32_t const* keys, int32_t count, int32_t k, int32_t keyBits, int32_t* selected)
+{
+    if (k <= 0)
+    {
+        return 0;
+    }
+    if (count <= k)
+    {
+        for (int32_t i = 0; i < count; i++)
+        {
+            selected[i] = i;
+        }
+        return count;
+    }
+
+    // Radix select: narrow down the k-th largest key one digit at a time, starting from the most significant.
+    int32_t constexpr kRadixBits = 8;
+    uint32_t constexpr kRadixMask = (1U << kRadixBits) - 1;
+    uint32_t kthKey = 0;
+    uint32_t prefixMask = 0;
+    int32_t ties = k;
+    for (int32_t shift = ((keyBits + kRadixBits - 1) / kRadixBits - 1) * kRadixBits; shift >= 0; shift -= kRadixBits)
+    {
+        std::array<int32_t, 1U << kRadixBits> histogram{};
+        for (int32_t i = 0; i < count; i++)
+        {
+            if ((keys[i] & prefixMask) == kthKey)
+            {
+                histogram[(keys[i] >> shift) & kRadixMask]++;
+            }
+        }
+
+        uint32_t digit = kRadixMask;
+        for (; digit > 0; digit--)
+        {
+            if (histogram[digit] >= ties)
+            {
+                break;
+            }
+            ties -= histogram[digit];
+        }
+        kthKey |= digit << shift;
+        prefixMask |= kRadixMask << shift;
+    }
+
+    // Compaction: every key above the k-th key, plus the first ties in position order.
+    int32_t numSelected = 0;
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (keys[i] > kthKey || (keys[i] == kthKey && ties-- > 0))
+        {
+            selected[numSelected++] = i;
+        }
+    }
+    return numSelected;
+}
+
+} // namespace plugin
+} // namespace nvinfer1
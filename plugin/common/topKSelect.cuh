@@ -0,0 +1,187 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_TOPK_SELECT_CUH
+#define TRT_TOPK_SELECT_CUH
+
+#include "cub/cub.cuh"
+#include "cuda_fp16.h"
+
+#define TOPK_SELECT_BLOCK 512
+#define TOPK_SELECT_RADIX_BITS 8
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+// Radix keys follow the bit ranges sorted by the NMS segmented radix sort: the whole value, or only the top
+// scoreBits bits of the half precision mantissa when the scoreBits optimization is enabled.
+template <typename T>
+__device__ unsigned int TopKSelectKey(T score, int scoreBits);
+
+template <>
+__device__ inline unsigned int TopKSelectKey<float>(float score, int /* scoreBits */)
+{
+    unsigned int bits = __float_as_uint(score);
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+template <>
+__device__ inline unsigned int TopKSelectKey<__half>(__half score, int scoreBits)
+{
+    unsigned int bits = __half_as_ushort(score);
+    if (scoreBits > 0)
+    {
+        return (bits >> (10 - scoreBits)) & ((1u << scoreBits) - 1);
+    }
+    return (bits & 0x8000u) ? (~bits & 0xFFFFu) : (bits | 0x8000u);
+}
+
+// One block per image keeps the numSelectedBoxes highest scores of the filtered segment
+// [imageIdx * numScoreElements, imageIdx * numScoreElements + topNumData[imageIdx]) and writes them, in their
+// original order, to the same segment of the selected buffers. Ties at the k-th score are taken in segment
+// order, so sorting the selection gives the same first numSelectedBoxes entries as sorting the whole segment.
+// The segment counters are updated to the selection size. Segments that are already small enough are copied.
+template <typename T>
+__global__ void TopKSelect(int numScoreElements, int numSelectedBoxes, int scoreBits, int* __restrict__ topNumData,
+    int* __restrict__ topOffsetsEndData, const T* __restrict__ topScoresData, const int* __restrict__ topIndexData,
+    T* __restrict__ selectedScoresData, int* __restrict__ selectedIndexData)
+{
+    typedef cub::BlockScan<int, TOPK_SELECT_BLOCK> BlockScan;
+    __shared__ typename BlockScan::TempStorage scanStorage;
+    __shared__ unsigned int histogram[1 << TOPK_SELECT_RADIX_BITS];
+    __shared__ unsigned int kthKey;
+    __shared__ int ties;
+
+    unsigned int thread = threadIdx.x;
+    int imageIdx = blockIdx.x;
+    int count = topNumData[imageIdx];
+    int offset = imageIdx * numScoreElements;
+    const T* scores = topScoresData + offset;
+    const int* indices = topIndexData + offset;
+
+    if (count <= numSelectedBoxes)
+    {
+        for (int i = thread; i < count; i += blockDim.x)
+        {
+            selectedScoresData[offset + i] = scores[i];
+            selectedIndexData[offset + i] = indices[i];
+        }
+        return;
+    }
+
+    // Radix select: narrow down the k-th largest key one digit at a time, starting from the most significant.
+    const unsigned int radixMask = (1u << TOPK_SELECT_RADIX_BITS) - 1;
+    int keyBits = scoreBits > 0 ? scoreBits : sizeof(T) * 8;
+    unsigned int prefixMask = 0;
+    if (thread == 0)
+    {
+        kthKey = 0;
+        ties = numSelectedBoxes;
+    }
+    for (int shift = ((keyBits + TOPK_SELECT_RADIX_BITS - 1) / TOPK_SELECT_RADIX_BITS - 1) * TOPK_SELECT_RADIX_BITS;
+         shift >= 0; shift -= TOPK_SELECT_RADIX_BITS)
+    {
+        for (int bin = thread; bin < (1 << TOPK_SELECT_RADIX_BITS); bin += blockDim.x)
+        {
+            histogram[bin] = 0;
+        }
+        __syncthreads();
+
+        unsigned int prefix = kthKey;
+        for (int i = thread; i < count; i += blockDim.x)
+        {
+            unsigned int key = TopKSelectKey<T>(scores[i], scoreBits);
+            if ((key & prefixMask) == prefix)
+            {
+                atomicAdd(&histogram[(key >> shift) & radixMask], 1);
+            }
+        }
+        __syncthreads();
+
+        if (thread == 0)
+        {
+            int remaining = ties;
+            unsigned int digit = radixMask;
+            for (; digit > 0; digit--)
+            {
+                if ((int) histogram[digit] >= remaining)
+                {
+                    break;
+                }
+                remaining -= histogram[digit];
+            }
+            kthKey = prefix | (digit << shift);
+            ties = remaining;
+        }
+        prefixMask |= radixMask << shift;
+        __syncthreads();
+    }
+
+    // Compaction: every key above the k-th key, plus the first ties in segment order. Two block scans per chunk
+    // give the rank of each tie and the output position of each selected element.
+    unsigned int kth = kthKey;
+    int tieQuota = ties;
+    int selectedBase = 0;
+    int tieBase = 0;
+    for (int start = 0; start < count; start += blockDim.x)
+    {
+        int i = start + thread;
+        unsigned int key = i < count ? TopKSelectKey<T>(scores[i], scoreBits) : 0;
+        int above = i < count && key > kth;
+        int tie = i < count && key == kth;
+
+        int tieRank, tieTotal;
+        BlockScan(scanStorage).ExclusiveSum(tie, tieRank, tieTotal);
+        __syncthreads();
+
+        int take = above || (tie && tieBase + tieRank < tieQuota);
+        int position, takeTotal;
+        BlockScan(scanStorage).ExclusiveSum(take, position, takeTotal);
+        __syncthreads();
+
+        if (take)
+        {
+            selectedScoresData[offset + selectedBase + position] = scores[i];
+            selectedIndexData[offset + selectedBase + position] = indices[i];
+        }
+        selectedBase += takeTotal;
+        tieBase += tieTotal;
+    }
+
+    if (thread == 0)
+    {
+        topNumData[imageIdx] = numSelectedBoxes;
+        topOffsetsEndData[imageIdx] = offset + numSelectedBoxes;
+    }
+}
+
+template <typename T>
+cudaError_t TopKSelectLauncher(int batchSize, int numScoreElements, int numSelectedBoxes, int scoreBits,
+    int* topNumData, int* topOffsetsEndData, const T* topScoresData, const int* topIndexData, T* selectedScoresData,
+    int* selectedIndexData, cudaStream_t stream)
+{
+    TopKSelect<T><<<batchSize, TOPK_SELECT_BLOCK, 0, stream>>>(numScoreElements, numSelectedBoxes, scoreBits,
+        topNumData, topOffsetsEndData, topScoresData, topIndexData, selectedScoresData, selectedIndexData);
+    return cudaGetLastError();
+}
+
+} // namespace plugin
+} // namespace nvinfer1
+
+#endif // TRT_TOPK_SELECT_CUH
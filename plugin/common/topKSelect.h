@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_TOPK_SELECT_H
+#define TRT_TOPK_SELECT_H
+
+#include <cstdint>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+// Maps a float score to an unsigned radix key with the same ordering (-0.0 sorts below +0.0, as in cub).
+uint32_t topKSelectKey(float score);
+
+// Host reference of the TopKSelect kernel in topKSelect.cuh.
+//
+// Writes to selected the positions of the k largest keys among the first count keys, in increasing position
+// order, and returns how many were written (min(count, k)). Ties at the k-th largest key are resolved in
+// position order, so the selection matches the first k entries of a stable descending sort. The k-th key is
+// found by a most significant digit radix select over keyBits bits, 8 bits per pass, like the kernel.
+int32_t topKSelectReference(uint32_t const* keys, int32_t count, int32_t k, int32_t keyBits, int32_t* selected);
+
+} // namespace plugin
+} // namespace nvinfer1
+
+#endif // TRT_TOPK_SELECT_H
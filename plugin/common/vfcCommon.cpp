@@ -20,12 +20,14 @@
 #include "NvInferPlugin.h"
 #include "efficientRotatedNMSPlugin/efficientRotatedNMSPlugin.h"
 #include "efficientIdxNMSPlugin/efficientIdxNMSPlugin.h"
+#include "efficientTopKPlugin/efficientTopKPlugin.h"
 #include <vector>
 #include <mutex>
 
 using namespace nvinfer1;
 using nvinfer1::plugin::EfficientRotatedNMSPluginCreator;
 using nvinfer1::plugin::EfficientIdxNMSPluginCreator;
+using nvinfer1::plugin::EfficientTopKPluginCreator;
 
 namespace nvinfer1
 {
@@ -81,10 +83,11 @@ extern "C" TENSORRTAPI void setLoggerFinder(nvinfer1::ILoggerFinder* finder)
 #if (TENSORRT_VERSION >= 100000)
 extern "C" TENSORRTAPI IPluginCreatorInterface* const* getCreators(int32_t& nbCreators)
 {
-    nbCreators = 2;
+    nbCreators = 3;
     static EfficientRotatedNMSPluginCreator efficientRotatedNMSPluginCreator;
     static EfficientIdxNMSPluginCreator efficientIdxNMSPluginCreator;
-    static IPluginCreatorInterface* const kPLUGIN_CREATOR_LIST[] = {&efficientRotatedNMSPluginCreator, &efficientIdxNMSPluginCreator};
+    static EfficientTopKPluginCreator efficientTopKPluginCreator;
+    static IPluginCreatorInterface* const kPLUGIN_CREATOR_LIST[] = {&efficientRotatedNMSPluginCreator, &efficientIdxNMSPluginCreator, &efficientTopKPluginCreator};
     return kPLUGIN_CREATOR_LIST;
 
 }
@@ -93,10 +96,11 @@ extern "C" TENSORRTAPI IPluginCreatorInterface* const* getCreators(int32_t& nbCr
 #if (TENSORRT_VERSION < 100100)
 extern "C" TENSORRTAPI IPluginCreator* const* getPluginCreators(int32_t& nbCreators)
 {
-    nbCreators = 2;
+    nbCreators = 3;
     static EfficientRotatedNMSPluginCreator efficientRotatedNMSPluginCreator;
     static EfficientIdxNMSPluginCreator efficientIdxNMSPluginCreator;
-    static IPluginCreator* const kPLUGIN_CREATOR_LIST[] = {&efficientRotatedNMSPluginCreator, &efficientIdxNMSPluginCreator};
+    static EfficientTopKPluginCreator efficientTopKPluginCreator;
+    static IPluginCreator* const kPLUGIN_CREATOR_LIST[] = {&efficientRotatedNMSPluginCreator, &efficientIdxNMSPluginCreator, &efficientTopKPluginCreator};
     return kPLUGIN_CREATOR_LIST;
 }
 #endif
@@ -16,6 +16,8 @@
  */
 
 #include "common/bboxUtils.h"
+#include "common/nmsTileQueue.h"
+#include "common/topKSelect.cuh"
 #include "cub/cub.cuh"
 #include "cuda_runtime_api.h"
 
@@ -23,6 +25,7 @@
 #include "efficientIdxNMSInference.h"
 
 #define NMS_TILES 5
+#define NMS_BITMASK_BLOCK 64
 
 using namespace nvinfer1;
 using namespace nvinfer1::plugin;
@@ -49,6 +52,58 @@ __device__ float IOU(EfficientIdxNMSParameters param, BoxCorner<T> box1, BoxCorn
     return intersectArea / unionArea;
 }
 
+// Applies the same transform to a runtime score threshold as EfficientNMSFilterLauncher does to the attribute.
+__device__ float RuntimeScoreThreshold(EfficientIdxNMSParameters param, float threshold)
+{
+    if (!param.scoreSigmoid)
+    {
+        return threshold;
+    }
+    // Inverse Sigmoid
+    if (threshold <= 0.f)
+    {
+        return -(1 << 15);
+    }
+    return logf(threshold / (1.f - threshold));
+}
+
+// The thresholds below come from the thresholds input when the plugin has one (see efficientIdxNMSParameters.h
+// for its layout), where negative values fall back to the plugin attributes.
+__device__ float ScoreThreshold(EfficientIdxNMSParameters param, int classIdx)
+{
+    if (!param.thresholds)
+    {
+        return param.scoreThreshold;
+    }
+    float threshold = param.thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_SCORE];
+    threshold = threshold < 0.f ? param.scoreThreshold : RuntimeScoreThreshold(param, threshold);
+    float classThreshold = param.thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_CLASS_SCORES + classIdx];
+    if (classThreshold > 0.f)
+    {
+        threshold = fmaxf(threshold, RuntimeScoreThreshold(param, classThreshold));
+    }
+    return threshold;
+}
+
+__device__ float IOUThreshold(EfficientIdxNMSParameters param)
+{
+    if (!param.thresholds || param.thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_IOU] < 0.f)
+    {
+        return param.iouThreshold;
+    }
+    return param.thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_IOU];
+}
+
+__device__ int NumOutputBoxes(EfficientIdxNMSParameters param)
+{
+    // The output tensors are sized by the attribute, so the runtime value can only lower it.
+    if (!param.thresholds || param.thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_MAX_OUTPUT_BOXES] < 0.f)
+    {
+        return param.numOutputBoxes;
+    }
+    return min((int) param.thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_MAX_OUTPUT_BOXES], param.numOutputBoxes);
+}
+
 template <typename T, typename Tb>
 __device__ BoxCorner<T> DecodeBoxes(EfficientIdxNMSParameters param, int boxIdx, int anchorIdx,
     const Tb* __restrict__ boxesInput, const Tb* __restrict__ anchorsInput)
@@ -170,6 +225,8 @@ __global__ void EfficientNMS(EfficientIdxNMSParameters param, const int* topNumD
     {
         return;
     }
+    float iouThreshold = IOUThreshold(param);
+    int numOutputBoxes = NumOutputBoxes(param);
 
     __shared__ int blockState;
     __shared__ unsigned int resultsCounter;
@@ -215,7 +272,7 @@ __global__ void EfficientNMS(EfficientIdxNMSParameters param, const int* topNumD
             {
                 // As this box will be kept, this is a good place to find what index in the results buffer it
                 // should have, as this allows to perform an early loop exit if there are enough results.
-                if (resultsCounter >= param.numOutputBoxes)
+                if (resultsCounter >= numOutputBoxes)
                 {
                     blockState = -2; // -2 => Signal all threads to do an early loop exit.
                 }
@@ -294,7 +351,7 @@ __global__ void EfficientNMS(EfficientIdxNMSParameters param, const int* topNumD
                 threadState[tile] == 0 &&          // Make sure this box hasn't been either dropped or kept already;
                 ignoreClass &&                     // Compare only boxes of matching classes when classAgnostic is false;
                 lte_mp(threadScore[tile], testScore) && // Make sure the sorting order of scores is as expected;
-                IOU<T>(param, threadBox[tile], testBox) >= param.iouThreshold) // And... IOU overlap.
+                IOU<T>(param, threadBox[tile], testBox) >= iouThreshold) // And... IOU overlap.
             {
                 // Current box overlaps with the box tested in this iteration, this box will be skipped.
                 threadState[tile] = -1; // -1 => Mark this box's thread to be dropped.
@@ -341,6 +398,325 @@ cudaError_t EfficientNMSLauncher(EfficientIdxNMSParameters& param, int* topNumDa
     return cudaGetLastError();
 }
 
+__global__ void EfficientNMSBitmaskTiles(EfficientIdxNMSParameters param, int* __restrict__ topNumData,
+    int* __restrict__ tileOffsetsData, int* __restrict__ tileQueueData)
+{
+    // Lays out the mask tiles of every image in a single work queue, see common/nmsTileQueue.h.
+    if (threadIdx.x != 0)
+    {
+        return;
+    }
+    int numTiles = 0;
+    for (int imageIdx = 0; imageIdx < param.batchSize; imageIdx++)
+    {
+        int numSelectedBoxes = min(topNumData[imageIdx], param.numSelectedBoxes);
+        topNumData[imageIdx] = numSelectedBoxes;
+        tileOffsetsData[imageIdx] = numTiles;
+        numTiles += nmsTileCount(numSelectedBoxes, NMS_BITMASK_BLOCK);
+    }
+    tileOffsetsData[param.batchSize] = numTiles;
+    *tileQueueData = 0;
+}
+
+template <typename T, typename Tb>
+__global__ void EfficientNMSBitmask(EfficientIdxNMSParameters param, const int* __restrict__ topNumData,
+    const int* __restrict__ tileOffsetsData, int* __restrict__ tileQueueData, const int* __restrict__ sortedIndexData,
+    const T* __restrict__ sortedScoresData, const int* __restrict__ topClassData,
+    const int* __restrict__ topAnchorsData, const Tb* __restrict__ boxesInput, const Tb* __restrict__ anchorsInput,
+    unsigned long long* __restrict__ maskData)
+{
+    // Each tile compares NMS_BITMASK_BLOCK row boxes against NMS_BITMASK_BLOCK column boxes. Bit c of the mask
+    // word (row, colBlock) is set when the row box suppresses the column box, should the row box be kept. Only
+    // the upper triangle (column index > row index) is ever needed. The grid is persistent: each block keeps
+    // taking the next tile of the batch from the work queue, so crowded images are spread over every SM.
+    __shared__ int tile;
+    __shared__ T colScore[NMS_BITMASK_BLOCK];
+    __shared__ int colClass[NMS_BITMASK_BLOCK];
+    __shared__ BoxCorner<T> colBox[NMS_BITMASK_BLOCK];
+
+    unsigned int thread = threadIdx.x;
+    int numTiles = tileOffsetsData[param.batchSize];
+    int colBlocks = (param.numSelectedBoxes + NMS_BITMASK_BLOCK - 1) / NMS_BITMASK_BLOCK;
+    float iouThreshold = IOUThreshold(param);
+
+    while (true)
+    {
+        if (thread == 0)
+        {
+            tile = atomicAdd(tileQueueData, 1);
+        }
+        __syncthreads();
+        if (tile >= numTiles)
+        {
+            return;
+        }
+
+        int imageIdx, rowBlock, colBlock;
+        nmsTileDecode(tile, tileOffsetsData, param.batchSize, topNumData, NMS_BITMASK_BLOCK, imageIdx, rowBlock,
+            colBlock);
+        int numSelectedBoxes = topNumData[imageIdx];
+
+        int colIdx = colBlock * NMS_BITMASK_BLOCK + thread;
+        if (colIdx < numSelectedBoxes)
+        {
+            T score;
+            int classIdx;
+            BoxCorner<T> box;
+            int boxIdxMap;
+            MapNMSData<T, Tb>(param, colIdx, imageIdx, boxesInput, anchorsInput, topClassData, topAnchorsData,
+                topNumData, sortedScoresData, sortedIndexData, score, classIdx, box, boxIdxMap);
+            colScore[thread] = score;
+            colClass[thread] = classIdx;
+            colBox[thread] = box;
+        }
+        __syncthreads();
+
+        int rowIdx = rowBlock * NMS_BITMASK_BLOCK + thread;
+        if (rowIdx < numSelectedBoxes)
+        {
+            T rowScore;
+            int rowClass;
+            BoxCorner<T> rowBox;
+            int rowBoxIdxMap;
+            MapNMSData<T, Tb>(param, rowIdx, imageIdx, boxesInput, anchorsInput, topClassData, topAnchorsData,
+                topNumData, sortedScoresData, sortedIndexData, rowScore, rowClass, rowBox, rowBoxIdxMap);
+
+            int colStart = colBlock == rowBlock ? thread + 1 : 0;
+            int colEnd = min(NMS_BITMASK_BLOCK, numSelectedBoxes - colBlock * NMS_BITMASK_BLOCK);
+            unsigned long long bits = 0;
+            for (int col = colStart; col < colEnd; col++)
+            {
+                if ((param.classAgnostic || colClass[col] == rowClass) && // Compare only boxes of matching classes;
+                    lte_mp(colScore[col], rowScore) &&                     // Make sure the sorting order is as expected;
+                    IOU<T>(param, colBox[col], rowBox) >= iouThreshold)    // And... IOU overlap.
+                {
+                    bits |= 1ULL << col;
+                }
+            }
+            maskData[((size_t) imageIdx * param.numSelectedBoxes + rowIdx) * colBlocks + colBlock] = bits;
+        }
+
+        // The shared tile and column data are overwritten by the next iteration.
+        __syncthreads();
+    }
+}
+
+template <typename T, typename Tb>
+__global__ void EfficientNMSBitmaskReduce(EfficientIdxNMSParameters param, const int* topNumData,
+    int* outputClassData, const int* sortedIndexData, const T* __restrict__ sortedScoresData,
+    const int* __restrict__ topClassData, const int* __restrict__ topAnchorsData, const Tb* __restrict__ boxesInput,
+    const Tb* __restrict__ anchorsInput, const unsigned long long* __restrict__ maskData,
+    int* __restrict__ numDetectionsOutput, T* __restrict__ nmsScoresOutput, int* __restrict__ nmsClassesOutput,
+    int* __restrict__ nmsIndicesOutput, BoxCorner<T>* __restrict__ nmsBoxesOutput)
+{
+    // A single warp per image walks the sorted boxes and accumulates the suppression bits of every kept box.
+    // The warp stays converged, so no block-wide synchronization is needed between boxes.
+    unsigned int lane = threadIdx.x;
+    unsigned int imageIdx = blockIdx.y;
+    if (imageIdx >= param.batchSize)
+    {
+        return;
+    }
+
+    int numSelectedBoxes = min(topNumData[imageIdx], param.numSelectedBoxes);
+    int numBlocks = (numSelectedBoxes + NMS_BITMASK_BLOCK - 1) / NMS_BITMASK_BLOCK;
+    int colBlocks = (param.numSelectedBoxes + NMS_BITMASK_BLOCK - 1) / NMS_BITMASK_BLOCK;
+    int numOutputBoxes = NumOutputBoxes(param);
+
+    __shared__ unsigned long long removed[kEFFICIENT_IDX_NMS_BITMASK_MAX_BOXES / NMS_BITMASK_BLOCK];
+    for (int block = lane; block < numBlocks; block += warpSize)
+    {
+        removed[block] = 0;
+    }
+    __syncwarp();
+
+    unsigned int resultsCounter = 0;
+    for (int block = 0; block < numBlocks; block++)
+    {
+        unsigned long long removedBits = removed[block];
+        int blockSize = min(NMS_BITMASK_BLOCK, numSelectedBoxes - block * NMS_BITMASK_BLOCK);
+        for (int bit = 0; bit < blockSize; bit++)
+        {
+            if (removedBits & (1ULL << bit))
+            {
+                // This box overlaps with a previously kept box, it is dropped.
+                continue;
+            }
+            if (resultsCounter >= numOutputBoxes)
+            {
+                // Early exit, there are enough results.
+                return;
+            }
+
+            // The box is kept, so it suppresses all the later boxes flagged in its mask row.
+            int boxIdx = block * NMS_BITMASK_BLOCK + bit;
+            const unsigned long long* maskRow = maskData + ((size_t) imageIdx * param.numSelectedBoxes + boxIdx) * colBlocks;
+            removedBits |= maskRow[block];
+            for (int col = block + 1 + lane; col < numBlocks; col += warpSize)
+            {
+                removed[col] |= maskRow[col];
+            }
+
+            if (lane == 0)
+            {
+                T score;
+                int classIdx;
+                BoxCorner<T> box;
+                int boxIdxMap;
+                MapNMSData<T, Tb>(param, boxIdx, imageIdx, boxesInput, anchorsInput, topClassData, topAnchorsData,
+                    topNumData, sortedScoresData, sortedIndexData, score, classIdx, box, boxIdxMap);
+
+                // Same per-class output limit as the serial kernel, a kept box still suppresses others.
+                bool write = true;
+                if (param.numOutputBoxesPerClass >= 0)
+                {
+                    int classCounterIdx = imageIdx * param.numClasses + classIdx;
+                    write = (outputClassData[classCounterIdx] < param.numOutputBoxesPerClass);
+                    outputClassData[classCounterIdx]++;
+                }
+                if (write)
+                {
+                    resultsCounter++;
+                    WriteNMSResult<T>(param, numDetectionsOutput, nmsScoresOutput, nmsClassesOutput, nmsBoxesOutput,
+                        nmsIndicesOutput, score, classIdx, box, imageIdx, resultsCounter, boxIdxMap);
+                }
+            }
+            resultsCounter = __shfl_sync(0xffffffff, resultsCounter, 0);
+        }
+        __syncwarp();
+    }
+}
+
+template <typename T, typename Tb>
+cudaError_t EfficientNMSBitmaskLaunch(EfficientIdxNMSParameters& param, int* topNumData, int* tileOffsetsData,
+    int* tileQueueData, int* outputClassData, int* sortedIndexData, T* sortedScoresData, int* topClassData,
+    int* topAnchorsData, const void* boxesInput, const void* anchorsInput, unsigned long long* maskData,
+    int* numDetectionsOutput, T* nmsScoresOutput, int* nmsClassesOutput, int* nmsIndicesOutput, void* nmsBoxesOutput,
+    cudaStream_t stream)
+{
+    // Persistent grid for the mask pass, as many blocks as can be resident at once, but no more than the tiles of
+    // a batch where every image has the maximum number of candidates.
+    int device, numSMs, blocksPerSM;
+    PLUGIN_CHECK_CUDA(cudaGetDevice(&device));
+    PLUGIN_CHECK_CUDA(cudaDeviceGetAttribute(&numSMs, cudaDevAttrMultiProcessorCount, device));
+    PLUGIN_CHECK_CUDA(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+        &blocksPerSM, EfficientNMSBitmask<T, Tb>, NMS_BITMASK_BLOCK, 0));
+    size_t maxTiles = (size_t) param.batchSize * nmsTileCount(param.numSelectedBoxes, NMS_BITMASK_BLOCK);
+    const unsigned int maskBlocks
+        = (unsigned int) std::max<size_t>(std::min<size_t>((size_t) numSMs * std::max(blocksPerSM, 1), maxTiles), 1);
+    const dim3 reduceBlockSize = {32, 1, 1};
+    const dim3 reduceGridSize = {1, (unsigned int) param.batchSize, 1};
+
+    EfficientNMSBitmaskTiles<<<1, 1, 0, stream>>>(param, topNumData, tileOffsetsData, tileQueueData);
+    EfficientNMSBitmask<T, Tb><<<maskBlocks, NMS_BITMASK_BLOCK, 0, stream>>>(param, topNumData, tileOffsetsData,
+        tileQueueData, sortedIndexData, sortedScoresData, topClassData, topAnchorsData, (Tb*) boxesInput,
+        (Tb*) anchorsInput, maskData);
+    // Note that nmsBoxesOutput is always coded as BoxCorner<T>, regardless of the input coding type.
+    EfficientNMSBitmaskReduce<T, Tb><<<reduceGridSize, reduceBlockSize, 0, stream>>>(param, topNumData,
+        outputClassData, sortedIndexData, sortedScoresData, topClassData, topAnchorsData, (Tb*) boxesInput,
+        (Tb*) anchorsInput, maskData, numDetectionsOutput, nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput,
+        (BoxCorner<T>*) nmsBoxesOutput);
+
+    return cudaGetLastError();
+}
+
+template <typename T>
+cudaError_t EfficientNMSBitmaskLauncher(EfficientIdxNMSParameters& param, int* topNumData, int* tileOffsetsData,
+    int* tileQueueData, int* outputClassData, int* sortedIndexData, T* sortedScoresData, int* topClassData,
+    int* topAnchorsData, const void* boxesInput, const void* anchorsInput, unsigned long long* maskData,
+    int* numDetectionsOutput, T* nmsScoresOutput, int* nmsClassesOutput, int* nmsIndicesOutput, void* nmsBoxesOutput,
+    cudaStream_t stream)
+{
+    if (param.boxCoding == 0)
+    {
+        return EfficientNMSBitmaskLaunch<T, BoxCorner<T>>(param, topNumData, tileOffsetsData, tileQueueData,
+            outputClassData, sortedIndexData, sortedScoresData, topClassData, topAnchorsData, boxesInput,
+            anchorsInput, maskData, numDetectionsOutput, nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput,
+            nmsBoxesOutput, stream);
+    }
+    else if (param.boxCoding == 1)
+    {
+        return EfficientNMSBitmaskLaunch<T, BoxCenterSize<T>>(param, topNumData, tileOffsetsData, tileQueueData,
+            outputClassData, sortedIndexData, sortedScoresData, topClassData, topAnchorsData, boxesInput,
+            anchorsInput, maskData, numDetectionsOutput, nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput,
+            nmsBoxesOutput, stream);
+    }
+
+    return cudaGetLastError();
+}
+
+template <typename T>
+__global__ void EfficientNMSDecodeDFL(EfficientIdxNMSParameters param, const int* __restrict__ topNumData,
+    const int* __restrict__ sortedIndexData, const int* __restrict__ topAnchorsData, const T* __restrict__ boxesInput,
+    const T* __restrict__ anchorsInput, BoxCorner<T>* __restrict__ decodedBoxesData)
+{
+    // Decodes the DFL distributions of the sorted candidates that can reach NMS, and only those, into corner boxes.
+    // The boxes are written at their anchor position, so that NMS can read them as a regular boxes input of shape
+    // [batchSize, numAnchors, 4]. Candidates of different classes may share an anchor, they write the same box.
+    int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    int imageIdx = blockIdx.y;
+    if (idx >= min(topNumData[imageIdx], param.numSelectedBoxes))
+    {
+        return;
+    }
+    int idxSort = imageIdx * param.numScoreElements + idx;
+    int anchorIdx = topAnchorsData[imageIdx * param.numScoreElements + sortedIndexData[idxSort]];
+
+    // Shape of boxesInput: [batchSize, 4 * regMax, numAnchors]
+    const T* logits = boxesInput + (size_t) imageIdx * 4 * param.regMax * param.numAnchors + anchorIdx;
+    float distance[4];
+    for (int side = 0; side < 4; side++)
+    {
+        const T* bins = logits + (size_t) side * param.regMax * param.numAnchors;
+        if (param.regMax == 1)
+        {
+            // Heads without DFL regress the distances directly
+            distance[side] = (float) bins[0];
+            continue;
+        }
+        // Expected value of the softmax distribution over the regMax bins
+        float maxLogit = (float) bins[0];
+        for (int bin = 1; bin < param.regMax; bin++)
+        {
+            maxLogit = fmaxf(maxLogit, (float) bins[(size_t) bin * param.numAnchors]);
+        }
+        float sum = 0.f;
+        float weighted = 0.f;
+        for (int bin = 0; bin < param.regMax; bin++)
+        {
+            float e = __expf((float) bins[(size_t) bin * param.numAnchors] - maxLogit);
+            sum += e;
+            weighted += e * bin;
+        }
+        distance[side] = weighted / sum;
+    }
+
+    // Shape of anchorsInput: [1, numAnchors, 3] or [batchSize, numAnchors, 3], holding x, y and stride
+    int anchorIdxMap = param.shareAnchors ? anchorIdx : imageIdx * param.numAnchors + anchorIdx;
+    const T* anchor = anchorsInput + (size_t) anchorIdxMap * 3;
+    float x = (float) anchor[0];
+    float y = (float) anchor[1];
+    float stride = (float) anchor[2];
+
+    // For NMS/IOU purposes, YXYX coding is identical to XYXY, the output boxes are x1, y1, x2, y2
+    decodedBoxesData[imageIdx * param.numAnchors + anchorIdx] = {(T) ((x - distance[0]) * stride),
+        (T) ((y - distance[1]) * stride), (T) ((x + distance[2]) * stride), (T) ((y + distance[3]) * stride)};
+}
+
+template <typename T>
+cudaError_t EfficientNMSDecodeDFLLauncher(EfficientIdxNMSParameters& param, int* topNumData, int* sortedIndexData,
+    int* topAnchorsData, const void* boxesInput, const void* anchorsInput, BoxCorner<T>* decodedBoxesData,
+    cudaStream_t stream)
+{
+    const unsigned int blockSize = 256;
+    const dim3 gridSize = {(param.numSelectedBoxes + blockSize - 1) / blockSize, (unsigned int) param.batchSize, 1};
+
+    EfficientNMSDecodeDFL<T><<<gridSize, blockSize, 0, stream>>>(param, topNumData, sortedIndexData, topAnchorsData,
+        (const T*) boxesInput, (const T*) anchorsInput, decodedBoxesData);
+
+    return cudaGetLastError();
+}
+
 __global__ void EfficientNMSFilterSegments(EfficientIdxNMSParameters param, const int* __restrict__ topNumData,
     int* __restrict__ topOffsetsStartData, int* __restrict__ topOffsetsEndData)
 {
@@ -370,14 +746,15 @@ __global__ void EfficientNMSFilter(EfficientIdxNMSParameters param, const T* __r
     // Shape of scoresInput: [batchSize, numAnchors, numClasses]
     int scoresInputIdx = imageIdx * param.numScoreElements + elementIdx;
 
+    // Unpack the class and anchor index from the element index
+    int classIdx = elementIdx % param.numClasses;
+    int anchorIdx = elementIdx / param.numClasses;
+
     // For each class, check its corresponding score if it crosses the threshold, and if so select this anchor,
     // and keep track of the maximum score and the corresponding (argmax) class id
     T score = scoresInput[scoresInputIdx];
-    if (gte_mp(score, (T) param.scoreThreshold))
+    if (gte_mp(score, (T) ScoreThreshold(param, classIdx)))
     {
-        // Unpack the class and anchor index from the element index
-        int classIdx = elementIdx % param.numClasses;
-        int anchorIdx = elementIdx / param.numClasses;
 
         // If this is a background class, ignore it.
         if (classIdx == param.backgroundClass)
@@ -510,7 +887,8 @@ cudaError_t EfficientNMSFilterLauncher(EfficientIdxNMSParameters& param, const T
         param.scoreBits = -1;
     }
 
-    if (param.scoreThreshold < kernelSelectThreshold)
+    // The dense kernel only applies the attribute threshold, runtime thresholds always go through the filter.
+    if (param.scoreThreshold < kernelSelectThreshold && !param.thresholds)
     {
         // A full copy of the buffer is necessary because sorting will scramble the input data otherwise.
         PLUGIN_CHECK_CUDA(cudaMemcpyAsync(topScoresData, scoresInput,
@@ -542,7 +920,8 @@ size_t EfficientNMSSortWorkspaceSize(int batchSize, int numScoreElements)
     return sortedWorkspaceSize;
 }
 
-size_t EfficientIdxNMSWorkspaceSize(int batchSize, int numScoreElements, int numClasses, DataType datatype)
+size_t EfficientIdxNMSWorkspaceSize(int batchSize, int numScoreElements, int numClasses, DataType datatype,
+    int nmsAlgorithm, int numDecodedAnchors, int numSelectedBoxes)
 {
     size_t total = 0;
     const size_t align = 256;
@@ -550,7 +929,8 @@ size_t EfficientIdxNMSWorkspaceSize(int batchSize, int numScoreElements, int num
     // 3 for Filtering
     // 1 for Output Indexing
     // C for Max per Class Limiting
-    size_t size = (3 + 1 + numClasses) * batchSize * sizeof(int);
+    // 1 (+2) for the Bitmask NMS Work Queue
+    size_t size = ((3 + 1 + numClasses + 1) * batchSize + 2) * sizeof(int);
     total += size + (size % align ? align - (size % align) : 0);
     // Int Buffers
     for (int i = 0; i < 4; i++)
@@ -575,6 +955,20 @@ size_t EfficientIdxNMSWorkspaceSize(int batchSize, int numScoreElements, int num
         size = EfficientNMSSortWorkspaceSize<float>(batchSize, numScoreElements);
         total += size + (size % align ? align - (size % align) : 0);
     }
+    // Suppression Mask
+    if (nmsAlgorithm == 1)
+    {
+        size_t maxBoxes = EfficientIdxNMSBitmaskBoxes(numSelectedBoxes, numScoreElements);
+        size_t colBlocks = (maxBoxes + NMS_BITMASK_BLOCK - 1) / NMS_BITMASK_BLOCK;
+        size = batchSize * maxBoxes * colBlocks * sizeof(unsigned long long);
+        total += size + (size % align ? align - (size % align) : 0);
+    }
+    // Decoded Boxes
+    if (numDecodedAnchors > 0)
+    {
+        size = (size_t) batchSize * numDecodedAnchors * 4 * dataTypeSize(datatype);
+        total += size + (size % align ? align - (size % align) : 0);
+    }
 
     return total;
 }
@@ -609,12 +1003,14 @@ pluginStatus_t EfficientNMSDispatch(EfficientIdxNMSParameters param, const void*
 
     // Counters Workspace
     size_t workspaceOffset = 0;
-    int countersTotalSize = (3 + 1 + param.numClasses) * param.batchSize;
+    int countersTotalSize = (3 + 1 + param.numClasses + 1) * param.batchSize + 2;
     int* topNumData = EfficientNMSWorkspace<int>(workspace, workspaceOffset, countersTotalSize);
     int* topOffsetsStartData = topNumData + param.batchSize;
     int* topOffsetsEndData = topNumData + 2 * param.batchSize;
     int* outputIndexData = topNumData + 3 * param.batchSize;
     int* outputClassData = topNumData + 4 * param.batchSize;
+    int* tileOffsetsData = outputClassData + param.numClasses * param.batchSize;
+    int* tileQueueData = tileOffsetsData + param.batchSize + 1;
     CSC(cudaMemsetAsync(topNumData, 0x00, countersTotalSize * sizeof(int), stream), STATUS_FAILURE);
     cudaError_t status = cudaGetLastError();
     CSC(status, STATUS_FAILURE);
@@ -633,31 +1029,81 @@ pluginStatus_t EfficientNMSDispatch(EfficientIdxNMSParameters param, const void*
         = EfficientNMSWorkspace<T>(workspace, workspaceOffset, param.batchSize * param.numScoreElements);
     size_t sortedWorkspaceSize = EfficientNMSSortWorkspaceSize<T>(param.batchSize, param.numScoreElements);
     char* sortedWorkspaceData = EfficientNMSWorkspace<char>(workspace, workspaceOffset, sortedWorkspaceSize);
-    cub::DoubleBuffer<T> scoresDB(topScoresData, sortedScoresData);
-    cub::DoubleBuffer<int> indexDB(topIndexData, sortedIndexData);
 
     // Kernels
     status = EfficientNMSFilterLauncher<T>(param, (T*) scoresInput, topNumData, topIndexData, topAnchorsData,
         topOffsetsStartData, topOffsetsEndData, topScoresData, topClassData, stream);
     CSC(status, STATUS_FAILURE);
 
+    // Top-K preselection: only the numSelectedBoxes highest scores of each image can reach NMS, so they are
+    // selected first and the sort only has to order numSelectedBoxes elements per image instead of all of them.
+    bool preselect = param.numScoreElements > param.numSelectedBoxes;
+    if (preselect)
+    {
+        status = TopKSelectLauncher<T>(param.batchSize, param.numScoreElements, param.numSelectedBoxes,
+            param.scoreBits, topNumData, topOffsetsEndData, topScoresData, topIndexData, sortedScoresData,
+            sortedIndexData, stream);
+        CSC(status, STATUS_FAILURE);
+    }
+    cub::DoubleBuffer<T> scoresDB(
+        preselect ? sortedScoresData : topScoresData, preselect ? topScoresData : sortedScoresData);
+    cub::DoubleBuffer<int> indexDB(
+        preselect ? sortedIndexData : topIndexData, preselect ? topIndexData : sortedIndexData);
+
     status = cub::DeviceSegmentedRadixSort::SortPairsDescending(sortedWorkspaceData, sortedWorkspaceSize, scoresDB,
         indexDB, param.batchSize * param.numScoreElements, param.batchSize, topOffsetsStartData, topOffsetsEndData,
         param.scoreBits > 0 ? (10 - param.scoreBits) : 0, param.scoreBits > 0 ? 10 : sizeof(T) * 8, stream);
     CSC(status, STATUS_FAILURE);
 
-    status = EfficientNMSLauncher<T>(param, topNumData, outputIndexData, outputClassData, indexDB.Current(),
-        scoresDB.Current(), topClassData, topAnchorsData, boxesInput, anchorsInput, (int*) numDetectionsOutput,
-        (T*) nmsScoresOutput, (int*) nmsClassesOutput, (int*) nmsIndicesOutput, nmsBoxesOutput, stream);
+    // DFL Box Decoding: from here on, NMS sees the decoded candidates as a regular corner coded boxes input.
+    if (param.boxCoding == kEFFICIENT_IDX_NMS_BOX_CODING_DFL)
+    {
+        BoxCorner<T>* decodedBoxesData = EfficientNMSWorkspace<BoxCorner<T>>(
+            workspace, workspaceOffset, (size_t) param.batchSize * param.numAnchors);
+        status = EfficientNMSDecodeDFLLauncher<T>(param, topNumData, indexDB.Current(), topAnchorsData, boxesInput,
+            anchorsInput, decodedBoxesData, stream);
+        CSC(status, STATUS_FAILURE);
+        boxesInput = decodedBoxesData;
+        anchorsInput = nullptr;
+        param.boxCoding = 0;
+        param.boxDecoder = false;
+        param.shareLocation = true;
+    }
+
+    if (param.nmsAlgorithm == 1)
+    {
+        int colBlocks = (param.numSelectedBoxes + NMS_BITMASK_BLOCK - 1) / NMS_BITMASK_BLOCK;
+        unsigned long long* maskData = EfficientNMSWorkspace<unsigned long long>(
+            workspace, workspaceOffset, (size_t) param.batchSize * param.numSelectedBoxes * colBlocks);
+        status = EfficientNMSBitmaskLauncher<T>(param, topNumData, tileOffsetsData, tileQueueData, outputClassData,
+            indexDB.Current(), scoresDB.Current(), topClassData, topAnchorsData, boxesInput, anchorsInput, maskData,
+            (int*) numDetectionsOutput, (T*) nmsScoresOutput, (int*) nmsClassesOutput, (int*) nmsIndicesOutput,
+            nmsBoxesOutput, stream);
+    }
+    else
+    {
+        status = EfficientNMSLauncher<T>(param, topNumData, outputIndexData, outputClassData, indexDB.Current(),
+            scoresDB.Current(), topClassData, topAnchorsData, boxesInput, anchorsInput, (int*) numDetectionsOutput,
+            (T*) nmsScoresOutput, (int*) nmsClassesOutput, (int*) nmsIndicesOutput, nmsBoxesOutput, stream);
+    }
     CSC(status, STATUS_FAILURE);
 
     return STATUS_SUCCESS;
 }
 
 pluginStatus_t EfficientIdxNMSInference(EfficientIdxNMSParameters param, const void* boxesInput, const void* scoresInput,
-    const void* anchorsInput, void* numDetectionsOutput, void* nmsBoxesOutput, void* nmsScoresOutput,
-    void* nmsClassesOutput, void* nmsIndicesOutput, void* workspace, cudaStream_t stream)
+    const void* anchorsInput, const void* thresholdsInput, void* numDetectionsOutput, void* nmsBoxesOutput,
+    void* nmsScoresOutput, void* nmsClassesOutput, void* nmsIndicesOutput, void* workspace, cudaStream_t stream)
 {
+    param.thresholds = param.runtimeThresholds ? (const float*) thresholdsInput : nullptr;
+
+    if (param.nmsAlgorithm == 1)
+    {
+        // Same candidate cap as the serial algorithm, bounded by the shared memory of the reduce kernel. The
+        // workspace is sized with the same bound, see EfficientIdxNMSWorkspaceSize.
+        param.numSelectedBoxes = EfficientIdxNMSBitmaskBoxes(param.numSelectedBoxes, param.numScoreElements);
+    }
+
     if (param.datatype == DataType::kFLOAT)
     {
         param.scoreBits = -1;
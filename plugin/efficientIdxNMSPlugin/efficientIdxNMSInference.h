@@ -22,11 +22,13 @@
 
 #include "efficientIdxNMSParameters.h"
 
-size_t EfficientIdxNMSWorkspaceSize(
-    int32_t batchSize, int32_t numScoreElements, int32_t numClasses, nvinfer1::DataType datatype);
+size_t EfficientIdxNMSWorkspaceSize(int32_t batchSize, int32_t numScoreElements, int32_t numClasses,
+    nvinfer1::DataType datatype, int32_t nmsAlgorithm = 0, int32_t numDecodedAnchors = 0,
+    int32_t numSelectedBoxes = nvinfer1::plugin::kEFFICIENT_IDX_NMS_BITMASK_MAX_BOXES);
 
 pluginStatus_t EfficientIdxNMSInference(nvinfer1::plugin::EfficientIdxNMSParameters param, void const* boxesInput,
-    void const* scoresInput, void const* anchorsInput, void* numDetectionsOutput, void* nmsBoxesOutput,
-    void* nmsScoresOutput, void* nmsClassesOutput, void* nmsIndicesOutput, void* workspace, cudaStream_t stream);
+    void const* scoresInput, void const* anchorsInput, void const* thresholdsInput, void* numDetectionsOutput,
+    void* nmsBoxesOutput, void* nmsScoresOutput, void* nmsClassesOutput, void* nmsIndicesOutput, void* workspace,
+    cudaStream_t stream);
 
 #endif
@@ -18,6 +18,8 @@
 #ifndef TRT_EFFICIENT_IDX_NMS_PARAMETERS_H
 #define TRT_EFFICIENT_IDX_NMS_PARAMETERS_H
 
+#include <algorithm>
+
 #include "common/plugin.h"
 
 namespace nvinfer1
@@ -25,6 +27,32 @@ namespace nvinfer1
 namespace plugin
 {
 
+// Upper bound of numSelectedBoxes with the bitmask NMS algorithm (nmsAlgorithm = 1), set by the shared memory bits of
+// the reduce kernel. Below it, the bitmask algorithm keeps the numSelectedBoxes candidates of the serial one, so both
+// select the same detections. The suppression mask of an image takes N * ceil(N / 64) 64-bit words of workspace,
+// with N = min(numSelectedBoxes, numScoreElements, 8192): 3 MiB at 5000 candidates, 8 MiB at this bound.
+constexpr int32_t kEFFICIENT_IDX_NMS_BITMASK_MAX_BOXES{8192};
+
+// Candidate cap of the bitmask NMS algorithm, which sizes its suppression mask.
+inline int32_t EfficientIdxNMSBitmaskBoxes(int32_t numSelectedBoxes, int32_t numScoreElements)
+{
+    return std::min(std::min(numSelectedBoxes, numScoreElements), kEFFICIENT_IDX_NMS_BITMASK_MAX_BOXES);
+}
+
+// Layout of the thresholds input of runtime_thresholds plugins, a float32 tensor of shape [3 + numClasses].
+// Negative values keep the threshold given as plugin attribute. A class score threshold only applies to its class
+// when it is higher than the score threshold. The number of output boxes can only be lowered, as it sizes the outputs.
+constexpr int32_t kEFFICIENT_IDX_NMS_THRESHOLD_IOU{0};
+constexpr int32_t kEFFICIENT_IDX_NMS_THRESHOLD_SCORE{1};
+constexpr int32_t kEFFICIENT_IDX_NMS_THRESHOLD_MAX_OUTPUT_BOXES{2};
+constexpr int32_t kEFFICIENT_IDX_NMS_THRESHOLD_CLASS_SCORES{3};
+
+// Box coding of raw DFL (Distribution Focal Loss) head outputs, as produced by YOLOv8 and later detection heads.
+// The boxes input holds the [batchSize, 4 * regMax, numAnchors] logits of the left, top, right and bottom distance
+// distributions and the anchors input the [1, numAnchors, 3] anchor points and strides (x, y, stride, in grid cell
+// units). Only the candidates that reach NMS are decoded, to x1, y1, x2, y2 corners.
+constexpr int32_t kEFFICIENT_IDX_NMS_BOX_CODING_DFL{2};
+
 struct EfficientIdxNMSParameters
 {
     // Related to NMS Options
@@ -38,9 +66,11 @@ struct EfficientIdxNMSParameters
     bool clipBoxes = false;
     int32_t boxCoding = 0;
     bool classAgnostic = false;
+    int32_t nmsAlgorithm = 0;
+    bool runtimeThresholds = false;
 
     // Related to NMS Internals
-    int32_t numSelectedBoxes = 4096;
+    int32_t numSelectedBoxes = 4096; // Candidate cap of each image, set by initialize() from the device
     int32_t scoreBits = -1;
 
     // Related to Tensor Configuration
@@ -50,10 +80,16 @@ struct EfficientIdxNMSParameters
     int32_t numBoxElements = -1;
     int32_t numScoreElements = -1;
     int32_t numAnchors = -1;
+    int32_t regMax = 16;
     bool shareLocation = true;
     bool shareAnchors = true;
     bool boxDecoder = false;
     nvinfer1::DataType datatype = nvinfer1::DataType::kFLOAT;
+
+    // Related to Runtime Thresholds
+    // (Points to the thresholds input during inference, device memory for the plugin and host memory for the
+    // reference. Null when the plugin was created without runtime_thresholds.)
+    float const* thresholds = nullptr;
 };
 
 } // namespace plugin
@@ -27,6 +27,27 @@ namespace
 {
 char const* const kEFFICIENT_IDX_NMS_PLUGIN_VERSION{"1"};
 char const* const kEFFICIENT_IDX_NMS_PLUGIN_NAME{"EfficientIdxNMS_TRT"};
+
+// Candidate cap of the serial NMS kernel on the current device, bound by the registers of its single block per image.
+// Also the cap of the bitmask kernel, whose workspace is sized before initialize() runs.
+int32_t EfficientIdxNMSSelectedBoxes(int32_t& numSelectedBoxes)
+{
+    int32_t device;
+    CSC(cudaGetDevice(&device), STATUS_FAILURE);
+    struct cudaDeviceProp properties;
+    CSC(cudaGetDeviceProperties(&properties, device), STATUS_FAILURE);
+    if (properties.regsPerBlock >= 65536)
+    {
+        // Most Devices
+        numSelectedBoxes = 5000;
+    }
+    else
+    {
+        // Jetson TX1/TX2
+        numSelectedBoxes = 2000;
+    }
+    return STATUS_SUCCESS;
+}
 } // namespace
 
 REGISTER_TENSORRT_PLUGIN(EfficientIdxNMSPluginCreator);
@@ -68,19 +89,10 @@ int32_t EfficientIdxNMSPlugin::initialize() noexcept
 {
     if (!initialized)
     {
-        int32_t device;
-        CSC(cudaGetDevice(&device), STATUS_FAILURE);
-        struct cudaDeviceProp properties;
-        CSC(cudaGetDeviceProperties(&properties, device), STATUS_FAILURE);
-        if (properties.regsPerBlock >= 65536)
+        int32_t status = EfficientIdxNMSSelectedBoxes(mParam.numSelectedBoxes);
+        if (status != STATUS_SUCCESS)
         {
-            // Most Devices
-            mParam.numSelectedBoxes = 5000;
-        }
-        else
-        {
-            // Jetson TX1/TX2
-            mParam.numSelectedBoxes = 2000;
+            return status;
         }
         initialized = true;
     }
@@ -216,15 +228,14 @@ bool EfficientIdxNMSPlugin::supportsFormatCombination(
         return false;
     }
 
-    PLUGIN_ASSERT(nbInputs == 2 || nbInputs == 3);
+    PLUGIN_ASSERT(nbInputs >= 2 && nbInputs <= (mParam.runtimeThresholds ? 4 : 3));
     PLUGIN_ASSERT(nbOutputs == 5);
-    if (nbInputs == 2)
-    {
-        PLUGIN_ASSERT(0 <= pos && pos <= 6);
-    }
-    if (nbInputs == 3)
+    PLUGIN_ASSERT(0 <= pos && pos < nbInputs + nbOutputs);
+
+    // nms_thresholds input: fp32
+    if (mParam.runtimeThresholds && pos == nbInputs - 1)
     {
-        PLUGIN_ASSERT(0 <= pos && pos <= 7);
+        return inOut[pos].type == DataType::kFLOAT;
     }
 
     // num_detections, detection_classes and detection_indices output: int32_t
@@ -247,7 +258,8 @@ void EfficientIdxNMSPlugin::configurePlugin(
         // Accepts two or three inputs
         // If two inputs: [0] boxes, [1] scores
         // If three inputs: [0] boxes, [1] scores, [2] anchors
-        PLUGIN_ASSERT(nbInputs == 2 || nbInputs == 3);
+        // With runtime thresholds, the thresholds input is appended as the last input
+        PLUGIN_ASSERT(nbInputs >= 2 && nbInputs <= (mParam.runtimeThresholds ? 4 : 3));
         PLUGIN_ASSERT(nbOutputs == 5);
 
         mParam.datatype = in[0].desc.type;
@@ -271,8 +283,18 @@ void EfficientIdxNMSPlugin::configurePlugin(
 
         // Shape of boxes input should be
         // [batch_size, num_boxes, 4] or [batch_size, num_boxes, 1, 4] or [batch_size, num_boxes, num_classes, 4]
+        // With DFL box coding: [batch_size, 4 * reg_max, num_boxes]
         PLUGIN_ASSERT(in[0].desc.dims.nbDims == 3 || in[0].desc.dims.nbDims == 4);
-        if (in[0].desc.dims.nbDims == 3)
+        if (mParam.boxCoding == kEFFICIENT_IDX_NMS_BOX_CODING_DFL)
+        {
+            PLUGIN_ASSERT(in[0].desc.dims.nbDims == 3);
+            PLUGIN_ASSERT(in[0].desc.dims.d[1] % 4 == 0);
+            PLUGIN_ASSERT(in[0].desc.dims.d[2] == in[1].desc.dims.d[1]);
+            mParam.shareLocation = true;
+            mParam.regMax = in[0].desc.dims.d[1] / 4;
+            mParam.numBoxElements = in[0].desc.dims.d[1] * in[0].desc.dims.d[2];
+        }
+        else if (in[0].desc.dims.nbDims == 3)
         {
             PLUGIN_ASSERT(in[0].desc.dims.d[2] == 4);
             mParam.shareLocation = true;
@@ -285,11 +307,24 @@ void EfficientIdxNMSPlugin::configurePlugin(
             PLUGIN_ASSERT(in[0].desc.dims.d[3] == 4);
             mParam.numBoxElements = in[0].desc.dims.d[1] * in[0].desc.dims.d[2] * in[0].desc.dims.d[3];
         }
-        mParam.numAnchors = in[0].desc.dims.d[1];
+        mParam.numAnchors = in[1].desc.dims.d[1];
+
+        if (mParam.runtimeThresholds)
+        {
+            // Shape of thresholds input should be
+            // [3 + num_classes]: iou threshold, score threshold, max output boxes, then one score threshold per class
+            PLUGIN_ASSERT(nbInputs >= 3);
+            DynamicPluginTensorDesc const& thresholds = in[nbInputs - 1];
+            PLUGIN_ASSERT(thresholds.desc.dims.nbDims == 1);
+            PLUGIN_ASSERT(thresholds.desc.dims.d[0] == kEFFICIENT_IDX_NMS_THRESHOLD_CLASS_SCORES + mParam.numClasses);
+            nbInputs--;
+        }
 
         if (nbInputs == 2)
         {
             // Only two inputs are used, disable the fused box decoder
+            // The DFL box coding can not be decoded without anchor points and strides
+            PLUGIN_ASSERT(mParam.boxCoding != kEFFICIENT_IDX_NMS_BOX_CODING_DFL);
             mParam.boxDecoder = false;
         }
         if (nbInputs == 3)
@@ -297,7 +332,9 @@ void EfficientIdxNMSPlugin::configurePlugin(
             // All three inputs are used, enable the box decoder
             // Shape of anchors input should be
             // Constant shape: [1, numAnchors, 4] or [batch_size, numAnchors, 4]
+            // With DFL box coding: [1, numAnchors, 3] or [batch_size, numAnchors, 3], holding x, y and stride
             PLUGIN_ASSERT(in[2].desc.dims.nbDims == 3);
+            PLUGIN_ASSERT(in[2].desc.dims.d[2] == (mParam.boxCoding == kEFFICIENT_IDX_NMS_BOX_CODING_DFL ? 3 : 4));
             mParam.boxDecoder = true;
             mParam.shareAnchors = (in[2].desc.dims.d[0] == 1);
         }
@@ -314,7 +351,16 @@ size_t EfficientIdxNMSPlugin::getWorkspaceSize(
     int32_t batchSize = inputs[1].dims.d[0];
     int32_t numScoreElements = inputs[1].dims.d[1] * inputs[1].dims.d[2];
     int32_t numClasses = inputs[1].dims.d[2];
-    return EfficientIdxNMSWorkspaceSize(batchSize, numScoreElements, numClasses, mParam.datatype);
+    // The DFL box coding decodes the candidates into a boxes buffer of the workspace
+    int32_t numDecodedAnchors = mParam.boxCoding == kEFFICIENT_IDX_NMS_BOX_CODING_DFL ? inputs[1].dims.d[1] : 0;
+    // The bitmask mask is sized for the candidate cap initialize() sets, falling back to the largest one it allows
+    int32_t numSelectedBoxes = mParam.numSelectedBoxes;
+    if (!initialized && EfficientIdxNMSSelectedBoxes(numSelectedBoxes) != STATUS_SUCCESS)
+    {
+        numSelectedBoxes = kEFFICIENT_IDX_NMS_BITMASK_MAX_BOXES;
+    }
+    return EfficientIdxNMSWorkspaceSize(batchSize, numScoreElements, numClasses, mParam.datatype, mParam.nmsAlgorithm,
+        numDecodedAnchors, numSelectedBoxes);
 }
 
 int32_t EfficientIdxNMSPlugin::enqueue(PluginTensorDesc const* inputDesc, PluginTensorDesc const* /* outputDesc */,
@@ -330,6 +376,7 @@ int32_t EfficientIdxNMSPlugin::enqueue(PluginTensorDesc const* inputDesc, Plugin
         void const* const boxesInput = inputs[0];
         void const* const scoresInput = inputs[1];
         void const* const anchorsInput = mParam.boxDecoder ? inputs[2] : nullptr;
+        void const* const thresholdsInput = mParam.runtimeThresholds ? inputs[mParam.boxDecoder ? 3 : 2] : nullptr;
 
         void* numDetectionsOutput = outputs[0];
         void* nmsBoxesOutput = outputs[1];
@@ -337,8 +384,8 @@ int32_t EfficientIdxNMSPlugin::enqueue(PluginTensorDesc const* inputDesc, Plugin
         void* nmsClassesOutput = outputs[3];
         void* nmsIndicesOutput = outputs[4];
 
-        return EfficientIdxNMSInference(mParam, boxesInput, scoresInput, anchorsInput, numDetectionsOutput, nmsBoxesOutput,
-            nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput, workspace, stream);
+        return EfficientIdxNMSInference(mParam, boxesInput, scoresInput, anchorsInput, thresholdsInput,
+            numDetectionsOutput, nmsBoxesOutput, nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput, workspace, stream);
     }
     catch (std::exception const& e)
     {
@@ -360,6 +407,8 @@ EfficientIdxNMSPluginCreator::EfficientIdxNMSPluginCreator()
     mPluginAttributes.emplace_back(PluginField("score_activation", nullptr, PluginFieldType::kINT32, 1));
     mPluginAttributes.emplace_back(PluginField("class_agnostic", nullptr, PluginFieldType::kINT32, 1));
     mPluginAttributes.emplace_back(PluginField("box_coding", nullptr, PluginFieldType::kINT32, 1));
+    mPluginAttributes.emplace_back(PluginField("nms_algorithm", nullptr, PluginFieldType::kINT32, 1));
+    mPluginAttributes.emplace_back(PluginField("runtime_thresholds", nullptr, PluginFieldType::kINT32, 1));
     mFC.nbFields = mPluginAttributes.size();
     mFC.fields = mPluginAttributes.data();
 }
@@ -434,9 +483,23 @@ IPluginV2DynamicExt* EfficientIdxNMSPluginCreator::createPlugin(char const* name
             {
                 PLUGIN_VALIDATE(fields[i].type == PluginFieldType::kINT32);
                 auto const boxCoding = *(static_cast<int32_t const*>(fields[i].data));
-                PLUGIN_VALIDATE(boxCoding == 0 || boxCoding == 1);
+                PLUGIN_VALIDATE(boxCoding == 0 || boxCoding == 1 || boxCoding == kEFFICIENT_IDX_NMS_BOX_CODING_DFL);
                 mParam.boxCoding = boxCoding;
             }
+            if (!strcmp(attrName, "nms_algorithm"))
+            {
+                PLUGIN_VALIDATE(fields[i].type == PluginFieldType::kINT32);
+                auto const nmsAlgorithm = *(static_cast<int32_t const*>(fields[i].data));
+                PLUGIN_VALIDATE(nmsAlgorithm == 0 || nmsAlgorithm == 1);
+                mParam.nmsAlgorithm = nmsAlgorithm;
+            }
+            if (!strcmp(attrName, "runtime_thresholds"))
+            {
+                PLUGIN_VALIDATE(fields[i].type == PluginFieldType::kINT32);
+                auto const runtimeThresholds = *(static_cast<int32_t const*>(fields[i].data));
+                PLUGIN_VALIDATE(runtimeThresholds == 0 || runtimeThresholds == 1);
+                mParam.runtimeThresholds = static_cast<bool>(runtimeThresholds);
+            }
         }
 
         auto* plugin = new EfficientIdxNMSPlugin(mParam);
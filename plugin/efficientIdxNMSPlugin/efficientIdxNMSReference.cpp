@@ -0,0 +1,626 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "common/nmsTileQueue.h"
+#include "common/topKSelect.h"
+
+#include "efficientIdxNMSReference.h"
+
+using namespace nvinfer1;
+using namespace nvinfer1::plugin;
+
+namespace
+{
+
+struct ReferenceCandidate
+{
+    float score;     // Score as seen by the NMS kernel (raw, logit or score + 1 with scoreBits)
+    int32_t key;     // Quantized sort key, only used with scoreBits
+    int32_t classIdx;
+    int32_t anchorIdx;
+};
+
+struct ReferenceBox
+{
+    // For NMS/IOU purposes, YXYX coding is identical to XYXY
+    float y1, x1, y2, x2;
+};
+
+// Rounds a float to the nearest value representable in half precision (round to nearest even).
+float roundToHalf(float value)
+{
+    if (!std::isfinite(value) || value == 0.f)
+    {
+        return value;
+    }
+    int exponent = 0;
+    std::frexp(value, &exponent);
+    // Half precision keeps 11 significant bits, subnormals have a fixed step of 2^-24.
+    float const step = std::ldexp(1.f, std::max(exponent - 11, -24));
+    float const rounded = std::nearbyint(value / step) * step;
+    return std::fabs(rounded) > 65504.f ? std::copysign(INFINITY, value) : rounded;
+}
+
+float sigmoid(float value)
+{
+    return 1.f / (1.f + std::exp(-value));
+}
+
+void reorder(ReferenceBox& box)
+{
+    if (box.y1 > box.y2)
+    {
+        std::swap(box.y1, box.y2);
+    }
+    if (box.x1 > box.x2)
+    {
+        std::swap(box.x1, box.x2);
+    }
+}
+
+float area(ReferenceBox const& box)
+{
+    float const w = box.x2 - box.x1;
+    float const h = box.y2 - box.y1;
+    if (h <= 0.f || w <= 0.f)
+    {
+        return 0.f;
+    }
+    return h * w;
+}
+
+float IOU(ReferenceBox b1, ReferenceBox b2)
+{
+    // Regardless of the selected box coding, IOU is always performed in BoxCorner coding.
+    reorder(b1);
+    reorder(b2);
+    ReferenceBox const intersection{std::max(b1.y1, b2.y1), std::max(b1.x1, b2.x1), std::min(b1.y2, b2.y2),
+        std::min(b1.x2, b2.x2)};
+    float const intersectArea = area(intersection);
+    if (intersectArea <= 0.f)
+    {
+        return 0.f;
+    }
+    float const unionArea = area(b1) + area(b2) - intersectArea;
+    if (unionArea <= 0.f)
+    {
+        return 0.f;
+    }
+    return intersectArea / unionArea;
+}
+
+ReferenceBox DecodeBox(EfficientIdxNMSParameters const& param, float const* box, float const* anchor)
+{
+    // The inputs are in the selected coding format, but the decoded box is always returned as BoxCorner.
+    if (param.boxCoding == 0)
+    {
+        ReferenceBox corner{box[0], box[1], box[2], box[3]};
+        if (param.boxDecoder)
+        {
+            ReferenceBox prior{anchor[0], anchor[1], anchor[2], anchor[3]};
+            reorder(corner);
+            reorder(prior);
+            corner = {corner.y1 + prior.y1, corner.x1 + prior.x1, corner.y2 + prior.y2, corner.x2 + prior.x2};
+        }
+        return corner;
+    }
+
+    float y = box[0];
+    float x = box[1];
+    float h = box[2];
+    float w = box[3];
+    if (param.boxDecoder)
+    {
+        y = y * anchor[2] + anchor[0];
+        x = x * anchor[3] + anchor[1];
+        h = anchor[2] * std::exp(h);
+        w = anchor[3] * std::exp(w);
+    }
+    return {y - h * 0.5f, x - w * 0.5f, y + h * 0.5f, x + w * 0.5f};
+}
+
+ReferenceBox DecodeDFLBox(EfficientIdxNMSParameters const& param, float const* logits, float const* anchor)
+{
+    // Same as EfficientNMSDecodeDFL: logits points at the first bin of the anchor, bins are numAnchors apart.
+    float distance[4];
+    for (int32_t side = 0; side < 4; side++)
+    {
+        float const* bins = logits + static_cast<size_t>(side) * param.regMax * param.numAnchors;
+        if (param.regMax == 1)
+        {
+            distance[side] = bins[0];
+            continue;
+        }
+        float maxLogit = bins[0];
+        for (int32_t bin = 1; bin < param.regMax; bin++)
+        {
+            maxLogit = std::max(maxLogit, bins[static_cast<size_t>(bin) * param.numAnchors]);
+        }
+        float sum = 0.f;
+        float weighted = 0.f;
+        for (int32_t bin = 0; bin < param.regMax; bin++)
+        {
+            float const e = std::exp(bins[static_cast<size_t>(bin) * param.numAnchors] - maxLogit);
+            sum += e;
+            weighted += e * static_cast<float>(bin);
+        }
+        distance[side] = weighted / sum;
+    }
+    float const x = anchor[0];
+    float const y = anchor[1];
+    float const stride = anchor[2];
+    // For NMS/IOU purposes, YXYX coding is identical to XYXY, the decoded box is x1, y1, x2, y2
+    return {(x - distance[0]) * stride, (y - distance[1]) * stride, (x + distance[2]) * stride,
+        (y + distance[3]) * stride};
+}
+
+// Candidates of an image that reach NMS, in sorted order, with their decoded boxes and the suppression mask of the
+// bitmask algorithm.
+struct ReferenceImage
+{
+    std::vector<ReferenceCandidate> candidates;
+    std::vector<ReferenceBox> boxes;
+    std::vector<int32_t> boxIdxMap;
+    std::vector<uint64_t> mask;
+    int32_t numBlocks{0};
+};
+
+// Width of the tiles and mask words of the bitmask algorithm, same as NMS_BITMASK_BLOCK.
+int32_t const kReferenceBlockBits = 64;
+
+// Runs body(0) .. body(count - 1) on up to numThreads threads, returns false if any call threw.
+template <typename Body>
+bool ReferenceParallelFor(int32_t count, int32_t numThreads, Body const& body)
+{
+    std::atomic<int32_t> next{0};
+    std::atomic<bool> failed{false};
+    auto const worker = [&]() {
+        try
+        {
+            for (int32_t idx = next++; idx < count; idx = next++)
+            {
+                body(idx);
+            }
+        }
+        catch (...)
+        {
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int32_t i = 1; i < std::min(numThreads, count); i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    return !failed;
+}
+
+float StoreValue(bool half, float value)
+{
+    return half ? roundToHalf(value) : value;
+}
+
+// Filter, top-K preselection, sort and decode of an image, the stages before NMS.
+void EfficientNMSReferencePrepare(EfficientIdxNMSParameters const& param, bool half, bool dense,
+    std::vector<float> const& scoreThresholds, int32_t imageIdx, float const* boxesInput, float const* scoresInput,
+    float const* anchorsInput, ReferenceImage& image)
+{
+    auto const store = [half](float value) { return StoreValue(half, value); };
+    auto const bump = [&](float score) {
+        // Ensure the incremented score fits in the mantissa without changing the exponent
+        return std::min(store(score + 1.f), 2.f - 1.f / 1024.f);
+    };
+    auto const sortKey = [&](float score) {
+        // The radix sort only looks at the top scoreBits bits of the half precision mantissa
+        return static_cast<int32_t>(std::nearbyint((score - 1.f) * 1024.f)) >> (10 - param.scoreBits);
+    };
+
+    // Filter: select the candidates of this image, in element order.
+    std::vector<ReferenceCandidate>& candidates = image.candidates;
+    candidates.reserve(dense ? param.numScoreElements : 0);
+    float const* scores = scoresInput + static_cast<size_t>(imageIdx) * param.numScoreElements;
+    for (int32_t elementIdx = 0; elementIdx < param.numScoreElements; elementIdx++)
+    {
+        int32_t const classIdx = elementIdx % param.numClasses;
+        int32_t const anchorIdx = elementIdx / param.numClasses;
+        float score = store(scores[elementIdx]);
+        bool const selected = score >= scoreThresholds[classIdx] && classIdx != param.backgroundClass;
+        if (!selected && !dense)
+        {
+            continue;
+        }
+        if (param.scoreBits > 0)
+        {
+            score = selected ? bump(score) : 1.f;
+        }
+        else if (!selected)
+        {
+            score = -(1 << 15);
+        }
+        int32_t const key = param.scoreBits > 0 ? sortKey(score) : 0;
+        candidates.push_back({score, key, classIdx, anchorIdx});
+    }
+
+    // Top-K preselection, same as TopKSelect: keep the numSelectedBoxes highest keys in element order.
+    int32_t const maxSelectedBoxes = std::max(param.numSelectedBoxes, 0);
+    if (static_cast<int32_t>(candidates.size()) > maxSelectedBoxes)
+    {
+        std::vector<uint32_t> keys(candidates.size());
+        for (size_t i = 0; i < candidates.size(); i++)
+        {
+            keys[i] = param.scoreBits > 0 ? static_cast<uint32_t>(candidates[i].key)
+                                          : topKSelectKey(candidates[i].score);
+        }
+        std::vector<int32_t> selected(maxSelectedBoxes);
+        int32_t const numSelected = topKSelectReference(keys.data(), static_cast<int32_t>(keys.size()),
+            maxSelectedBoxes, param.scoreBits > 0 ? param.scoreBits : 32, selected.data());
+        for (int32_t i = 0; i < numSelected; i++)
+        {
+            candidates[i] = candidates[selected[i]];
+        }
+        candidates.resize(numSelected);
+    }
+
+    // Sort: descending by score, candidates with equal keys keep their element order.
+    if (param.scoreBits > 0)
+    {
+        std::stable_sort(candidates.begin(), candidates.end(),
+            [](ReferenceCandidate const& a, ReferenceCandidate const& b) { return a.key > b.key; });
+    }
+    else
+    {
+        std::stable_sort(candidates.begin(), candidates.end(),
+            [](ReferenceCandidate const& a, ReferenceCandidate const& b) { return a.score > b.score; });
+    }
+    int32_t const numSelectedBoxes = static_cast<int32_t>(candidates.size());
+
+    // Decode the boxes of the selected candidates, the only ones that reach NMS.
+    bool const dfl = param.boxCoding == kEFFICIENT_IDX_NMS_BOX_CODING_DFL;
+    image.boxes.resize(numSelectedBoxes);
+    image.boxIdxMap.resize(numSelectedBoxes);
+    for (int32_t i = 0; i < numSelectedBoxes; i++)
+    {
+        ReferenceCandidate const& candidate = candidates[i];
+        if (dfl || param.shareLocation) // Shape of boxesInput: [batchSize, numAnchors, 1, 4]
+        {
+            image.boxIdxMap[i] = imageIdx * param.numAnchors + candidate.anchorIdx;
+        }
+        else // Shape of boxesInput: [batchSize, numAnchors, numClasses, 4]
+        {
+            image.boxIdxMap[i]
+                = (imageIdx * param.numAnchors + candidate.anchorIdx) * param.numClasses + candidate.classIdx;
+        }
+        float const* anchor = nullptr;
+        if (param.boxDecoder)
+        {
+            int32_t const anchorIdxMap
+                = param.shareAnchors ? candidate.anchorIdx : imageIdx * param.numAnchors + candidate.anchorIdx;
+            anchor = anchorsInput + static_cast<size_t>(anchorIdxMap) * (dfl ? 3 : 4);
+        }
+        if (dfl) // Shape of boxesInput: [batchSize, 4 * regMax, numAnchors]
+        {
+            float const* logits = boxesInput + static_cast<size_t>(imageIdx) * 4 * param.regMax * param.numAnchors
+                + candidate.anchorIdx;
+            image.boxes[i] = DecodeDFLBox(param, logits, anchor);
+        }
+        else
+        {
+            image.boxes[i] = DecodeBox(param, boxesInput + static_cast<size_t>(image.boxIdxMap[i]) * 4, anchor);
+        }
+    }
+
+    if (param.nmsAlgorithm == 1)
+    {
+        image.numBlocks = (numSelectedBoxes + kReferenceBlockBits - 1) / kReferenceBlockBits;
+        image.mask.assign(static_cast<size_t>(numSelectedBoxes) * image.numBlocks, 0);
+    }
+}
+
+// Whether the kept candidate i suppresses the lower scored candidate j of its class.
+bool Suppresses(EfficientIdxNMSParameters const& param, ReferenceImage const& image, int32_t i, int32_t j)
+{
+    ReferenceCandidate const& kept = image.candidates[i];
+    ReferenceCandidate const& other = image.candidates[j];
+    return (param.classAgnostic || other.classIdx == kept.classIdx) && other.score <= kept.score
+        && IOU(image.boxes[j], image.boxes[i]) >= param.iouThreshold;
+}
+
+// Simulation of one tile of EfficientNMSBitmask: the suppression bits of a block of rows against a block of later
+// columns, in 64-bit words.
+void EfficientNMSReferenceMaskTile(
+    EfficientIdxNMSParameters const& param, ReferenceImage& image, int32_t rowBlock, int32_t colBlock)
+{
+    int32_t const numSelectedBoxes = static_cast<int32_t>(image.candidates.size());
+    int32_t const rowEnd = std::min((rowBlock + 1) * kReferenceBlockBits, numSelectedBoxes);
+    int32_t const colEnd = std::min((colBlock + 1) * kReferenceBlockBits, numSelectedBoxes);
+    for (int32_t i = rowBlock * kReferenceBlockBits; i < rowEnd; i++)
+    {
+        for (int32_t j = std::max(colBlock * kReferenceBlockBits, i + 1); j < colEnd; j++)
+        {
+            if (Suppresses(param, image, i, j))
+            {
+                image.mask[static_cast<size_t>(i) * image.numBlocks + colBlock]
+                    |= uint64_t{1} << (j % kReferenceBlockBits);
+            }
+        }
+    }
+}
+
+// NMS selection and output of an image, after its mask is complete with the bitmask algorithm.
+void EfficientNMSReferenceSelect(EfficientIdxNMSParameters const& param, bool half, int32_t numOutputBoxes,
+    int32_t imageIdx, ReferenceImage const& image, int32_t* numDetectionsOutput, float* nmsBoxesOutput,
+    float* nmsScoresOutput, int32_t* nmsClassesOutput, int32_t* nmsIndicesOutput)
+{
+    auto const store = [half](float value) { return StoreValue(half, value); };
+    int32_t const numSelectedBoxes = static_cast<int32_t>(image.candidates.size());
+
+    std::vector<int32_t> classCounters(param.numOutputBoxesPerClass >= 0 ? param.numClasses : 0, 0);
+    int32_t resultsCounter = 0;
+    auto const keep = [&](int32_t i) {
+        ReferenceCandidate const& candidate = image.candidates[i];
+        // With the per-class limit, a kept box is not necessarily written but it still suppresses others.
+        if (param.numOutputBoxesPerClass >= 0 && classCounters[candidate.classIdx]++ >= param.numOutputBoxesPerClass)
+        {
+            return;
+        }
+
+        int32_t const outputIdx = imageIdx * param.numOutputBoxes + resultsCounter++;
+        if (param.scoreSigmoid)
+        {
+            nmsScoresOutput[outputIdx] = store(sigmoid(candidate.score));
+        }
+        else if (param.scoreBits > 0)
+        {
+            nmsScoresOutput[outputIdx] = store(candidate.score - 1.f);
+        }
+        else
+        {
+            nmsScoresOutput[outputIdx] = candidate.score;
+        }
+        nmsClassesOutput[outputIdx] = candidate.classIdx;
+        ReferenceBox box = image.boxes[i];
+        if (param.clipBoxes)
+        {
+            box = {std::min(std::max(box.y1, 0.f), 1.f), std::min(std::max(box.x1, 0.f), 1.f),
+                std::min(std::max(box.y2, 0.f), 1.f), std::min(std::max(box.x2, 0.f), 1.f)};
+        }
+        float* output = nmsBoxesOutput + static_cast<size_t>(outputIdx) * 4;
+        output[0] = store(box.y1);
+        output[1] = store(box.x1);
+        output[2] = store(box.y2);
+        output[3] = store(box.x2);
+        nmsIndicesOutput[outputIdx] = image.boxIdxMap[i] % param.numAnchors;
+    };
+
+    if (param.nmsAlgorithm == 1)
+    {
+        // Simulation of EfficientNMSBitmaskReduce: a sequential pass that only ORs mask rows together.
+        std::vector<uint64_t> removed(image.numBlocks, 0);
+        for (int32_t i = 0; i < numSelectedBoxes; i++)
+        {
+            if (removed[i / kReferenceBlockBits] & (uint64_t{1} << (i % kReferenceBlockBits)))
+            {
+                continue;
+            }
+            if (resultsCounter >= numOutputBoxes)
+            {
+                break;
+            }
+            for (int32_t block = i / kReferenceBlockBits; block < image.numBlocks; block++)
+            {
+                removed[block] |= image.mask[static_cast<size_t>(i) * image.numBlocks + block];
+            }
+            keep(i);
+        }
+    }
+    else
+    {
+        // Greedy selection in sorted order, same as the serial EfficientNMS kernel.
+        std::vector<int8_t> dropped(numSelectedBoxes, 0);
+        for (int32_t i = 0; i < numSelectedBoxes; i++)
+        {
+            if (dropped[i])
+            {
+                continue;
+            }
+            if (resultsCounter >= numOutputBoxes)
+            {
+                break;
+            }
+            keep(i);
+            for (int32_t j = i + 1; j < numSelectedBoxes; j++)
+            {
+                if (!dropped[j] && Suppresses(param, image, i, j))
+                {
+                    dropped[j] = 1;
+                }
+            }
+        }
+    }
+    numDetectionsOutput[imageIdx] = resultsCounter;
+}
+
+} // namespace
+
+pluginStatus_t EfficientIdxNMSReference(EfficientIdxNMSParameters param, float const* boxesInput,
+    float const* scoresInput, float const* anchorsInput, int32_t* numDetectionsOutput, float* nmsBoxesOutput,
+    float* nmsScoresOutput, int32_t* nmsClassesOutput, int32_t* nmsIndicesOutput, int32_t numThreads)
+{
+    if (!numDetectionsOutput || !nmsBoxesOutput || !nmsScoresOutput || !nmsClassesOutput || !nmsIndicesOutput
+        || param.batchSize < 0 || param.numOutputBoxes < 0)
+    {
+        return STATUS_BAD_PARAM;
+    }
+
+    bool half = false;
+    if (param.datatype == DataType::kFLOAT)
+    {
+        param.scoreBits = -1;
+    }
+    else if (param.datatype == DataType::kHALF)
+    {
+        half = true;
+        if (param.scoreBits <= 0 || param.scoreBits > 10)
+        {
+            param.scoreBits = -1;
+        }
+    }
+    else
+    {
+        return STATUS_NOT_SUPPORTED;
+    }
+
+    // Clear Outputs (not all elements will get overwritten, same as the plugin)
+    size_t const numOutputs = static_cast<size_t>(param.batchSize) * param.numOutputBoxes;
+    std::fill_n(numDetectionsOutput, param.batchSize, 0);
+    std::fill_n(nmsBoxesOutput, numOutputs * 4, 0.f);
+    std::fill_n(nmsScoresOutput, numOutputs, 0.f);
+    std::fill_n(nmsClassesOutput, numOutputs, 0);
+    std::fill_n(nmsIndicesOutput, numOutputs, 0);
+
+    // Empty Inputs
+    if (param.numScoreElements < 1)
+    {
+        return STATUS_SUCCESS;
+    }
+    bool const dfl = param.boxCoding == kEFFICIENT_IDX_NMS_BOX_CODING_DFL;
+    if (!boxesInput || !scoresInput || ((param.boxDecoder || dfl) && !anchorsInput) || param.numClasses < 1
+        || (dfl && param.regMax < 1))
+    {
+        return STATUS_BAD_PARAM;
+    }
+
+    if (param.nmsAlgorithm == 1)
+    {
+        // Same candidate cap as the serial algorithm, bounded by the bitmask kernels, see EfficientIdxNMSInference
+        param.numSelectedBoxes = EfficientIdxNMSBitmaskBoxes(param.numSelectedBoxes, param.numScoreElements);
+    }
+
+    // Same threshold handling as EfficientNMSFilterLauncher
+    float scoreThreshold = param.scoreThreshold;
+    float kernelSelectThreshold = 0.007f;
+    if (param.scoreSigmoid)
+    {
+        // Inverse Sigmoid
+        if (param.scoreThreshold <= 0.f)
+        {
+            scoreThreshold = -(1 << 15);
+        }
+        else
+        {
+            scoreThreshold = std::log(param.scoreThreshold / (1.f - param.scoreThreshold));
+        }
+        kernelSelectThreshold = std::log(kernelSelectThreshold / (1.f - kernelSelectThreshold));
+        // Disable Score Bits Optimization
+        param.scoreBits = -1;
+    }
+    // The dense kernel only applies the attribute threshold, runtime thresholds always go through the filter.
+    bool const dense = scoreThreshold < kernelSelectThreshold && !param.thresholds;
+
+    // Same runtime threshold handling as the ScoreThreshold, IOUThreshold and NumOutputBoxes device functions
+    int32_t numOutputBoxes = param.numOutputBoxes;
+    std::vector<float> scoreThresholds(param.numClasses, scoreThreshold);
+    if (param.thresholds)
+    {
+        auto const transform = [&](float threshold) {
+            if (!param.scoreSigmoid)
+            {
+                return threshold;
+            }
+            return threshold <= 0.f ? -(1 << 15) : std::log(threshold / (1.f - threshold));
+        };
+        float const* thresholds = param.thresholds;
+        if (thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_IOU] >= 0.f)
+        {
+            param.iouThreshold = thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_IOU];
+        }
+        if (thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_MAX_OUTPUT_BOXES] >= 0.f)
+        {
+            numOutputBoxes = std::min(
+                static_cast<int32_t>(thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_MAX_OUTPUT_BOXES]), numOutputBoxes);
+        }
+        if (thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_SCORE] >= 0.f)
+        {
+            scoreThreshold = transform(thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_SCORE]);
+        }
+        for (int32_t classIdx = 0; classIdx < param.numClasses; classIdx++)
+        {
+            float const classThreshold = thresholds[kEFFICIENT_IDX_NMS_THRESHOLD_CLASS_SCORES + classIdx];
+            scoreThresholds[classIdx]
+                = classThreshold > 0.f ? std::max(scoreThreshold, transform(classThreshold)) : scoreThreshold;
+        }
+    }
+    if (half)
+    {
+        for (auto& threshold : scoreThresholds)
+        {
+            threshold = roundToHalf(threshold);
+        }
+    }
+
+    if (numThreads <= 0)
+    {
+        numThreads = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1U));
+    }
+
+    // The stages before NMS run image by image. With the bitmask algorithm, the mask tiles of the whole batch are
+    // then drained from a single work queue in the order of EfficientNMSBitmaskTiles, before the reduce pass of
+    // each image.
+    std::vector<ReferenceImage> images(param.batchSize);
+    bool failed = !ReferenceParallelFor(param.batchSize, numThreads, [&](int32_t imageIdx) {
+        EfficientNMSReferencePrepare(param, half, dense, scoreThresholds, imageIdx, boxesInput, scoresInput,
+            anchorsInput, images[imageIdx]);
+    });
+
+    if (!failed && param.nmsAlgorithm == 1)
+    {
+        std::vector<int32_t> numBoxes(param.batchSize);
+        std::vector<int32_t> tileOffsets(param.batchSize + 1, 0);
+        for (int32_t imageIdx = 0; imageIdx < param.batchSize; imageIdx++)
+        {
+            numBoxes[imageIdx] = static_cast<int32_t>(images[imageIdx].candidates.size());
+            tileOffsets[imageIdx + 1] = tileOffsets[imageIdx] + nmsTileCount(numBoxes[imageIdx], kReferenceBlockBits);
+        }
+        // Tiles write disjoint mask words, so they can be processed in any order
+        failed = !ReferenceParallelFor(tileOffsets[param.batchSize], numThreads, [&](int32_t tile) {
+            int32_t imageIdx, rowBlock, colBlock;
+            nmsTileDecode(tile, tileOffsets.data(), param.batchSize, numBoxes.data(), kReferenceBlockBits, imageIdx,
+                rowBlock, colBlock);
+            EfficientNMSReferenceMaskTile(param, images[imageIdx], rowBlock, colBlock);
+        });
+    }
+
+    failed = failed || !ReferenceParallelFor(param.batchSize, numThreads, [&](int32_t imageIdx) {
+        EfficientNMSReferenceSelect(param, half, numOutputBoxes, imageIdx, images[imageIdx], numDetectionsOutput,
+            nmsBoxesOutput, nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput);
+    });
+
+    return failed ? STATUS_FAILURE : STATUS_SUCCESS;
+}
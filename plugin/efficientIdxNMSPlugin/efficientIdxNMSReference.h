@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_EFFICIENT_IDX_NMS_REFERENCE_H
+#define TRT_EFFICIENT_IDX_NMS_REFERENCE_H
+
+#include "common/plugin.h"
+
+#include "efficientIdxNMSParameters.h"
+
+// Host implementation of EfficientIdxNMSInference.
+//
+// All buffers live in host memory and hold float32 values laid out exactly like the plugin tensors:
+//   boxesInput:          [batchSize, numAnchors, 1 or numClasses, 4], or [batchSize, 4 * regMax, numAnchors] with
+//                        the DFL box coding
+//   scoresInput:         [batchSize, numAnchors, numClasses]
+//   anchorsInput:        [1 or batchSize, numAnchors, 4], only read when param.boxDecoder is set, or
+//                        [1 or batchSize, numAnchors, 3] with the DFL box coding
+//   param.thresholds:    [3 + numClasses] or null, the runtime thresholds input (host memory here)
+//   numDetectionsOutput: [batchSize]
+//   nmsBoxesOutput:      [batchSize, numOutputBoxes, 4]
+//   nmsScoresOutput, nmsClassesOutput, nmsIndicesOutput: [batchSize, numOutputBoxes]
+//
+// The filter, sort and NMS stages follow the CUDA kernels step by step, including the dense selection mode
+// used for very low score thresholds, the numSelectedBoxes candidate cap and the per-class output limit.
+// With param.nmsAlgorithm = 1, the bitmask NMS kernels are simulated instead of the serial one, the mask tiles of
+// the whole batch being taken from the same work queue as the kernel (common/nmsTileQueue.h).
+// When param.datatype is kHALF, scores and outputs are rounded to half precision and the scoreBits sort key
+// is emulated, but box arithmetic is still carried out in float32.
+//
+// The only intended difference is the order of candidates with equal scores: the GPU filter appends them
+// through atomics, so their order varies from run to run, while the reference keeps them in element order.
+// Comparisons against the plugin should therefore avoid exact score ties or accept any valid tie order.
+//
+// Images, and mask tiles, are processed in parallel by up to numThreads threads (0 selects the hardware concurrency).
+pluginStatus_t EfficientIdxNMSReference(nvinfer1::plugin::EfficientIdxNMSParameters param, float const* boxesInput,
+    float const* scoresInput, float const* anchorsInput, int32_t* numDetectionsOutput, float* nmsBoxesOutput,
+    float* nmsScoresOutput, int32_t* nmsClassesOutput, int32_t* nmsIndicesOutput, int32_t numThreads = 0);
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_EFFICIENT_ROTATED_NMS_CIRCLE_H
+#define TRT_EFFICIENT_ROTATED_NMS_CIRCLE_H
+
+#include <cmath>
+
+#ifdef __CUDACC__
+#define ROTATED_NMS_CIRCLE_FUNC __host__ __device__ inline
+#else
+#define ROTATED_NMS_CIRCLE_FUNC inline
+#endif
+
+namespace nvinfer1
+{
+namespace plugin
+{
+
+// Early rejection of the exact IoU, shared by the kernel and the host reference so that both skip the same pairs.
+// Every rotation of a box stays inside the circle through its corners, so boxes whose circles do not touch cannot
+// overlap. The boxes are given by their reordered corners (y1 <= y2, x1 <= x2), in float32 since the squared sizes
+// overflow half precision for large boxes.
+ROTATED_NMS_CIRCLE_FUNC bool RotatedBoundingCirclesDisjoint(
+    float y1a, float x1a, float y2a, float x2a, float y1b, float x1b, float y2b, float x2b)
+{
+    float const h1 = y2a - y1a;
+    float const w1 = x2a - x1a;
+    float const h2 = y2b - y1b;
+    float const w2 = x2b - x1b;
+    float const dy = 0.5f * ((y1a + y2a) - (y1b + y2b));
+    float const dx = 0.5f * ((x1a + x2a) - (x1b + x2b));
+    float const radii = 0.5f * (sqrtf(h1 * h1 + w1 * w1) + sqrtf(h2 * h2 + w2 * w2));
+    return dy * dy + dx * dx > radii * radii;
+}
+
+} // namespace plugin
+} // namespace nvinfer1
+
+#endif
@@ -16,17 +16,67 @@
  */
 
 #include "common/bboxUtils.h"
+#include "common/topKSelect.cuh"
 #include "cub/cub.cuh"
 #include "cuda_runtime_api.h"
 
+#include "efficientRotatedNMSCircle.h"
 #include "efficientRotatedNMSInference.cuh"
 #include "efficientRotatedNMSInference.h"
 
 #define NMS_TILES 5
+#define PROBIOU_EPS 1e-7f
 
 using namespace nvinfer1;
 using namespace nvinfer1::plugin;
 
+template <typename T>
+__device__ bool BoundingCirclesDisjoint(RotatedBoxCorner<T> b1, RotatedBoxCorner<T> b2)
+{
+    return RotatedBoundingCirclesDisjoint((float) b1.y1, (float) b1.x1, (float) b1.y2, (float) b1.x2, (float) b2.y1,
+        (float) b2.x1, (float) b2.y2, (float) b2.x2);
+}
+
+template <typename T>
+__device__ void GaussianCovariance(RotatedBoxCorner<T> box, float& a, float& b, float& c)
+{
+    // Covariance of the uniform distribution over the box, rotated the same way as get_rotated_vertices.
+    float h = (float) box.y2 - (float) box.y1;
+    float w = (float) box.x2 - (float) box.x1;
+    float varW = w * w / 12.f;
+    float varH = h * h / 12.f;
+    float sinR, cosR;
+    __sincosf((float) box.r, &sinR, &cosR);
+    a = varW * cosR * cosR + varH * sinR * sinR;
+    b = varW * sinR * sinR + varH * cosR * cosR;
+    c = (varW - varH) * cosR * sinR;
+}
+
+template <typename T>
+__device__ float ProbIOU(RotatedBoxCorner<T> box1, RotatedBoxCorner<T> box2)
+{
+    // Closed form ProbIoU: 1 - Hellinger distance between the Gaussians fitted to both boxes, derived from their
+    // Bhattacharyya distance. Same formula and epsilons as the Ultralytics probiou() used to train OBB models.
+    float a1, b1, c1, a2, b2, c2;
+    GaussianCovariance<T>(box1, a1, b1, c1);
+    GaussianCovariance<T>(box2, a2, b2, c2);
+    float dy = 0.5f * (((float) box1.y1 + (float) box1.y2) - ((float) box2.y1 + (float) box2.y2));
+    float dx = 0.5f * (((float) box1.x1 + (float) box1.x2) - ((float) box2.x1 + (float) box2.x2));
+
+    float a = a1 + a2;
+    float b = b1 + b2;
+    float c = c1 + c2;
+    float det = a * b - c * c;
+    float t1 = (a * dy * dy + b * dx * dx) / (det + PROBIOU_EPS) * 0.25f;
+    float t2 = -(c * dx * dy) / (det + PROBIOU_EPS) * 0.5f;
+    float t3 = 0.5f
+        * logf(det / (4.f * sqrtf(fmaxf(a1 * b1 - c1 * c1, 0.f) * fmaxf(a2 * b2 - c2 * c2, 0.f)) + PROBIOU_EPS)
+            + PROBIOU_EPS);
+    float bd = fminf(fmaxf(t1 + t2 + t3, PROBIOU_EPS), 100.f);
+    float hd = sqrtf(1.f - expf(-bd) + PROBIOU_EPS);
+    return 1.f - hd;
+}
+
 template <typename T>
 __device__ float IOU(EfficientRotatedNMSParameters param, RotatedBoxCorner<T> box1, RotatedBoxCorner<T> box2)
 {
@@ -36,6 +86,15 @@ __device__ float IOU(EfficientRotatedNMSParameters param, RotatedBoxCorner<T> bo
     RotatedBoxCorner<T> b2 = box2;
     b1.reorder();
     b2.reorder();
+    if (param.iouMode == 1)
+    {
+        return ProbIOU<T>(b1, b2);
+    }
+    // Most candidate pairs are far apart, skip the polygon clipping for them.
+    if (BoundingCirclesDisjoint<T>(b1, b2))
+    {
+        return 0.f;
+    }
     float intersectArea = RotatedBoxCorner<T>::intersect_area(b1, b2);
     if (intersectArea <= 0.f)
     {
@@ -629,14 +688,27 @@ pluginStatus_t EfficientRotatedNMSDispatch(EfficientRotatedNMSParameters param,
         = EfficientRotatedNMSWorkspace<T>(workspace, workspaceOffset, param.batchSize * param.numScoreElements);
     size_t sortedWorkspaceSize = EfficientRotatedNMSSortWorkspaceSize<T>(param.batchSize, param.numScoreElements);
     char* sortedWorkspaceData = EfficientRotatedNMSWorkspace<char>(workspace, workspaceOffset, sortedWorkspaceSize);
-    cub::DoubleBuffer<T> scoresDB(topScoresData, sortedScoresData);
-    cub::DoubleBuffer<int> indexDB(topIndexData, sortedIndexData);
 
     // Kernels
     status = EfficientRotatedNMSFilterLauncher<T>(param, (T*) scoresInput, topNumData, topIndexData, topAnchorsData,
         topOffsetsStartData, topOffsetsEndData, topScoresData, topClassData, stream);
     CSC(status, STATUS_FAILURE);
 
+    // Top-K preselection: only the numSelectedBoxes highest scores of each image can reach NMS, so they are
+    // selected first and the sort only has to order numSelectedBoxes elements per image instead of all of them.
+    bool preselect = param.numScoreElements > param.numSelectedBoxes;
+    if (preselect)
+    {
+        status = TopKSelectLauncher<T>(param.batchSize, param.numScoreElements, param.numSelectedBoxes,
+            param.scoreBits, topNumData, topOffsetsEndData, topScoresData, topIndexData, sortedScoresData,
+            sortedIndexData, stream);
+        CSC(status, STATUS_FAILURE);
+    }
+    cub::DoubleBuffer<T> scoresDB(
+        preselect ? sortedScoresData : topScoresData, preselect ? topScoresData : sortedScoresData);
+    cub::DoubleBuffer<int> indexDB(
+        preselect ? sortedIndexData : topIndexData, preselect ? topIndexData : sortedIndexData);
+
     status = cub::DeviceSegmentedRadixSort::SortPairsDescending(sortedWorkspaceData, sortedWorkspaceSize, scoresDB,
         indexDB, param.batchSize * param.numScoreElements, param.batchSize, topOffsetsStartData, topOffsetsEndData,
         param.scoreBits > 0 ? (10 - param.scoreBits) : 0, param.scoreBits > 0 ? 10 : sizeof(T) * 8, stream);
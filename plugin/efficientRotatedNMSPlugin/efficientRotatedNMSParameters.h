@@ -38,6 +38,7 @@ struct EfficientRotatedNMSParameters
     bool clipBoxes = false;
     int32_t boxCoding = 0;
     bool classAgnostic = false;
+    int32_t iouMode = 0;
 
     // Related to RotatedNMS Internals
     int32_t numSelectedBoxes = 4096;
@@ -358,6 +358,7 @@ EfficientRotatedNMSPluginCreator::EfficientRotatedNMSPluginCreator()
     mPluginAttributes.emplace_back(PluginField("score_activation", nullptr, PluginFieldType::kINT32, 1));
     mPluginAttributes.emplace_back(PluginField("class_agnostic", nullptr, PluginFieldType::kINT32, 1));
     mPluginAttributes.emplace_back(PluginField("box_coding", nullptr, PluginFieldType::kINT32, 1));
+    mPluginAttributes.emplace_back(PluginField("iou_mode", nullptr, PluginFieldType::kINT32, 1));
     mFC.nbFields = mPluginAttributes.size();
     mFC.fields = mPluginAttributes.data();
 }
@@ -435,6 +436,13 @@ IPluginV2DynamicExt* EfficientRotatedNMSPluginCreator::createPlugin(char const*
                 PLUGIN_VALIDATE(boxCoding == 0 || boxCoding == 1);
                 mParam.boxCoding = boxCoding;
             }
+            if (!strcmp(attrName, "iou_mode"))
+            {
+                PLUGIN_VALIDATE(fields[i].type == PluginFieldType::kINT32);
+                auto const iouMode = *(static_cast<int32_t const*>(fields[i].data));
+                PLUGIN_VALIDATE(iouMode == 0 || iouMode == 1);
+                mParam.iouMode = iouMode;
+            }
         }
 
         auto* plugin = new EfficientRotatedNMSPlugin(mParam);
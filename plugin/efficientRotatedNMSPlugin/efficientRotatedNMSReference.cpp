@@ -0,0 +1,534 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "common/topKSelect.h"
+
+#include "efficientRotatedNMSCircle.h"
+#include "efficientRotatedNMSReference.h"
+
+using namespace nvinfer1;
+using namespace nvinfer1::plugin;
+
+namespace
+{
+
+struct ReferenceCandidate
+{
+    float score;     // Score as seen by the NMS kernel (raw, logit or score + 1 with scoreBits)
+    int32_t key;     // Quantized sort key, only used with scoreBits
+    int32_t classIdx;
+    int32_t anchorIdx;
+};
+
+struct ReferenceBox
+{
+    // For NMS/IOU purposes, YXYX coding is identical to XYXY
+    float y1, x1, y2, x2, r;
+};
+
+struct ReferencePoint
+{
+    double x, y;
+};
+
+// Rounds a float to the nearest value representable in half precision (round to nearest even).
+float roundToHalf(float value)
+{
+    if (!std::isfinite(value) || value == 0.f)
+    {
+        return value;
+    }
+    int exponent = 0;
+    std::frexp(value, &exponent);
+    // Half precision keeps 11 significant bits, subnormals have a fixed step of 2^-24.
+    float const step = std::ldexp(1.f, std::max(exponent - 11, -24));
+    float const rounded = std::nearbyint(value / step) * step;
+    return std::fabs(rounded) > 65504.f ? std::copysign(INFINITY, value) : rounded;
+}
+
+float sigmoid(float value)
+{
+    return 1.f / (1.f + std::exp(-value));
+}
+
+void reorder(ReferenceBox& box)
+{
+    if (box.y1 > box.y2)
+    {
+        std::swap(box.y1, box.y2);
+    }
+    if (box.x1 > box.x2)
+    {
+        std::swap(box.x1, box.x2);
+    }
+}
+
+float area(ReferenceBox const& box)
+{
+    float const w = box.x2 - box.x1;
+    float const h = box.y2 - box.y1;
+    if (h <= 0.f || w <= 0.f)
+    {
+        return 0.f;
+    }
+    return h * w;
+}
+
+// Corners of the rotated box, counterclockwise, with the same convention as get_rotated_vertices.
+std::vector<ReferencePoint> vertices(ReferenceBox const& box)
+{
+    double const x = 0.5 * (static_cast<double>(box.x1) + box.x2);
+    double const y = 0.5 * (static_cast<double>(box.y1) + box.y2);
+    double const w = static_cast<double>(box.x2) - box.x1;
+    double const h = static_cast<double>(box.y2) - box.y1;
+    double const cosR = std::cos(box.r);
+    double const sinR = std::sin(box.r);
+    std::vector<ReferencePoint> points;
+    for (auto const& corner : {ReferencePoint{-0.5, 0.5}, ReferencePoint{-0.5, -0.5}, ReferencePoint{0.5, -0.5},
+             ReferencePoint{0.5, 0.5}})
+    {
+        double const dx = corner.x * w;
+        double const dy = corner.y * h;
+        points.push_back({x + dx * cosR - dy * sinR, y + dx * sinR + dy * cosR});
+    }
+    return points;
+}
+
+double cross(ReferencePoint const& o, ReferencePoint const& a, ReferencePoint const& b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Area of the intersection of two rotated boxes: Sutherland-Hodgman clipping of the first box by the edges of the
+// second one, both being convex and counterclockwise.
+double intersectArea(ReferenceBox const& b1, ReferenceBox const& b2)
+{
+    std::vector<ReferencePoint> polygon = vertices(b1);
+    std::vector<ReferencePoint> const clip = vertices(b2);
+    for (size_t e = 0; e < clip.size() && !polygon.empty(); e++)
+    {
+        ReferencePoint const& a = clip[e];
+        ReferencePoint const& b = clip[(e + 1) % clip.size()];
+        std::vector<ReferencePoint> clipped;
+        for (size_t i = 0; i < polygon.size(); i++)
+        {
+            ReferencePoint const& p = polygon[i];
+            ReferencePoint const& q = polygon[(i + 1) % polygon.size()];
+            double const sideP = cross(a, b, p);
+            double const sideQ = cross(a, b, q);
+            if (sideP >= 0.0)
+            {
+                clipped.push_back(p);
+            }
+            if ((sideP >= 0.0) != (sideQ >= 0.0))
+            {
+                double const t = sideP / (sideP - sideQ);
+                clipped.push_back({p.x + t * (q.x - p.x), p.y + t * (q.y - p.y)});
+            }
+        }
+        polygon.swap(clipped);
+    }
+
+    double twiceArea = 0.0;
+    for (size_t i = 0; i < polygon.size(); i++)
+    {
+        ReferencePoint const& p = polygon[i];
+        ReferencePoint const& q = polygon[(i + 1) % polygon.size()];
+        twiceArea += p.x * q.y - p.y * q.x;
+    }
+    return std::fabs(twiceArea) * 0.5;
+}
+
+float exactIOU(ReferenceBox const& b1, ReferenceBox const& b2)
+{
+    // Degenerate boxes have no intersection, like RotatedBoxCorner::intersect_area
+    if (area(b1) < 1e-14f || area(b2) < 1e-14f)
+    {
+        return 0.f;
+    }
+    float const intersection = static_cast<float>(intersectArea(b1, b2));
+    if (intersection <= 0.f)
+    {
+        return 0.f;
+    }
+    float const unionArea = area(b1) + area(b2) - intersection;
+    if (unionArea <= 0.f)
+    {
+        return 0.f;
+    }
+    return intersection / unionArea;
+}
+
+float probIOU(ReferenceBox const& box1, ReferenceBox const& box2)
+{
+    // Same closed form as the ProbIOU kernel function, in double precision.
+    double constexpr kEps = 1e-7;
+    auto const covariance = [](ReferenceBox const& box, double& a, double& b, double& c) {
+        double const w = static_cast<double>(box.x2) - box.x1;
+        double const h = static_cast<double>(box.y2) - box.y1;
+        double const varW = w * w / 12.0;
+        double const varH = h * h / 12.0;
+        double const cosR = std::cos(box.r);
+        double const sinR = std::sin(box.r);
+        a = varW * cosR * cosR + varH * sinR * sinR;
+        b = varW * sinR * sinR + varH * cosR * cosR;
+        c = (varW - varH) * cosR * sinR;
+    };
+    double a1, b1, c1, a2, b2, c2;
+    covariance(box1, a1, b1, c1);
+    covariance(box2, a2, b2, c2);
+    double const dy = 0.5 * ((static_cast<double>(box1.y1) + box1.y2) - (static_cast<double>(box2.y1) + box2.y2));
+    double const dx = 0.5 * ((static_cast<double>(box1.x1) + box1.x2) - (static_cast<double>(box2.x1) + box2.x2));
+
+    double const a = a1 + a2;
+    double const b = b1 + b2;
+    double const c = c1 + c2;
+    double const det = a * b - c * c;
+    double const t1 = (a * dy * dy + b * dx * dx) / (det + kEps) * 0.25;
+    double const t2 = -(c * dx * dy) / (det + kEps) * 0.5;
+    double const t3 = 0.5
+        * std::log(det / (4.0 * std::sqrt(std::max(a1 * b1 - c1 * c1, 0.0) * std::max(a2 * b2 - c2 * c2, 0.0)) + kEps)
+            + kEps);
+    double const bd = std::min(std::max(t1 + t2 + t3, kEps), 100.0);
+    return static_cast<float>(1.0 - std::sqrt(1.0 - std::exp(-bd) + kEps));
+}
+
+float IOU(int32_t iouMode, ReferenceBox b1, ReferenceBox b2, bool circleRejection = false)
+{
+    // Regardless of the selected box coding, IOU is always performed in RotatedBoxCorner coding.
+    reorder(b1);
+    reorder(b2);
+    if (iouMode == 1)
+    {
+        return probIOU(b1, b2);
+    }
+    // Same early rejection as the kernel, before the polygon clipping
+    if (circleRejection && RotatedBoundingCirclesDisjoint(b1.y1, b1.x1, b1.y2, b1.x2, b2.y1, b2.x1, b2.y2, b2.x2))
+    {
+        return 0.f;
+    }
+    return exactIOU(b1, b2);
+}
+
+ReferenceBox DecodeBox(EfficientRotatedNMSParameters const& param, float const* box, float const* anchor)
+{
+    // The inputs are in the selected coding format, but the decoded box is always returned as RotatedBoxCorner.
+    if (param.boxCoding == 0)
+    {
+        ReferenceBox corner{box[0], box[1], box[2], box[3], box[4]};
+        if (param.boxDecoder)
+        {
+            ReferenceBox prior{anchor[0], anchor[1], anchor[2], anchor[3], anchor[4]};
+            reorder(corner);
+            reorder(prior);
+            corner = {corner.y1 + prior.y1, corner.x1 + prior.x1, corner.y2 + prior.y2, corner.x2 + prior.x2,
+                corner.r};
+        }
+        return corner;
+    }
+
+    float y = box[0];
+    float x = box[1];
+    float h = box[2];
+    float w = box[3];
+    if (param.boxDecoder)
+    {
+        y = y * anchor[2] + anchor[0];
+        x = x * anchor[3] + anchor[1];
+        h = anchor[2] * std::exp(h);
+        w = anchor[3] * std::exp(w);
+    }
+    return {y - h * 0.5f, x - w * 0.5f, y + h * 0.5f, x + w * 0.5f, box[4]};
+}
+
+void EfficientRotatedNMSReferenceImage(EfficientRotatedNMSParameters const& param, bool half, bool dense,
+    bool circleRejection, float scoreThreshold, int32_t imageIdx, float const* boxesInput, float const* scoresInput,
+    float const* anchorsInput, int32_t* numDetectionsOutput, float* nmsBoxesOutput, float* nmsScoresOutput,
+    int32_t* nmsClassesOutput)
+{
+    auto const store = [half](float value) { return half ? roundToHalf(value) : value; };
+    auto const bump = [&](float score) {
+        // Ensure the incremented score fits in the mantissa without changing the exponent
+        return std::min(store(score + 1.f), 2.f - 1.f / 1024.f);
+    };
+    auto const sortKey = [&](float score) {
+        // The radix sort only looks at the top scoreBits bits of the half precision mantissa
+        return static_cast<int32_t>(std::nearbyint((score - 1.f) * 1024.f)) >> (10 - param.scoreBits);
+    };
+
+    // Filter: select the candidates of this image, in element order.
+    std::vector<ReferenceCandidate> candidates;
+    candidates.reserve(dense ? param.numScoreElements : 0);
+    float const* scores = scoresInput + static_cast<size_t>(imageIdx) * param.numScoreElements;
+    for (int32_t elementIdx = 0; elementIdx < param.numScoreElements; elementIdx++)
+    {
+        int32_t const classIdx = elementIdx % param.numClasses;
+        int32_t const anchorIdx = elementIdx / param.numClasses;
+        float score = store(scores[elementIdx]);
+        bool const selected = score >= scoreThreshold && classIdx != param.backgroundClass;
+        if (!selected && !dense)
+        {
+            continue;
+        }
+        if (param.scoreBits > 0)
+        {
+            score = selected ? bump(score) : 1.f;
+        }
+        else if (!selected)
+        {
+            score = -(1 << 15);
+        }
+        int32_t const key = param.scoreBits > 0 ? sortKey(score) : 0;
+        candidates.push_back({score, key, classIdx, anchorIdx});
+    }
+
+    // Top-K preselection, same as TopKSelect: keep the numSelectedBoxes highest keys in element order.
+    int32_t const maxSelectedBoxes = std::max(param.numSelectedBoxes, 0);
+    if (static_cast<int32_t>(candidates.size()) > maxSelectedBoxes)
+    {
+        std::vector<uint32_t> keys(candidates.size());
+        for (size_t i = 0; i < candidates.size(); i++)
+        {
+            keys[i] = param.scoreBits > 0 ? static_cast<uint32_t>(candidates[i].key)
+                                          : topKSelectKey(candidates[i].score);
+        }
+        std::vector<int32_t> selected(maxSelectedBoxes);
+        int32_t const numSelected = topKSelectReference(keys.data(), static_cast<int32_t>(keys.size()),
+            maxSelectedBoxes, param.scoreBits > 0 ? param.scoreBits : 32, selected.data());
+        for (int32_t i = 0; i < numSelected; i++)
+        {
+            candidates[i] = candidates[selected[i]];
+        }
+        candidates.resize(numSelected);
+    }
+
+    // Sort: descending by score, candidates with equal keys keep their element order.
+    if (param.scoreBits > 0)
+    {
+        std::stable_sort(candidates.begin(), candidates.end(),
+            [](ReferenceCandidate const& a, ReferenceCandidate const& b) { return a.key > b.key; });
+    }
+    else
+    {
+        std::stable_sort(candidates.begin(), candidates.end(),
+            [](ReferenceCandidate const& a, ReferenceCandidate const& b) { return a.score > b.score; });
+    }
+    int32_t const numSelectedBoxes = static_cast<int32_t>(candidates.size());
+
+    // Decode the boxes of the selected candidates.
+    std::vector<ReferenceBox> boxes(numSelectedBoxes);
+    for (int32_t i = 0; i < numSelectedBoxes; i++)
+    {
+        ReferenceCandidate const& candidate = candidates[i];
+        int32_t boxIdxMap;
+        if (param.shareLocation) // Shape of boxesInput: [batchSize, numAnchors, 1, 5]
+        {
+            boxIdxMap = imageIdx * param.numAnchors + candidate.anchorIdx;
+        }
+        else // Shape of boxesInput: [batchSize, numAnchors, numClasses, 5]
+        {
+            boxIdxMap = (imageIdx * param.numAnchors + candidate.anchorIdx) * param.numClasses + candidate.classIdx;
+        }
+        float const* anchor = nullptr;
+        if (param.boxDecoder)
+        {
+            int32_t const anchorIdxMap
+                = param.shareAnchors ? candidate.anchorIdx : imageIdx * param.numAnchors + candidate.anchorIdx;
+            anchor = anchorsInput + static_cast<size_t>(anchorIdxMap) * 5;
+        }
+        boxes[i] = DecodeBox(param, boxesInput + static_cast<size_t>(boxIdxMap) * 5, anchor);
+    }
+
+    // NMS: greedy selection in sorted order, same as the EfficientRotatedNMS kernel. Every kept box suppresses the
+    // lower scored boxes of the same class it overlaps.
+    std::vector<int32_t> classCounters(param.numOutputBoxesPerClass >= 0 ? param.numClasses : 0, 0);
+    std::vector<int8_t> dropped(numSelectedBoxes, 0);
+    int32_t resultsCounter = 0;
+    for (int32_t i = 0; i < numSelectedBoxes && resultsCounter < param.numOutputBoxes; i++)
+    {
+        if (dropped[i])
+        {
+            continue;
+        }
+        for (int32_t j = i + 1; j < numSelectedBoxes; j++)
+        {
+            if (!dropped[j] && (param.classAgnostic || candidates[j].classIdx == candidates[i].classIdx)
+                && candidates[j].score <= candidates[i].score
+                && IOU(param.iouMode, boxes[j], boxes[i], circleRejection) >= param.iouThreshold)
+            {
+                dropped[j] = 1;
+            }
+        }
+
+        ReferenceCandidate const& candidate = candidates[i];
+        // With the per-class limit, a kept box is not necessarily written but it still suppresses others.
+        if (param.numOutputBoxesPerClass >= 0 && classCounters[candidate.classIdx]++ >= param.numOutputBoxesPerClass)
+        {
+            continue;
+        }
+
+        int32_t const outputIdx = imageIdx * param.numOutputBoxes + resultsCounter++;
+        if (param.scoreSigmoid)
+        {
+            nmsScoresOutput[outputIdx] = store(sigmoid(candidate.score));
+        }
+        else if (param.scoreBits > 0)
+        {
+            nmsScoresOutput[outputIdx] = store(candidate.score - 1.f);
+        }
+        else
+        {
+            nmsScoresOutput[outputIdx] = candidate.score;
+        }
+        nmsClassesOutput[outputIdx] = candidate.classIdx;
+        ReferenceBox box = boxes[i];
+        if (param.clipBoxes)
+        {
+            box = {std::min(std::max(box.y1, 0.f), 1.f), std::min(std::max(box.x1, 0.f), 1.f),
+                std::min(std::max(box.y2, 0.f), 1.f), std::min(std::max(box.x2, 0.f), 1.f), box.r};
+        }
+        float* output = nmsBoxesOutput + static_cast<size_t>(outputIdx) * 5;
+        output[0] = store(box.y1);
+        output[1] = store(box.x1);
+        output[2] = store(box.y2);
+        output[3] = store(box.x2);
+        output[4] = store(box.r);
+    }
+    numDetectionsOutput[imageIdx] = resultsCounter;
+}
+
+} // namespace
+
+float EfficientRotatedNMSIOUReference(int32_t iouMode, float const* box1, float const* box2)
+{
+    return IOU(iouMode, ReferenceBox{box1[0], box1[1], box1[2], box1[3], box1[4]},
+        ReferenceBox{box2[0], box2[1], box2[2], box2[3], box2[4]});
+}
+
+pluginStatus_t EfficientRotatedNMSReference(EfficientRotatedNMSParameters param, float const* boxesInput,
+    float const* scoresInput, float const* anchorsInput, int32_t* numDetectionsOutput, float* nmsBoxesOutput,
+    float* nmsScoresOutput, int32_t* nmsClassesOutput, int32_t numThreads, bool circleRejection)
+{
+    if (!numDetectionsOutput || !nmsBoxesOutput || !nmsScoresOutput || !nmsClassesOutput || param.batchSize < 0
+        || param.numOutputBoxes < 0)
+    {
+        return STATUS_BAD_PARAM;
+    }
+
+    bool half = false;
+    if (param.datatype == DataType::kFLOAT)
+    {
+        param.scoreBits = -1;
+    }
+    else if (param.datatype == DataType::kHALF)
+    {
+        half = true;
+        if (param.scoreBits <= 0 || param.scoreBits > 10)
+        {
+            param.scoreBits = -1;
+        }
+    }
+    else
+    {
+        return STATUS_NOT_SUPPORTED;
+    }
+
+    // Clear Outputs (not all elements will get overwritten, same as the plugin)
+    size_t const numOutputs = static_cast<size_t>(param.batchSize) * param.numOutputBoxes;
+    std::fill_n(numDetectionsOutput, param.batchSize, 0);
+    std::fill_n(nmsBoxesOutput, numOutputs * 5, 0.f);
+    std::fill_n(nmsScoresOutput, numOutputs, 0.f);
+    std::fill_n(nmsClassesOutput, numOutputs, 0);
+
+    // Empty Inputs
+    if (param.numScoreElements < 1)
+    {
+        return STATUS_SUCCESS;
+    }
+    if (!boxesInput || !scoresInput || (param.boxDecoder && !anchorsInput) || param.numClasses < 1)
+    {
+        return STATUS_BAD_PARAM;
+    }
+
+    // Same threshold handling as EfficientRotatedNMSFilterLauncher
+    float scoreThreshold = param.scoreThreshold;
+    float kernelSelectThreshold = 0.007f;
+    if (param.scoreSigmoid)
+    {
+        // Inverse Sigmoid
+        if (param.scoreThreshold <= 0.f)
+        {
+            scoreThreshold = -(1 << 15);
+        }
+        else
+        {
+            scoreThreshold = std::log(param.scoreThreshold / (1.f - param.scoreThreshold));
+        }
+        kernelSelectThreshold = std::log(kernelSelectThreshold / (1.f - kernelSelectThreshold));
+        // Disable Score Bits Optimization
+        param.scoreBits = -1;
+    }
+    bool const dense = scoreThreshold < kernelSelectThreshold;
+    if (half)
+    {
+        scoreThreshold = roundToHalf(scoreThreshold);
+    }
+
+    if (numThreads <= 0)
+    {
+        numThreads = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1U));
+    }
+    numThreads = std::min(numThreads, param.batchSize);
+
+    std::atomic<int32_t> nextImage{0};
+    std::atomic<bool> failed{false};
+    auto const worker = [&]() {
+        try
+        {
+            for (int32_t imageIdx = nextImage++; imageIdx < param.batchSize; imageIdx = nextImage++)
+            {
+                EfficientRotatedNMSReferenceImage(param, half, dense, circleRejection, scoreThreshold, imageIdx,
+                    boxesInput, scoresInput, anchorsInput, numDetectionsOutput, nmsBoxesOutput, nmsScoresOutput,
+                    nmsClassesOutput);
+            }
+        }
+        catch (...)
+        {
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int32_t i = 1; i < numThreads; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return failed ? STATUS_FAILURE : STATUS_SUCCESS;
+}
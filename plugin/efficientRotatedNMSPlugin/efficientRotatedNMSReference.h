@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_EFFICIENT_ROTATED_NMS_REFERENCE_H
+#define TRT_EFFICIENT_ROTATED_NMS_REFERENCE_H
+
+#include "common/plugin.h"
+
+#include "efficientRotatedNMSParameters.h"
+
+// Host implementation of the overlap used by EfficientRotatedNMS between two boxes in RotatedBoxCorner coding
+// ([x1, y1, x2, y2, r], corners in either order). iouMode 0 returns the exact IOU of the rotated rectangles, and
+// iouMode 1 the ProbIoU of their Gaussian approximations. The exact area is computed independently of the kernel,
+// by clipping one rectangle against the other in double precision, so it can be used to validate both the polygon
+// intersection code and the bounding circle rejection.
+float EfficientRotatedNMSIOUReference(int32_t iouMode, float const* box1, float const* box2);
+
+// Host implementation of EfficientRotatedNMSInference.
+//
+// All buffers live in host memory and hold float32 values laid out exactly like the plugin tensors:
+//   boxesInput:          [batchSize, numAnchors, 1 or numClasses, 5]
+//   scoresInput:         [batchSize, numAnchors, numClasses]
+//   anchorsInput:        [1 or batchSize, numAnchors, 5], only read when param.boxDecoder is set
+//   numDetectionsOutput: [batchSize]
+//   nmsBoxesOutput:      [batchSize, numOutputBoxes, 5]
+//   nmsScoresOutput, nmsClassesOutput: [batchSize, numOutputBoxes]
+//
+// The filter, top-K, sort and NMS stages follow the CUDA kernels step by step, and the overlap is evaluated with
+// EfficientRotatedNMSIOUReference in the mode selected by param.iouMode. When param.datatype is kHALF, scores and
+// outputs are rounded to half precision and the scoreBits sort key is emulated, but box arithmetic is still
+// carried out in float32. As with the axis aligned reference, candidates with equal scores are kept in element
+// order, while the GPU filter appends them in a nondeterministic order.
+//
+// Images are processed in parallel by up to numThreads threads (0 selects the hardware concurrency). With
+// circleRejection, the exact IOU skips the pairs whose bounding circles are disjoint like the kernel does, see
+// efficientRotatedNMSCircle.h; turning it off must not change the results.
+pluginStatus_t EfficientRotatedNMSReference(nvinfer1::plugin::EfficientRotatedNMSParameters param,
+    float const* boxesInput, float const* scoresInput, float const* anchorsInput, int32_t* numDetectionsOutput,
+    float* nmsBoxesOutput, float* nmsScoresOutput, int32_t* nmsClassesOutput, int32_t numThreads = 0,
+    bool circleRejection = true);
+
+#endif
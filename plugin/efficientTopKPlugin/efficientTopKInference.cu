@@ -0,0 +1,334 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/topKSelect.cuh"
+#include "cuda_runtime_api.h"
+
+#include "efficientTopKInference.h"
+
+#define EFFICIENT_TOPK_FILTER_BLOCK 512
+#define EFFICIENT_TOPK_SELECT_BLOCK 512
+
+using namespace nvinfer1;
+using namespace nvinfer1::plugin;
+
+// Candidates are 64-bit keys that order by score first and element index second: the radix key of the score in
+// the high word and the complement of the element index in the low word. Keys are unique, so the selection and
+// the sort are deterministic, with equal scores kept in element order, regardless of the order the filter
+// appended them in.
+template <typename T>
+__device__ unsigned long long EfficientTopKKey(T score, int elementIdx)
+{
+    return ((unsigned long long) TopKSelectKey<float>((float) score, -1) << 32) | (unsigned int) ~elementIdx;
+}
+
+__device__ int EfficientTopKElement(unsigned long long key)
+{
+    return (int) ~(unsigned int) key;
+}
+
+template <typename T>
+__global__ void EfficientTopKFilter(EfficientTopKParameters param, const T* __restrict__ scoresInput,
+    int* __restrict__ candidateCountData, unsigned long long* __restrict__ candidateKeysData)
+{
+    int elementIdx = blockDim.x * blockIdx.x + threadIdx.x;
+    int imageIdx = blockIdx.y;
+
+    // Shape of scoresInput: [batchSize, numAnchors, numClasses]
+    bool selected = false;
+    unsigned long long key = 0;
+    if (elementIdx < param.numScoreElements)
+    {
+        T score = scoresInput[(size_t) imageIdx * param.numScoreElements + elementIdx];
+        selected = (float) score >= (float) (T) param.scoreThreshold;
+        key = EfficientTopKKey<T>(score, elementIdx);
+    }
+
+    // One atomic per warp reserves the slots of all its selected elements.
+    unsigned int lane = threadIdx.x % 32;
+    unsigned int ballot = __ballot_sync(0xffffffff, selected);
+    if (ballot == 0)
+    {
+        return;
+    }
+    int leader = __ffs(ballot) - 1;
+    int base = 0;
+    if (lane == leader)
+    {
+        base = atomicAdd(&candidateCountData[imageIdx], __popc(ballot));
+    }
+    base = __shfl_sync(0xffffffff, base, leader);
+    if (selected)
+    {
+        int slot = base + __popc(ballot & ((1u << lane) - 1));
+        candidateKeysData[(size_t) imageIdx * param.numScoreElements + slot] = key;
+    }
+}
+
+template <typename T>
+__global__ void EfficientTopKSelect(EfficientTopKParameters param, int sortSize, const T* __restrict__ boxesInput,
+    const T* __restrict__ scoresInput, const int* __restrict__ candidateCountData,
+    const unsigned long long* __restrict__ candidateKeysData, int* __restrict__ numDetectionsOutput,
+    T* __restrict__ topKBoxesOutput, T* __restrict__ topKScoresOutput, int* __restrict__ topKClassesOutput)
+{
+    // One block per image selects the numOutputBoxes largest candidate keys, sorts them in shared memory and
+    // gathers their scores, classes and boxes.
+    extern __shared__ unsigned long long sortedKeys[];
+    __shared__ unsigned int histogram[1 << TOPK_SELECT_RADIX_BITS];
+    __shared__ unsigned long long kthKey;
+    __shared__ int remaining;
+    __shared__ int numSelected;
+
+    unsigned int thread = threadIdx.x;
+    int imageIdx = blockIdx.x;
+    int count = candidateCountData[imageIdx];
+    int numOutputBoxes = min(count, param.numOutputBoxes);
+    const unsigned long long* keys = candidateKeysData + (size_t) imageIdx * param.numScoreElements;
+
+    // Radix select of the numOutputBoxes-th largest key, one digit at a time from the most significant. Keys are
+    // unique, so every key at or above it is selected. The search stops early once a whole bin is selected.
+    const unsigned int radixMask = (1u << TOPK_SELECT_RADIX_BITS) - 1;
+    if (thread == 0)
+    {
+        kthKey = 0;
+        remaining = numOutputBoxes;
+        numSelected = 0;
+    }
+    __syncthreads();
+    if (count > numOutputBoxes)
+    {
+        unsigned long long prefixMask = 0;
+        for (int shift = 64 - TOPK_SELECT_RADIX_BITS; shift >= 0; shift -= TOPK_SELECT_RADIX_BITS)
+        {
+            for (int bin = thread; bin < (1 << TOPK_SELECT_RADIX_BITS); bin += blockDim.x)
+            {
+                histogram[bin] = 0;
+            }
+            __syncthreads();
+
+            unsigned long long prefix = kthKey;
+            for (int i = thread; i < count; i += blockDim.x)
+            {
+                unsigned long long key = keys[i];
+                if ((key & prefixMask) == prefix)
+                {
+                    atomicAdd(&histogram[(key >> shift) & radixMask], 1);
+                }
+            }
+            __syncthreads();
+
+            if (thread == 0)
+            {
+                int needed = remaining;
+                unsigned int digit = radixMask;
+                for (; digit > 0; digit--)
+                {
+                    if ((int) histogram[digit] >= needed)
+                    {
+                        break;
+                    }
+                    needed -= histogram[digit];
+                }
+                kthKey = prefix | ((unsigned long long) digit << shift);
+                remaining = (int) histogram[digit] == needed ? 0 : needed;
+            }
+            prefixMask |= (unsigned long long) radixMask << shift;
+            __syncthreads();
+            if (remaining == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // Compaction of the selected keys, in any order, then padding up to the sort size.
+    unsigned long long kth = kthKey;
+    for (int i = thread; i < count; i += blockDim.x)
+    {
+        unsigned long long key = keys[i];
+        if (key >= kth)
+        {
+            sortedKeys[atomicAdd(&numSelected, 1)] = key;
+        }
+    }
+    __syncthreads();
+    for (int i = numSelected + thread; i < sortSize; i += blockDim.x)
+    {
+        sortedKeys[i] = 0;
+    }
+    __syncthreads();
+
+    // Bitonic sort, descending.
+    for (int size = 2; size <= sortSize; size <<= 1)
+    {
+        for (int stride = size / 2; stride > 0; stride >>= 1)
+        {
+            for (int i = thread; i < sortSize / 2; i += blockDim.x)
+            {
+                int lo = 2 * stride * (i / stride) + i % stride;
+                int hi = lo + stride;
+                bool descending = (lo & size) == 0;
+                unsigned long long a = sortedKeys[lo];
+                unsigned long long b = sortedKeys[hi];
+                if ((a < b) == descending)
+                {
+                    sortedKeys[lo] = b;
+                    sortedKeys[hi] = a;
+                }
+            }
+            __syncthreads();
+        }
+    }
+
+    // Gather
+    for (int i = thread; i < numOutputBoxes; i += blockDim.x)
+    {
+        int elementIdx = EfficientTopKElement(sortedKeys[i]);
+        int anchorIdx = elementIdx / param.numClasses;
+        int outputIdx = imageIdx * param.numOutputBoxes + i;
+
+        float score = (float) scoresInput[(size_t) imageIdx * param.numScoreElements + elementIdx];
+        topKScoresOutput[outputIdx] = (T) (param.scoreSigmoid ? 1.f / (1.f + __expf(-score)) : score);
+        topKClassesOutput[outputIdx] = elementIdx % param.numClasses;
+
+        // Shape of boxesInput: [batchSize, numAnchors, 4], the output boxes are always in BoxCorner coding
+        const T* box = boxesInput + ((size_t) imageIdx * param.numAnchors + anchorIdx) * 4;
+        float b0 = (float) box[0];
+        float b1 = (float) box[1];
+        float b2 = (float) box[2];
+        float b3 = (float) box[3];
+        if (param.boxCoding == 1)
+        {
+            // BoxCenterSize: y, x, h, w (or x, y, w, h, the conversion is the same)
+            float h2 = b2 * 0.5f;
+            float w2 = b3 * 0.5f;
+            b2 = b0 + h2;
+            b3 = b1 + w2;
+            b0 -= h2;
+            b1 -= w2;
+        }
+        T* output = topKBoxesOutput + (size_t) outputIdx * 4;
+        output[0] = (T) b0;
+        output[1] = (T) b1;
+        output[2] = (T) b2;
+        output[3] = (T) b3;
+    }
+    if (thread == 0)
+    {
+        numDetectionsOutput[imageIdx] = numOutputBoxes;
+    }
+}
+
+size_t EfficientTopKWorkspaceSize(int batchSize, int numScoreElements)
+{
+    size_t total = 0;
+    const size_t align = 256;
+    // Counters
+    size_t size = batchSize * sizeof(int);
+    total += size + (size % align ? align - (size % align) : 0);
+    // Candidate Keys
+    size = (size_t) batchSize * numScoreElements * sizeof(unsigned long long);
+    total += size + (size % align ? align - (size % align) : 0);
+    return total;
+}
+
+template <typename T>
+T* EfficientTopKWorkspace(void* workspace, size_t& offset, size_t elements)
+{
+    T* buffer = (T*) ((size_t) workspace + offset);
+    size_t align = 256;
+    size_t size = elements * sizeof(T);
+    size_t sizeAligned = size + (size % align ? align - (size % align) : 0);
+    offset += sizeAligned;
+    return buffer;
+}
+
+template <typename T>
+pluginStatus_t EfficientTopKDispatch(EfficientTopKParameters param, const void* boxesInput, const void* scoresInput,
+    void* numDetectionsOutput, void* topKBoxesOutput, void* topKScoresOutput, void* topKClassesOutput,
+    void* workspace, cudaStream_t stream)
+{
+    // Clear Outputs (not all elements will get overwritten by the kernels, so safer to clear everything out)
+    CSC(cudaMemsetAsync(numDetectionsOutput, 0x00, param.batchSize * sizeof(int), stream), STATUS_FAILURE);
+    CSC(cudaMemsetAsync(topKScoresOutput, 0x00, param.batchSize * param.numOutputBoxes * sizeof(T), stream), STATUS_FAILURE);
+    CSC(cudaMemsetAsync(topKBoxesOutput, 0x00, param.batchSize * param.numOutputBoxes * 4 * sizeof(T), stream), STATUS_FAILURE);
+    CSC(cudaMemsetAsync(topKClassesOutput, 0x00, param.batchSize * param.numOutputBoxes * sizeof(int), stream), STATUS_FAILURE);
+
+    // Empty Inputs
+    if (param.numScoreElements < 1 || param.batchSize < 1)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    size_t workspaceOffset = 0;
+    int* candidateCountData = EfficientTopKWorkspace<int>(workspace, workspaceOffset, param.batchSize);
+    unsigned long long* candidateKeysData = EfficientTopKWorkspace<unsigned long long>(
+        workspace, workspaceOffset, (size_t) param.batchSize * param.numScoreElements);
+    CSC(cudaMemsetAsync(candidateCountData, 0x00, param.batchSize * sizeof(int), stream), STATUS_FAILURE);
+
+    if (param.scoreSigmoid)
+    {
+        // Inverse Sigmoid
+        if (param.scoreThreshold <= 0.f)
+        {
+            param.scoreThreshold = -(1 << 15);
+        }
+        else
+        {
+            param.scoreThreshold = logf(param.scoreThreshold / (1.f - param.scoreThreshold));
+        }
+    }
+
+    const unsigned int elementBlocks
+        = (param.numScoreElements + EFFICIENT_TOPK_FILTER_BLOCK - 1) / EFFICIENT_TOPK_FILTER_BLOCK;
+    const dim3 filterGridSize = {elementBlocks, (unsigned int) param.batchSize, 1};
+    EfficientTopKFilter<T><<<filterGridSize, EFFICIENT_TOPK_FILTER_BLOCK, 0, stream>>>(
+        param, (const T*) scoresInput, candidateCountData, candidateKeysData);
+
+    int sortSize = 1;
+    while (sortSize < param.numOutputBoxes)
+    {
+        sortSize <<= 1;
+    }
+    EfficientTopKSelect<T><<<param.batchSize, EFFICIENT_TOPK_SELECT_BLOCK, sortSize * sizeof(unsigned long long),
+        stream>>>(param, sortSize, (const T*) boxesInput, (const T*) scoresInput, candidateCountData,
+        candidateKeysData, (int*) numDetectionsOutput, (T*) topKBoxesOutput, (T*) topKScoresOutput,
+        (int*) topKClassesOutput);
+    CSC(cudaGetLastError(), STATUS_FAILURE);
+
+    return STATUS_SUCCESS;
+}
+
+pluginStatus_t EfficientTopKInference(EfficientTopKParameters param, const void* boxesInput, const void* scoresInput,
+    void* numDetectionsOutput, void* topKBoxesOutput, void* topKScoresOutput, void* topKClassesOutput,
+    void* workspace, cudaStream_t stream)
+{
+    if (param.datatype == DataType::kFLOAT)
+    {
+        return EfficientTopKDispatch<float>(param, boxesInput, scoresInput, numDetectionsOutput, topKBoxesOutput,
+            topKScoresOutput, topKClassesOutput, workspace, stream);
+    }
+    else if (param.datatype == DataType::kHALF)
+    {
+        return EfficientTopKDispatch<__half>(param, boxesInput, scoresInput, numDetectionsOutput, topKBoxesOutput,
+            topKScoresOutput, topKClassesOutput, workspace, stream);
+    }
+    else
+    {
+        return STATUS_NOT_SUPPORTED;
+    }
+}
@@ -0,0 +1,363 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "efficientTopKPlugin.h"
+#include "efficientTopKInference.h"
+
+using namespace nvinfer1;
+using nvinfer1::plugin::EfficientTopKPlugin;
+using nvinfer1::plugin::EfficientTopKParameters;
+using nvinfer1::plugin::EfficientTopKPluginCreator;
+
+namespace
+{
+char const* const kEFFICIENT_TOPK_PLUGIN_VERSION{"1"};
+char const* const kEFFICIENT_TOPK_PLUGIN_NAME{"EfficientTopK_TRT"};
+} // namespace
+
+REGISTER_TENSORRT_PLUGIN(EfficientTopKPluginCreator);
+
+EfficientTopKPlugin::EfficientTopKPlugin(EfficientTopKParameters param)
+    : mParam(std::move(param))
+{
+}
+
+EfficientTopKPlugin::EfficientTopKPlugin(void const* data, size_t length)
+{
+    deserialize(static_cast<int8_t const*>(data), length);
+}
+
+void EfficientTopKPlugin::deserialize(int8_t const* data, size_t length)
+{
+    auto const* d{data};
+    mParam = read<EfficientTopKParameters>(d);
+    PLUGIN_VALIDATE(d == data + length);
+}
+
+char const* EfficientTopKPlugin::getPluginType() const noexcept
+{
+    return kEFFICIENT_TOPK_PLUGIN_NAME;
+}
+
+char const* EfficientTopKPlugin::getPluginVersion() const noexcept
+{
+    return kEFFICIENT_TOPK_PLUGIN_VERSION;
+}
+
+int32_t EfficientTopKPlugin::getNbOutputs() const noexcept
+{
+    // Same outputs as the standard NMS plugins
+    return 4;
+}
+
+int32_t EfficientTopKPlugin::initialize() noexcept
+{
+    return STATUS_SUCCESS;
+}
+
+void EfficientTopKPlugin::terminate() noexcept {}
+
+size_t EfficientTopKPlugin::getSerializationSize() const noexcept
+{
+    return sizeof(EfficientTopKParameters);
+}
+
+void EfficientTopKPlugin::serialize(void* buffer) const noexcept
+{
+    char *d = reinterpret_cast<char*>(buffer), *a = d;
+    write(d, mParam);
+    PLUGIN_ASSERT(d == a + getSerializationSize());
+}
+
+void EfficientTopKPlugin::destroy() noexcept
+{
+    delete this;
+}
+
+void EfficientTopKPlugin::setPluginNamespace(char const* pluginNamespace) noexcept
+{
+    try
+    {
+        mNamespace = pluginNamespace;
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+    }
+}
+
+char const* EfficientTopKPlugin::getPluginNamespace() const noexcept
+{
+    return mNamespace.c_str();
+}
+
+nvinfer1::DataType EfficientTopKPlugin::getOutputDataType(
+    int32_t index, nvinfer1::DataType const* inputTypes, int32_t nbInputs) const noexcept
+{
+    // num_detections and detection_classes use integer outputs
+    if (index == 0 || index == 3)
+    {
+        return nvinfer1::DataType::kINT32;
+    }
+    // All others should use the same datatype as the input
+    return inputTypes[0];
+}
+
+IPluginV2DynamicExt* EfficientTopKPlugin::clone() const noexcept
+{
+    try
+    {
+        auto* plugin = new EfficientTopKPlugin(mParam);
+        plugin->setPluginNamespace(mNamespace.c_str());
+        return plugin;
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+    }
+    return nullptr;
+}
+
+DimsExprs EfficientTopKPlugin::getOutputDimensions(
+    int32_t outputIndex, DimsExprs const* inputs, int32_t nbInputs, IExprBuilder& exprBuilder) noexcept
+{
+    try
+    {
+        DimsExprs out_dim;
+        IDimensionExpr const* numOutputBoxes = exprBuilder.constant(mParam.numOutputBoxes);
+
+        PLUGIN_ASSERT(outputIndex >= 0 && outputIndex <= 3);
+
+        // num_detections
+        if (outputIndex == 0)
+        {
+            out_dim.nbDims = 2;
+            out_dim.d[0] = inputs[0].d[0];
+            out_dim.d[1] = exprBuilder.constant(1);
+        }
+        // detection_boxes
+        else if (outputIndex == 1)
+        {
+            out_dim.nbDims = 3;
+            out_dim.d[0] = inputs[0].d[0];
+            out_dim.d[1] = numOutputBoxes;
+            out_dim.d[2] = exprBuilder.constant(4);
+        }
+        // detection_scores: outputIndex == 2
+        // detection_classes: outputIndex == 3
+        else if (outputIndex == 2 || outputIndex == 3)
+        {
+            out_dim.nbDims = 2;
+            out_dim.d[0] = inputs[0].d[0];
+            out_dim.d[1] = numOutputBoxes;
+        }
+
+        return out_dim;
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+    }
+    return DimsExprs{};
+}
+
+bool EfficientTopKPlugin::supportsFormatCombination(
+    int32_t pos, PluginTensorDesc const* inOut, int32_t nbInputs, int32_t nbOutputs) noexcept
+{
+    if (inOut[pos].format != PluginFormat::kLINEAR)
+    {
+        return false;
+    }
+
+    PLUGIN_ASSERT(nbInputs == 2);
+    PLUGIN_ASSERT(nbOutputs == 4);
+    PLUGIN_ASSERT(0 <= pos && pos < nbInputs + nbOutputs);
+
+    // num_detections and detection_classes output: int32_t
+    int32_t const posOut = pos - nbInputs;
+    if (posOut == 0 || posOut == 3)
+    {
+        return inOut[pos].type == DataType::kINT32 && inOut[pos].format == PluginFormat::kLINEAR;
+    }
+
+    // all other inputs/outputs: fp32 or fp16
+    return (inOut[pos].type == DataType::kHALF || inOut[pos].type == DataType::kFLOAT)
+        && (inOut[0].type == inOut[pos].type);
+}
+
+void EfficientTopKPlugin::configurePlugin(
+    DynamicPluginTensorDesc const* in, int32_t nbInputs, DynamicPluginTensorDesc const* out, int32_t nbOutputs) noexcept
+{
+    try
+    {
+        // Accepts two inputs: [0] boxes, [1] scores
+        PLUGIN_ASSERT(nbInputs == 2);
+        PLUGIN_ASSERT(nbOutputs == 4);
+
+        mParam.datatype = in[0].desc.type;
+
+        // Shape of scores input should be
+        // [batch_size, num_boxes, num_classes] or [batch_size, num_boxes, num_classes, 1]
+        PLUGIN_ASSERT(in[1].desc.dims.nbDims == 3 || (in[1].desc.dims.nbDims == 4 && in[1].desc.dims.d[3] == 1));
+        mParam.numScoreElements = in[1].desc.dims.d[1] * in[1].desc.dims.d[2];
+        mParam.numClasses = in[1].desc.dims.d[2];
+
+        // Shape of boxes input should be
+        // [batch_size, num_boxes, 4] or [batch_size, num_boxes, 1, 4]
+        PLUGIN_ASSERT(in[0].desc.dims.nbDims == 3 || (in[0].desc.dims.nbDims == 4 && in[0].desc.dims.d[2] == 1));
+        PLUGIN_ASSERT(in[0].desc.dims.d[in[0].desc.dims.nbDims - 1] == 4);
+        PLUGIN_ASSERT(in[0].desc.dims.d[1] == in[1].desc.dims.d[1]);
+        mParam.numAnchors = in[0].desc.dims.d[1];
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+    }
+}
+
+size_t EfficientTopKPlugin::getWorkspaceSize(
+    PluginTensorDesc const* inputs, int32_t nbInputs, PluginTensorDesc const* outputs, int32_t nbOutputs) const noexcept
+{
+    int32_t batchSize = inputs[1].dims.d[0];
+    int32_t numScoreElements = inputs[1].dims.d[1] * inputs[1].dims.d[2];
+    return EfficientTopKWorkspaceSize(batchSize, numScoreElements);
+}
+
+int32_t EfficientTopKPlugin::enqueue(PluginTensorDesc const* inputDesc, PluginTensorDesc const* /* outputDesc */,
+    void const* const* inputs, void* const* outputs, void* workspace, cudaStream_t stream) noexcept
+{
+    try
+    {
+        PLUGIN_VALIDATE(inputDesc != nullptr && inputs != nullptr && outputs != nullptr && workspace != nullptr);
+
+        mParam.batchSize = inputDesc[0].dims.d[0];
+
+        void const* const boxesInput = inputs[0];
+        void const* const scoresInput = inputs[1];
+
+        void* numDetectionsOutput = outputs[0];
+        void* topKBoxesOutput = outputs[1];
+        void* topKScoresOutput = outputs[2];
+        void* topKClassesOutput = outputs[3];
+
+        return EfficientTopKInference(mParam, boxesInput, scoresInput, numDetectionsOutput, topKBoxesOutput,
+            topKScoresOutput, topKClassesOutput, workspace, stream);
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+    }
+    return -1;
+}
+
+// Score Threshold, TopK and Gather Plugin Operation
+
+EfficientTopKPluginCreator::EfficientTopKPluginCreator()
+    : mParam{}
+{
+    mPluginAttributes.clear();
+    mPluginAttributes.emplace_back(PluginField("score_threshold", nullptr, PluginFieldType::kFLOAT32, 1));
+    mPluginAttributes.emplace_back(PluginField("max_output_boxes", nullptr, PluginFieldType::kINT32, 1));
+    mPluginAttributes.emplace_back(PluginField("score_activation", nullptr, PluginFieldType::kINT32, 1));
+    mPluginAttributes.emplace_back(PluginField("box_coding", nullptr, PluginFieldType::kINT32, 1));
+    mFC.nbFields = mPluginAttributes.size();
+    mFC.fields = mPluginAttributes.data();
+}
+
+char const* EfficientTopKPluginCreator::getPluginName() const noexcept
+{
+    return kEFFICIENT_TOPK_PLUGIN_NAME;
+}
+
+char const* EfficientTopKPluginCreator::getPluginVersion() const noexcept
+{
+    return kEFFICIENT_TOPK_PLUGIN_VERSION;
+}
+
+PluginFieldCollection const* EfficientTopKPluginCreator::getFieldNames() noexcept
+{
+    return &mFC;
+}
+
+IPluginV2DynamicExt* EfficientTopKPluginCreator::createPlugin(char const* name, PluginFieldCollection const* fc) noexcept
+{
+    try
+    {
+        PLUGIN_VALIDATE(fc != nullptr);
+        PluginField const* fields = fc->fields;
+        PLUGIN_VALIDATE(fields != nullptr);
+        plugin::validateRequiredAttributesExist({"score_threshold", "max_output_boxes"}, fc);
+        for (int32_t i{0}; i < fc->nbFields; ++i)
+        {
+            char const* attrName = fields[i].name;
+            if (!strcmp(attrName, "score_threshold"))
+            {
+                PLUGIN_VALIDATE(fields[i].type == PluginFieldType::kFLOAT32);
+                auto const scoreThreshold = *(static_cast<float const*>(fields[i].data));
+                PLUGIN_VALIDATE(scoreThreshold >= 0.0F);
+                mParam.scoreThreshold = scoreThreshold;
+            }
+            if (!strcmp(attrName, "max_output_boxes"))
+            {
+                PLUGIN_VALIDATE(fields[i].type == PluginFieldType::kINT32);
+                auto const numOutputBoxes = *(static_cast<int32_t const*>(fields[i].data));
+                PLUGIN_VALIDATE(numOutputBoxes > 0 && numOutputBoxes <= kEFFICIENT_TOPK_MAX_OUTPUT_BOXES);
+                mParam.numOutputBoxes = numOutputBoxes;
+            }
+            if (!strcmp(attrName, "score_activation"))
+            {
+                auto const scoreSigmoid = *(static_cast<int32_t const*>(fields[i].data));
+                PLUGIN_VALIDATE(scoreSigmoid == 0 || scoreSigmoid == 1);
+                mParam.scoreSigmoid = static_cast<bool>(scoreSigmoid);
+            }
+            if (!strcmp(attrName, "box_coding"))
+            {
+                PLUGIN_VALIDATE(fields[i].type == PluginFieldType::kINT32);
+                auto const boxCoding = *(static_cast<int32_t const*>(fields[i].data));
+                PLUGIN_VALIDATE(boxCoding == 0 || boxCoding == 1);
+                mParam.boxCoding = boxCoding;
+            }
+        }
+
+        auto* plugin = new EfficientTopKPlugin(mParam);
+        plugin->setPluginNamespace(mNamespace.c_str());
+        return plugin;
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+    }
+    return nullptr;
+}
+
+IPluginV2DynamicExt* EfficientTopKPluginCreator::deserializePlugin(
+    char const* name, void const* serialData, size_t serialLength) noexcept
+{
+    try
+    {
+        // This object will be deleted when the network is destroyed, which will
+        // call EfficientTopKPlugin::destroy()
+        auto* plugin = new EfficientTopKPlugin(serialData, serialLength);
+        plugin->setPluginNamespace(mNamespace.c_str());
+        return plugin;
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+    }
+    return nullptr;
+}
@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "common/topKSelect.h"
+
+#include "efficientTopKReference.h"
+
+using namespace nvinfer1;
+using namespace nvinfer1::plugin;
+
+namespace
+{
+
+// Rounds a float to the nearest value representable in half precision (round to nearest even).
+float roundToHalf(float value)
+{
+    if (!std::isfinite(value) || value == 0.f)
+    {
+        return value;
+    }
+    int exponent = 0;
+    std::frexp(value, &exponent);
+    // Half precision keeps 11 significant bits, subnormals have a fixed step of 2^-24.
+    float const step = std::ldexp(1.f, std::max(exponent - 11, -24));
+    float const rounded = std::nearbyint(value / step) * step;
+    return std::fabs(rounded) > 65504.f ? std::copysign(INFINITY, value) : rounded;
+}
+
+// Same composite key as EfficientTopKKey in efficientTopKInference.cu.
+uint64_t candidateKey(float score, int32_t elementIdx)
+{
+    return (static_cast<uint64_t>(topKSelectKey(score)) << 32) | static_cast<uint32_t>(~elementIdx);
+}
+
+} // namespace
+
+pluginStatus_t EfficientTopKReference(EfficientTopKParameters param, float const* boxesInput,
+    float const* scoresInput, int32_t* numDetectionsOutput, float* topKBoxesOutput, float* topKScoresOutput,
+    int32_t* topKClassesOutput)
+{
+    bool const half = param.datatype == DataType::kHALF;
+    if (!half && param.datatype != DataType::kFLOAT)
+    {
+        return STATUS_NOT_SUPPORTED;
+    }
+    auto const store = [half](float value) { return half ? roundToHalf(value) : value; };
+
+    std::fill_n(numDetectionsOutput, param.batchSize, 0);
+    std::fill_n(topKBoxesOutput, static_cast<size_t>(param.batchSize) * param.numOutputBoxes * 4, 0.f);
+    std::fill_n(topKScoresOutput, static_cast<size_t>(param.batchSize) * param.numOutputBoxes, 0.f);
+    std::fill_n(topKClassesOutput, static_cast<size_t>(param.batchSize) * param.numOutputBoxes, 0);
+
+    float threshold = param.scoreThreshold;
+    if (param.scoreSigmoid)
+    {
+        // Inverse Sigmoid
+        threshold = threshold <= 0.f ? -(1 << 15) : std::log(threshold / (1.f - threshold));
+    }
+    threshold = store(threshold);
+
+    std::vector<uint64_t> keys;
+    for (int32_t imageIdx = 0; imageIdx < param.batchSize; imageIdx++)
+    {
+        float const* scores = scoresInput + static_cast<size_t>(imageIdx) * param.numScoreElements;
+        keys.clear();
+        for (int32_t elementIdx = 0; elementIdx < param.numScoreElements; elementIdx++)
+        {
+            if (scores[elementIdx] >= threshold)
+            {
+                keys.push_back(candidateKey(scores[elementIdx], elementIdx));
+            }
+        }
+
+        int32_t const numOutputBoxes = std::min(static_cast<int32_t>(keys.size()), param.numOutputBoxes);
+        std::partial_sort(keys.begin(), keys.begin() + numOutputBoxes, keys.end(), std::greater<uint64_t>());
+
+        for (int32_t i = 0; i < numOutputBoxes; i++)
+        {
+            int32_t const elementIdx = static_cast<int32_t>(~static_cast<uint32_t>(keys[i]));
+            int32_t const anchorIdx = elementIdx / param.numClasses;
+            size_t const outputIdx = static_cast<size_t>(imageIdx) * param.numOutputBoxes + i;
+
+            float const score = scores[elementIdx];
+            topKScoresOutput[outputIdx] = store(param.scoreSigmoid ? 1.f / (1.f + std::exp(-score)) : score);
+            topKClassesOutput[outputIdx] = elementIdx % param.numClasses;
+
+            float const* box = boxesInput + (static_cast<size_t>(imageIdx) * param.numAnchors + anchorIdx) * 4;
+            float b0 = box[0];
+            float b1 = box[1];
+            float b2 = box[2];
+            float b3 = box[3];
+            if (param.boxCoding == 1)
+            {
+                float const h2 = b2 * 0.5f;
+                float const w2 = b3 * 0.5f;
+                b2 = b0 + h2;
+                b3 = b1 + w2;
+                b0 -= h2;
+                b1 -= w2;
+            }
+            float* output = topKBoxesOutput + outputIdx * 4;
+            output[0] = store(b0);
+            output[1] = store(b1);
+            output[2] = store(b2);
+            output[3] = store(b3);
+        }
+        numDetectionsOutput[imageIdx] = numOutputBoxes;
+    }
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_EFFICIENT_TOPK_REFERENCE_H
+#define TRT_EFFICIENT_TOPK_REFERENCE_H
+
+#include "common/plugin.h"
+
+#include "efficientTopKParameters.h"
+
+// Host implementation of EfficientTopKInference.
+//
+// All buffers live in host memory and hold float32 values laid out exactly like the plugin tensors:
+//   boxesInput:          [batchSize, numAnchors, 4]
+//   scoresInput:         [batchSize, numAnchors, numClasses]
+//   numDetectionsOutput: [batchSize]
+//   topKBoxesOutput:     [batchSize, numOutputBoxes, 4]
+//   topKScoresOutput, topKClassesOutput: [batchSize, numOutputBoxes]
+//
+// Candidates are ordered by score, then by element index, like the 64-bit keys of the CUDA kernels, so the
+// outputs match the plugin exactly, ties included. When param.datatype is kHALF, the threshold and the outputs
+// are rounded to half precision; scores are expected to already hold half precision values.
+pluginStatus_t EfficientTopKReference(nvinfer1::plugin::EfficientTopKParameters param, float const* boxesInput,
+    float const* scoresInput, int32_t* numDetectionsOutput, float* topKBoxesOutput, float* topKScoresOutput,
+    int32_t* topKClassesOutput);
+
+#endif
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "deploy/core/profiler.hpp"
+
+namespace deploy {
+
+namespace {
+
+// Escapes a string for use inside a JSON string literal.
+std::string escapeJson(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '\r':
+                escaped += "\\r";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+}  // namespace
+
+void LayerProfiler::reportLayerTime(const char* layerName, float ms) noexcept {
+    try {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto inserted = mIndex.emplace(layerName, mLayers.size());
+        if (inserted.second) {
+            mLayers.push_back(LayerTiming{layerName});
+            mSeen.push_back(false);
+        }
+        size_t idx = inserted.first->second;
+
+        // A layer reported twice marks the beginning of a new run
+        if (mRuns == 0 || mSeen[idx]) {
+            mRuns++;
+            std::fill(mSeen.begin(), mSeen.end(), false);
+            if (static_cast<int>(mTrace.size()) < mMaxTraceRuns) {
+                mTrace.emplace_back();
+            }
+        }
+        mSeen[idx] = true;
+
+        auto& layer = mLayers[idx];
+        layer.min   = layer.count == 0 ? ms : std::min(layer.min, ms);
+        layer.max   = layer.count == 0 ? ms : std::max(layer.max, ms);
+        layer.total += ms;
+        layer.count++;
+
+        if (static_cast<int>(mTrace.size()) == mRuns) {
+            mTrace.back().emplace_back(idx, ms);
+        }
+    } catch (...) {
+        // Never propagate exceptions into TensorRT
+    }
+}
+
+void LayerProfiler::reset() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRuns = 0;
+    mSeen.clear();
+    mLayers.clear();
+    mIndex.clear();
+    mTrace.clear();
+}
+
+int LayerProfiler::runs() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mRuns;
+}
+
+std::vector<LayerTiming> LayerProfiler::layers() const {
+    std::vector<LayerTiming> layers;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        layers = mLayers;
+    }
+    std::stable_sort(layers.begin(), layers.end(), [](const LayerTiming& a, const LayerTiming& b) { return a.total > b.total; });
+    return layers;
+}
+
+void LayerProfiler::writeChromeTrace(std::ostream& out) const {
+    // Formatted in a local stream, so that the formatting of the caller's stream is left unchanged
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"TensorRT engine\"}}";
+
+    // Timestamps and durations are expressed in microseconds
+    double timestamp = 0.0;
+    for (size_t run = 0; run < mTrace.size(); ++run) {
+        for (const auto& execution : mTrace[run]) {
+            double duration = static_cast<double>(execution.second) * 1000.0;
+            os << ",\n{\"name\":\"" << escapeJson(mLayers[execution.first].name) << "\",\"cat\":\"layer\",\"ph\":\"X\""
+               << ",\"pid\":0,\"tid\":0,\"ts\":" << timestamp << ",\"dur\":" << duration
+               << ",\"args\":{\"run\":" << run << "}}";
+            timestamp += duration;
+        }
+    }
+    os << "\n]}\n";
+    out << os.str();
+}
+
+void LayerProfiler::writeTable(std::ostream& os) const {
+    os << table();
+}
+
+void LayerProfiler::exportChromeTrace(const std::string& filePath) const {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + filePath);
+    }
+    writeChromeTrace(file);
+    if (!file) {
+        throw std::runtime_error("Error writing file: " + filePath);
+    }
+}
+
+std::string LayerProfiler::table() const {
+    std::ostringstream os;
+    auto               sorted = layers();
+
+    float  total     = 0.0F;
+    size_t nameWidth = 5;
+    for (const auto& layer : sorted) {
+        total     += layer.total;
+        nameWidth  = std::max(nameWidth, layer.name.size());
+    }
+
+    os << std::left << std::setw(static_cast<int>(nameWidth)) << "Layer" << std::right
+       << std::setw(8) << "Count" << std::setw(14) << "Total (ms)" << std::setw(12) << "Mean (ms)"
+       << std::setw(12) << "Min (ms)" << std::setw(12) << "Max (ms)" << std::setw(9) << "Share" << "\n";
+    os << std::string(nameWidth + 67, '-') << "\n";
+
+    os << std::fixed << std::setprecision(4);
+    for (const auto& layer : sorted) {
+        float share = total > 0.0F ? layer.total / total * 100.0F : 0.0F;
+        os << std::left << std::setw(static_cast<int>(nameWidth)) << layer.name << std::right
+           << std::setw(8) << layer.count << std::setw(14) << layer.total << std::setw(12) << layer.mean()
+           << std::setw(12) << layer.min << std::setw(12) << layer.max
+           << std::setw(8) << std::setprecision(2) << share << "%" << std::setprecision(4) << "\n";
+    }
+
+    os << std::string(nameWidth + 67, '-') << "\n";
+    os << std::left << std::setw(static_cast<int>(nameWidth)) << "Total" << std::right
+       << std::setw(22) << total << "  over " << runs() << " run(s)\n";
+    return os.str();
+}
+
+}  // namespace deploy
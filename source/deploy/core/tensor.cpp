@@ -1,13 +1,39 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
 
 #include "deploy/core/macro.hpp"
 #include "deploy/core/tensor.hpp"
 
 namespace deploy {
 
+void Tensor::freeHost() {
+    if (hostPtr == nullptr) return;
+    if (hostPinned) {
+        CUDA(cudaFreeHost(hostPtr));
+    } else {
+        std::free(hostPtr);
+    }
+    hostPtr = nullptr;
+}
+
 void Tensor::reallocHost(int64_t bytes) {
     if (hostCap < bytes) {
-        CUDA(cudaFreeHost(hostPtr));
-        CUDA(cudaMallocHost(&hostPtr, bytes));
+        freeHost();
+        // Fall back to pageable memory when page-locked memory is unavailable, e.g. without a GPU
+        cudaError_t status = cudaMallocHost(&hostPtr, bytes);
+        hostPinned         = status == cudaSuccess;
+        if (!hostPinned) {
+            cudaGetLastError();
+            hostPtr = std::malloc(bytes);
+
+            // Copies from pageable memory are synchronous, which serializes the pipeline, so say it once
+            static std::atomic<bool> warned{false};
+            if (!warned.exchange(true)) {
+                std::cerr << "Warning: Page-locked host memory is unavailable (" << cudaGetErrorString(status)
+                          << "), falling back to pageable memory, host to device copies will be synchronous." << std::endl;
+            }
+        }
         hostCap = bytes;
     }
     hostBytes = bytes;
@@ -23,9 +49,7 @@ void Tensor::reallocDevice(int64_t bytes) {
 }
 
 Tensor::~Tensor() {
-    if (hostPtr != nullptr) {
-        CUDA(cudaFreeHost(hostPtr));
-    }
+    freeHost();
     if (devicePtr != nullptr) {
         CUDA(cudaFree(devicePtr));
     }
@@ -2,10 +2,13 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
 
+#include "deploy/core/profiler.hpp"
+#include "deploy/utils/stats.hpp"
 #include "deploy/utils/utils.hpp"
 #include "deploy/vision/inference.hpp"
 #include "deploy/vision/result.hpp"
@@ -47,9 +50,32 @@ pybind11::array_t<uint8_t> Mask2PyArray(const deploy::Mask &mask) {
         {sizeof(uint8_t) * mask.width, sizeof(uint8_t)}));
 }
 
+// View the key points of a PoseResult as a (num, nkpt, ndim) NumPy array, kept valid by the owner object
+pybind11::array_t<float> KeyPoints2PyArray(const deploy::PoseResult &pr, pybind11::handle owner) {
+    // The leading dimension comes from the buffer itself, so a num out of sync with it never exposes memory past its end
+    size_t stride = static_cast<size_t>(pr.nkpt) * pr.ndim;
+    size_t count  = stride > 0 ? pr.kpts.size() / stride : 0;
+    return pybind11::array_t<float>(
+        {static_cast<pybind11::ssize_t>(count), static_cast<pybind11::ssize_t>(pr.nkpt), static_cast<pybind11::ssize_t>(pr.ndim)},
+        {sizeof(float) * pr.nkpt * pr.ndim, sizeof(float) * pr.ndim, sizeof(float)},
+        pr.kpts.data(),
+        owner);
+}
+
+// Copy a (num, nkpt, ndim) NumPy array into the key points of a PoseResult, taking num, nkpt and ndim from its shape
+void PyArray2KeyPoints(const pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast> &array, deploy::PoseResult &pr) {
+    if (array.ndim() != 3 || (array.shape(2) != 2 && array.shape(2) != 3)) {
+        throw std::invalid_argument("Key points must be a (num, nkpt, 2) or (num, nkpt, 3) array.");
+    }
+    pr.num  = static_cast<int>(array.shape(0));
+    pr.nkpt = static_cast<int>(array.shape(1));
+    pr.ndim = static_cast<int>(array.shape(2));
+    pr.kpts.assign(array.data(), array.data() + array.size());
+}
+
 // Bind utility classes
 void BindUtils(pybind11::module &m) {
-    m.doc() = "Python bindings for CpuTimer and GpuTimer using Pybind11";
+    m.doc() = "Python bindings for CpuTimer, GpuTimer and latency statistics using Pybind11";
 
     pybind11::class_<TimerBase>(m, "TimerBase", "Base class for timers.")
         .def(pybind11::init<>())
@@ -65,10 +91,50 @@ void BindUtils(pybind11::module &m) {
         .def("start", &GpuTimer::start, "Starts the GPU timer.")
         .def("stop", &GpuTimer::stop, "Stops the GPU timer.");
 
+    pybind11::class_<DeferredGpuTimer, TimerBase>(m, "DeferredGpuTimer", "Class for GPU timer that resolves elapsed times lazily without blocking.")
+        .def(pybind11::init([](int capacity) { return std::make_unique<DeferredGpuTimer>(nullptr, capacity); }), pybind11::arg("capacity") = 64)
+        .def("start", &DeferredGpuTimer::start, "Records the start event of a new pair.")
+        .def("stop", &DeferredGpuTimer::stop, "Records the stop event of the current pair without waiting for it.")
+        .def("reset", &DeferredGpuTimer::reset, "Discards pending pairs and all aggregated samples.")
+        .def("collect", &DeferredGpuTimer::collect, "Resolves every pending pair whose events have completed, without blocking.")
+        .def("flush", &DeferredGpuTimer::flush, "Waits for and resolves every pending pair.")
+        .def("pending", &DeferredGpuTimer::pending, "Gets the number of pairs recorded but not resolved yet.")
+        .def("summary", &DeferredGpuTimer::summary, "Gets the distribution of the resolved elapsed times.");
+
     pybind11::class_<CpuTimer, TimerBase>(m, "CpuTimer", "Class for CPU timer using high resolution clock.")
         .def(pybind11::init<>())
         .def("start", &CpuTimer::start, "Starts the CPU timer.")
         .def("stop", &CpuTimer::stop, "Stops the CPU timer and calculates the elapsed time.");
+
+    pybind11::class_<LatencySummary>(m, "LatencySummary", "Summary statistics of a latency distribution, in milliseconds.")
+        .def(pybind11::init<>())
+        .def_readonly("count", &LatencySummary::count)
+        .def_readonly("total", &LatencySummary::total)
+        .def_readonly("min", &LatencySummary::min)
+        .def_readonly("mean", &LatencySummary::mean)
+        .def_readonly("max", &LatencySummary::max)
+        .def_readonly("p50", &LatencySummary::p50)
+        .def_readonly("p90", &LatencySummary::p90)
+        .def_readonly("p99", &LatencySummary::p99)
+        .def_readonly("p999", &LatencySummary::p999)
+        .def("__str__", [](const LatencySummary &ls) {
+            std::ostringstream oss;
+            oss << "LatencySummary(count=" << ls.count << ", min=" << ls.min << ", mean=" << ls.mean
+                << ", max=" << ls.max << ", p50=" << ls.p50 << ", p90=" << ls.p90
+                << ", p99=" << ls.p99 << ", p999=" << ls.p999 << ")";
+            return oss.str();
+        });
+
+    pybind11::class_<StageStats>(m, "StageStats", "Latency summary of a single pipeline stage.")
+        .def(pybind11::init<>())
+        .def_readonly("stage", &StageStats::stage)
+        .def_readonly("latency", &StageStats::latency)
+        .def("__str__", [](const StageStats &ss) {
+            std::ostringstream oss;
+            oss << "StageStats(stage=" << ss.stage << ", count=" << ss.latency.count << ", mean=" << ss.latency.mean
+                << ", p50=" << ss.latency.p50 << ", p99=" << ss.latency.p99 << ")";
+            return oss.str();
+        });
 }
 
 // Bind result classes
@@ -301,7 +367,33 @@ void BindResult(pybind11::module &m) {
     // Bind PoseResult structure
     pybind11::class_<PoseResult, DetResult>(m, "PoseResult")
         .def(pybind11::init<>())
-        .def_readwrite("kpts", &PoseResult::kpts)
+        .def_readonly("nkpt", &PoseResult::nkpt)
+        .def_readonly("ndim", &PoseResult::ndim)
+        .def_property(
+            "kpts",
+            // Getter: view of the key point buffer as a (num, nkpt, ndim) array, without copying
+            [](pybind11::object self) {
+                const auto &pr = self.cast<const PoseResult &>();
+                return KeyPoints2PyArray(pr, self);
+            },
+            // Setter: copy a (num, nkpt, ndim) array into the key point buffer, num, nkpt and ndim following its shape
+            [](PoseResult &pr, pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast> kpts) {
+                PyArray2KeyPoints(kpts, pr);
+            })
+        .def(
+            "keypoints", [](const PoseResult &pr, int i) {
+                if (i < 0 || static_cast<size_t>(i + 1) * pr.nkpt * pr.ndim > pr.kpts.size()) {
+                    throw pybind11::index_error("Detection index out of range.");
+                }
+                auto                  view = pr.keypoints(i);
+                std::vector<KeyPoint> keypoints;
+                keypoints.reserve(view.size());
+                for (int j = 0; j < view.size(); ++j) {
+                    keypoints.push_back(view[j]);
+                }
+                return keypoints;
+            },
+            pybind11::arg("i"), "Gets the key points of detection i as a list of KeyPoint.")
         .def("__copy__", [](const PoseResult &self) {
             return PoseResult(self);
         })
@@ -326,25 +418,28 @@ void BindResult(pybind11::module &m) {
                     << ", right=" << pr.boxes[i].right << ", bottom=" << pr.boxes[i].bottom << "),\n";
             }
             oss << "], kpts=[\n";
-            for (size_t i = 0; i < pr.kpts.size(); ++i) {
+            for (int i = 0; i < pr.num; ++i) {
+                auto keypoints = pr.keypoints(i);
                 oss << "    [";
-                for (size_t j = 0; j < pr.kpts[i].size(); ++j) {
-                    oss << "KeyPoint(x=" << pr.kpts[i][j].x << ", y=" << pr.kpts[i][j].y;
-                    if (pr.kpts[i][j].conf) {
-                        oss << ", conf=" << *pr.kpts[i][j].conf;
+                for (int j = 0; j < keypoints.size(); ++j) {
+                    oss << "KeyPoint(x=" << keypoints.x(j) << ", y=" << keypoints.y(j);
+                    if (auto conf = keypoints.conf(j)) {
+                        oss << ", conf=" << *conf;
                     } else {
                         oss << ", conf=None";
                     }
                     oss << ")";
-                    if (j != pr.kpts[i].size() - 1) oss << ", ";
+                    if (j != keypoints.size() - 1) oss << ", ";
                 }
                 oss << "]";
-                if (i != pr.kpts.size() - 1) oss << ",\n";
+                if (i != pr.num - 1) oss << ",\n";
             }
             oss << "])";
             return oss.str();
         })
-        .def(pybind11::pickle([](const PoseResult &pr) { return pybind11::make_tuple(pr.num, pr.boxes, pr.classes, pr.scores, pr.kpts); }, [](pybind11::tuple t) {
+        .def(pybind11::pickle([](pybind11::object self) {
+            const auto &pr = self.cast<const PoseResult &>();
+            return pybind11::make_tuple(pr.num, pr.boxes, pr.classes, pr.scores, KeyPoints2PyArray(pr, self).attr("copy")()); }, [](pybind11::tuple t) {
             if (t.size() != 5)
                 throw std::runtime_error("Invalid state!");
 
@@ -353,7 +448,11 @@ void BindResult(pybind11::module &m) {
             pr.boxes = t[1].cast<std::vector<Box>>();
             pr.classes = t[2].cast<std::vector<int>>();
             pr.scores = t[3].cast<std::vector<float>>();
-            pr.kpts = t[4].cast<std::vector<std::vector<KeyPoint>>>();
+
+            auto kpts = t[4].cast<pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast>>();
+            if (kpts.ndim() != 3 || kpts.shape(0) != pr.num)
+                throw std::runtime_error("Invalid state!");
+            PyArray2KeyPoints(kpts, pr);
             return pr; }));
 }
 
@@ -375,6 +474,13 @@ void BindClsTemplate(pybind11::module &m, const std::string &className) {
                     images.push_back(PyArray2Image(pyimg));
                 }
                 return self.predict(images); }, "Predict the results from a list of images")
+        .def("stats", &ClassType::stats, "Get the latency distribution of each pipeline stage")
+        .def("reset_stats", &ClassType::resetStats, "Discard all recorded stage latencies")
+        .def("set_stats_enabled", &ClassType::setStatsEnabled, pybind11::arg("enabled"), "Enable or disable the collection of stage latencies")
+        .def("set_nvtx_enabled", &ClassType::setNvtxEnabled, pybind11::arg("enabled"), "Enable or disable NVTX ranges for each pipeline stage")
+        .def("set_profiler", &ClassType::setProfiler, pybind11::arg("profiler").none(true), "Attach a layer profiler to the execution context, or detach it with None")
+        .def("set_postprocess_threads", &ClassType::setPostProcessThreads, pybind11::arg("threads"), "Post-process the images of a batch on this many threads, 1 or less to post-process serially")
+        .def("set_thresholds", &ClassType::setThresholds, pybind11::arg("score_threshold"), pybind11::arg("iou_threshold"), pybind11::arg("max_boxes"), pybind11::arg("class_score_thresholds") = std::vector<float>{}, "Update the NMS thresholds of an engine exported with runtime thresholds, negative values keep the exported ones")
         .def_readwrite("batch", &ClassType::batch, "Batch size for prediction");
 }
 
@@ -382,6 +488,36 @@ void BindClsTemplate(pybind11::module &m, const std::string &className) {
 void BindInference(pybind11::module &m) {
     m.doc() = "Bindings for inference classes, including DeployDet, DeployCGDet, DeployOBB, DeployCGOBB, DeploySeg, DeployCGSeg, DeployPose, and DeployCGPose.";
 
+    // bind LayerTiming
+    pybind11::class_<LayerTiming>(m, "LayerTiming", "Aggregated execution time of a single engine layer, in milliseconds.")
+        .def(pybind11::init<>())
+        .def_readonly("name", &LayerTiming::name)
+        .def_readonly("count", &LayerTiming::count)
+        .def_readonly("total", &LayerTiming::total)
+        .def_readonly("min", &LayerTiming::min)
+        .def_readonly("max", &LayerTiming::max)
+        .def_property_readonly("mean", &LayerTiming::mean)
+        .def("__str__", [](const LayerTiming &lt) {
+            std::ostringstream oss;
+            oss << "LayerTiming(name=" << lt.name << ", count=" << lt.count << ", total=" << lt.total
+                << ", mean=" << lt.mean() << ", min=" << lt.min << ", max=" << lt.max << ")";
+            return oss.str();
+        });
+
+    // bind LayerProfiler
+    pybind11::class_<LayerProfiler, std::shared_ptr<LayerProfiler>>(m, "LayerProfiler", "TensorRT profiler that accumulates per-layer execution times over several runs.")
+        .def(pybind11::init<int>(), pybind11::arg("max_trace_runs") = 100)
+        .def("report_layer_time", &LayerProfiler::reportLayerTime, pybind11::arg("layer_name"), pybind11::arg("ms"), "Record the execution time of a layer")
+        .def("reset", &LayerProfiler::reset, "Discard all recorded runs")
+        .def("runs", &LayerProfiler::runs, "Get the number of runs recorded so far")
+        .def("layers", &LayerProfiler::layers, "Get the aggregated layer timings, sorted by total time")
+        .def("table", &LayerProfiler::table, "Get the aggregated layer timings as a text table")
+        .def("chrome_trace", [](const LayerProfiler &self) {
+                std::ostringstream oss;
+                self.writeChromeTrace(oss);
+                return oss.str(); }, "Get the recorded runs as a Chrome trace_event JSON document")
+        .def("export_chrome_trace", &LayerProfiler::exportChromeTrace, pybind11::arg("file"), "Write the Chrome trace_event JSON document to a file");
+
     // bind DeployDet
     BindClsTemplate<DeployDet>(m, "DeployDet");
 
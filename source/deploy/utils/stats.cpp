@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if __has_include(<nvtx3/nvToolsExt.h>)
+#include <nvtx3/nvToolsExt.h>
+#define DEPLOY_HAS_NVTX 1
+#endif
+
+#include "deploy/core/macro.hpp"
+#include "deploy/utils/stats.hpp"
+
+namespace deploy {
+
+namespace {
+
+constexpr float nanosecondsPerMillisecond = 1e6F;
+
+// Index of the most significant set bit of a non-zero value.
+inline int mostSignificantBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value) noexcept {
+    if (value < static_cast<uint64_t>(subBucketCount)) {
+        return static_cast<int>(value);
+    }
+    int shift = mostSignificantBit(value) - subBucketBits;
+    if (shift > maxShift) {
+        return bucketCount - 1;
+    }
+    return (shift + 1) * subBucketCount + static_cast<int>(value >> shift) - subBucketCount;
+}
+
+uint64_t LatencyHistogram::bucketValue(int index) noexcept {
+    if (index < subBucketCount) {
+        return static_cast<uint64_t>(index);
+    }
+    int      shift = index / subBucketCount - 1;
+    uint64_t low   = static_cast<uint64_t>(index % subBucketCount + subBucketCount) << shift;
+    return low + ((uint64_t{1} << shift) >> 1);
+}
+
+void LatencyHistogram::record(float milliseconds) noexcept {
+    uint64_t value = milliseconds > 0.0F ? static_cast<uint64_t>(std::llround(milliseconds * nanosecondsPerMillisecond)) : 0;
+
+    mBuckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = mMin.load(std::memory_order_relaxed);
+    while (value < current && !mMin.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+    current = mMax.load(std::memory_order_relaxed);
+    while (value > current && !mMax.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& bucket : mBuckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    mCount.store(0, std::memory_order_relaxed);
+    mSum.store(0, std::memory_order_relaxed);
+    mMin.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    mMax.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const noexcept {
+    return mCount.load(std::memory_order_relaxed);
+}
+
+float LatencyHistogram::percentile(float percent) const noexcept {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0.0F;
+    }
+
+    percent         = std::min(std::max(percent, 0.0F), 100.0F);
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percent / 100.0 * total)));
+
+    uint64_t cumulative = 0;
+    uint64_t value      = mMax.load(std::memory_order_relaxed);
+    for (int i = 0; i < bucketCount; ++i) {
+        cumulative += mBuckets[i].load(std::memory_order_relaxed);
+        if (cumulative >= target) {
+            value = bucketValue(i);
+            break;
+        }
+    }
+
+    // Bucket midpoints may fall outside the observed range
+    value = std::min(std::max(value, mMin.load(std::memory_order_relaxed)), mMax.load(std::memory_order_relaxed));
+    return static_cast<float>(value) / nanosecondsPerMillisecond;
+}
+
+LatencySummary LatencyHistogram::summary() const noexcept {
+    LatencySummary summary;
+    summary.count = count();
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    summary.total = static_cast<float>(mSum.load(std::memory_order_relaxed)) / nanosecondsPerMillisecond;
+    summary.min   = static_cast<float>(mMin.load(std::memory_order_relaxed)) / nanosecondsPerMillisecond;
+    summary.max   = static_cast<float>(mMax.load(std::memory_order_relaxed)) / nanosecondsPerMillisecond;
+    summary.mean  = summary.total / static_cast<float>(summary.count);
+    summary.p50   = percentile(50.0F);
+    summary.p90   = percentile(90.0F);
+    summary.p99   = percentile(99.0F);
+    summary.p999  = percentile(99.9F);
+    return summary;
+}
+
+const char* stageName(Stage stage) {
+    switch (stage) {
+        case Stage::kStaging:
+            return "staging";
+        case Stage::kH2D:
+            return "h2d";
+        case Stage::kWarp:
+            return "warp";
+        case Stage::kEnqueue:
+            return "enqueue";
+        case Stage::kD2H:
+            return "d2h";
+        case Stage::kPostProcess:
+            return "postprocess";
+        case Stage::kGraph:
+            return "graph";
+        default:
+            return "unknown";
+    }
+}
+
+InferenceStats::~InferenceStats() {
+    recycle(mCurrent);
+    for (auto& frame : mPending) {
+        recycle(frame);
+    }
+    for (auto& event : mFreeEvents) {
+        CUDA(cudaEventDestroy(event));
+    }
+}
+
+void InferenceStats::record(Stage stage, float milliseconds) noexcept {
+    if (!enabled()) return;
+    mHistograms[static_cast<int>(stage)].record(milliseconds);
+}
+
+int InferenceStats::mark(cudaStream_t stream) {
+    if (!enabled()) return -1;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    cudaEvent_t                 event = nullptr;
+    if (mFreeEvents.empty()) {
+        if (!CUDA(cudaEventCreate(&event))) return -1;
+    } else {
+        event = mFreeEvents.back();
+        mFreeEvents.pop_back();
+    }
+
+    if (!CUDA(cudaEventRecord(event, stream))) {
+        mFreeEvents.push_back(event);
+        return -1;
+    }
+    mCurrent.events.push_back(event);
+    return static_cast<int>(mCurrent.events.size()) - 1;
+}
+
+void InferenceStats::span(Stage stage, int start, int stop) {
+    if (start < 0 || stop < 0) return;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCurrent.spans.push_back({stage, start, stop});
+}
+
+void InferenceStats::commit() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mCurrent.spans.empty()) {
+        recycle(mCurrent);
+        return;
+    }
+
+    mPending.push_back(std::move(mCurrent));
+    mCurrent = Frame{};
+
+    // Drop the oldest frame if resolution falls too far behind
+    if (mPending.size() > maxPendingFrames) {
+        recycle(mPending.front());
+        mPending.pop_front();
+    }
+}
+
+void InferenceStats::collect() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto it = mPending.begin(); it != mPending.end();) {
+        bool ready  = true;
+        bool failed = false;
+        for (auto& event : it->events) {
+            cudaError_t status = cudaEventQuery(event);
+            if (status == cudaErrorNotReady) {
+                ready = false;
+                break;
+            }
+            if (status != cudaSuccess) {
+                failed = true;
+                break;
+            }
+        }
+
+        if (!ready) {
+            ++it;
+            continue;
+        }
+
+        if (!failed) {
+            for (auto& span : it->spans) {
+                float milliseconds = 0.0F;
+                if (cudaEventElapsedTime(&milliseconds, it->events[span.start], it->events[span.stop]) == cudaSuccess) {
+                    mHistograms[static_cast<int>(span.stage)].record(milliseconds);
+                }
+            }
+        }
+
+        recycle(*it);
+        it = mPending.erase(it);
+    }
+}
+
+std::vector<StageStats> InferenceStats::summary() {
+    collect();
+
+    std::vector<StageStats> stats;
+    for (int i = 0; i < static_cast<int>(Stage::kCount); ++i) {
+        if (mHistograms[i].count() == 0) continue;
+        stats.push_back({stageName(static_cast<Stage>(i)), mHistograms[i].summary()});
+    }
+    return stats;
+}
+
+void InferenceStats::reset() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    recycle(mCurrent);
+    for (auto& frame : mPending) {
+        recycle(frame);
+    }
+    mPending.clear();
+    for (auto& histogram : mHistograms) {
+        histogram.reset();
+    }
+}
+
+void InferenceStats::recycle(Frame& frame) {
+    mFreeEvents.insert(mFreeEvents.end(), frame.events.begin(), frame.events.end());
+    frame.events.clear();
+    frame.spans.clear();
+}
+
+NvtxRange::NvtxRange(const char* name, bool enabled) {
+#ifdef DEPLOY_HAS_NVTX
+    if (enabled) {
+        nvtxRangePushA(name);
+        mActive = true;
+    }
+#else
+    (void)name;
+    (void)enabled;
+#endif
+}
+
+NvtxRange::~NvtxRange() {
+#ifdef DEPLOY_HAS_NVTX
+    if (mActive) {
+        nvtxRangePop();
+    }
+#endif
+}
+
+}  // namespace deploy
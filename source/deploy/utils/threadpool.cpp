@@ -0,0 +1,88 @@
+#include "deploy/utils/threadpool.hpp"
+
+namespace deploy {
+
+ThreadPool::ThreadPool(int threads) {
+    mWorkers.reserve(threads > 0 ? threads : 0);
+    for (int i = 0; i < threads; ++i) {
+        mWorkers.emplace_back(&ThreadPool::worker, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    for (auto& thread : mWorkers) {
+        thread.join();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& task) {
+    if (count <= 0) return;
+
+    // Nothing to share: skip the hand-off to the workers
+    if (mWorkers.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(mSubmitMutex);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTask  = &task;
+        mCount = count;
+        mNext.store(0, std::memory_order_relaxed);
+        mBusy  = static_cast<int>(mWorkers.size());
+        mError = nullptr;
+        ++mGeneration;
+    }
+    mWake.notify_all();
+
+    drain();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [this] { return mBusy == 0; });
+        mTask = nullptr;
+        std::swap(error, mError);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::worker() {
+    uint64_t generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [&] { return mStop || mGeneration != generation; });
+            if (mStop) return;
+            generation = mGeneration;
+        }
+
+        drain();
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (--mBusy == 0) mDone.notify_one();
+        }
+    }
+}
+
+void ThreadPool::drain() {
+    for (int i = mNext.fetch_add(1, std::memory_order_relaxed); i < mCount; i = mNext.fetch_add(1, std::memory_order_relaxed)) {
+        try {
+            (*mTask)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mError) mError = std::current_exception();
+        }
+    }
+}
+
+}  // namespace deploy
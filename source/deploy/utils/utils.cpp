@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -62,4 +63,84 @@ void GpuTimer::stop() {
     setMilliseconds(getMilliseconds() + milliseconds);
 }
 
+DeferredGpuTimer::DeferredGpuTimer(cudaStream_t stream, int capacity)
+    : mStream(stream) {
+    capacity = std::max(capacity, 1);
+    mStarts.resize(capacity);
+    mStops.resize(capacity);
+    for (int i = 0; i < capacity; ++i) {
+        CUDA(cudaEventCreate(&mStarts[i]));
+        CUDA(cudaEventCreate(&mStops[i]));
+    }
+}
+
+DeferredGpuTimer::~DeferredGpuTimer() {
+    for (size_t i = 0; i < mStarts.size(); ++i) {
+        CUDA(cudaEventDestroy(mStarts[i]));
+        CUDA(cudaEventDestroy(mStops[i]));
+    }
+}
+
+void DeferredGpuTimer::start() {
+    // The ring is full, make room by waiting for the oldest pair
+    if (mPending == static_cast<int>(mStarts.size())) {
+        resolveOldest(true);
+    }
+
+    int slot = (mHead + mPending) % static_cast<int>(mStarts.size());
+    CUDA(cudaEventRecord(mStarts[slot], mStream));
+    mStarted = true;
+}
+
+void DeferredGpuTimer::stop() {
+    if (!mStarted) return;
+
+    int slot = (mHead + mPending) % static_cast<int>(mStarts.size());
+    CUDA(cudaEventRecord(mStops[slot], mStream));
+    mStarted = false;
+    mPending++;
+}
+
+void DeferredGpuTimer::reset() noexcept {
+    TimerBase::reset();
+    mHistogram.reset();
+    mHead    = 0;
+    mPending = 0;
+    mStarted = false;
+}
+
+void DeferredGpuTimer::collect() {
+    while (mPending > 0 && resolveOldest(false)) {
+    }
+}
+
+void DeferredGpuTimer::flush() {
+    while (mPending > 0) {
+        resolveOldest(true);
+    }
+}
+
+LatencySummary DeferredGpuTimer::summary() {
+    collect();
+    return mHistogram.summary();
+}
+
+bool DeferredGpuTimer::resolveOldest(bool wait) {
+    if (wait) {
+        CUDA(cudaEventSynchronize(mStops[mHead]));
+    } else if (cudaEventQuery(mStops[mHead]) == cudaErrorNotReady) {
+        return false;
+    }
+
+    float milliseconds = 0.0F;
+    if (CUDA(cudaEventElapsedTime(&milliseconds, mStarts[mHead], mStops[mHead]))) {
+        setMilliseconds(getMilliseconds() + milliseconds);
+        mHistogram.record(milliseconds);
+    }
+
+    mHead = (mHead + 1) % static_cast<int>(mStarts.size());
+    mPending--;
+    return true;
+}
+
 }  // namespace deploy
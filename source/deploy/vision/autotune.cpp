@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+#include "deploy/vision/autotune.hpp"
+
+namespace deploy {
+
+namespace {
+
+// Sets the fixed notation of the JSON documents on a stream, restoring the formatting of the caller when done
+class JsonFormat {
+public:
+    explicit JsonFormat(std::ostream& os) : os(os), flags(os.flags()), precision(os.precision()) {
+        os << std::fixed << std::setprecision(4);
+    }
+
+    ~JsonFormat() {
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    JsonFormat(const JsonFormat&)            = delete;
+    JsonFormat& operator=(const JsonFormat&) = delete;
+
+private:
+    std::ostream&           os;
+    std::ios_base::fmtflags flags;
+    std::streamsize         precision;
+};
+
+// Writes the model as a JSON object
+void writeJsonModel(std::ostream& os, const LatencyModel& model) {
+    os << "{\"fixed_ms\":" << model.fixedMs << ",\"per_image_ms\":" << model.perImageMs << "}";
+}
+
+// Writes a JSON document to a file through the given writer
+template <typename Writer>
+void exportJsonFile(const std::string& filePath, Writer write) {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + filePath);
+    }
+    write(file);
+    if (!file) {
+        throw std::runtime_error("Error writing file: " + filePath);
+    }
+}
+
+}  // namespace
+
+// Gets the largest batch predicted to complete within a time.
+int LatencyModel::largestBatch(double budgetMs, int maxBatch) const {
+    if (predict(1) > budgetMs) return 0;
+    if (perImageMs <= 0.0) return maxBatch;
+    double batch = std::floor((budgetMs - fixedMs) / perImageMs);
+    return static_cast<int>(std::min(batch, static_cast<double>(maxBatch)));
+}
+
+// Fits the model to measured points by least squares.
+LatencyModel LatencyModel::fit(const std::vector<LatencyPoint>& points) {
+    LatencyModel model;
+    if (points.empty()) return model;
+
+    double n = static_cast<double>(points.size());
+    double sumBatch = 0.0, sumLatency = 0.0, sumBatch2 = 0.0, sumProduct = 0.0;
+    for (const auto& point : points) {
+        sumBatch   += point.batch;
+        sumLatency += point.latency;
+        sumBatch2  += static_cast<double>(point.batch) * point.batch;
+        sumProduct += static_cast<double>(point.batch) * point.latency;
+    }
+
+    double denominator = n * sumBatch2 - sumBatch * sumBatch;
+    if (denominator > 0.0) {
+        model.perImageMs = (n * sumProduct - sumBatch * sumLatency) / denominator;
+        model.fixedMs    = (sumLatency - model.perImageMs * sumBatch) / n;
+    }
+
+    // Noise can tilt the line below zero at one end, keep the closest model with non-negative costs
+    if (denominator <= 0.0 || model.fixedMs < 0.0) {
+        model.fixedMs    = 0.0;
+        model.perImageMs = sumProduct / sumBatch2;
+    }
+    if (model.perImageMs < 0.0) {
+        model.fixedMs    = sumLatency / n;
+        model.perImageMs = 0.0;
+    }
+    return model;
+}
+
+// Writes the curve and its model as a JSON document.
+void LatencyCurve::writeJson(std::ostream& os) const {
+    JsonFormat format(os);
+    os << "{\"points\":[";
+    for (size_t i = 0; i < points.size(); ++i) {
+        const auto& point = points[i];
+        os << (i > 0 ? "," : "") << "\n{\"batch\":" << point.batch << ",\"latency_ms\":" << point.latency
+           << ",\"count\":" << point.summary.count << ",\"min_ms\":" << point.summary.min << ",\"mean_ms\":" << point.summary.mean
+           << ",\"p50_ms\":" << point.summary.p50 << ",\"p90_ms\":" << point.summary.p90 << ",\"p99_ms\":" << point.summary.p99
+           << ",\"max_ms\":" << point.summary.max << "}";
+    }
+    os << "\n],\"model\":";
+    writeJsonModel(os, model);
+    os << "}\n";
+}
+
+// Writes the JSON document of the curve to a file.
+void LatencyCurve::exportJson(const std::string& filePath) const {
+    exportJsonFile(filePath, [this](std::ostream& os) { writeJson(os); });
+}
+
+// Measures the latency of each batch size and fits a latency model to the measurements.
+LatencyCurve sweepBatches(int maxBatch, const std::function<float(int batch)>& run, const AutotuneOptions& options) {
+    if (maxBatch < 1 || options.warmup < 0 || options.iterations < 1 || options.percentile < 0.0f || options.percentile > 100.0f) {
+        throw std::invalid_argument("Invalid autotuning settings: the batch and iterations must be positive and the percentile in [0, 100].");
+    }
+
+    std::vector<int> batches = options.batches;
+    if (batches.empty()) {
+        for (int batch = 1; batch <= maxBatch; ++batch) batches.push_back(batch);
+    }
+    std::sort(batches.begin(), batches.end());
+    batches.erase(std::unique(batches.begin(), batches.end()), batches.end());
+    if (batches.front() < 1 || batches.back() > maxBatch) {
+        throw std::invalid_argument("Autotuned batch sizes must be between 1 and " + std::to_string(maxBatch) + " inclusive.");
+    }
+
+    LatencyCurve     curve;
+    LatencyHistogram histogram;
+    for (int batch : batches) {
+        histogram.reset();
+        for (int i = 0; i < options.warmup + options.iterations; ++i) {
+            float latency = run(batch);
+            if (latency < 0.0f) {
+                throw std::runtime_error("Inference failed while autotuning batch size " + std::to_string(batch) + ".");
+            }
+            if (i >= options.warmup) histogram.record(latency);
+        }
+        curve.points.push_back({batch, histogram.percentile(options.percentile), histogram.summary()});
+    }
+    curve.model = LatencyModel::fit(curve.points);
+    return curve;
+}
+
+// Constructor to initialize BatchPolicy with a latency curve and a budget.
+BatchPolicy::BatchPolicy(const LatencyCurve& curve, double budgetMs, int maxBatch, double smoothing, size_t historySize)
+    : budgetMs(budgetMs), maxBatch(maxBatch), smoothing(smoothing), historySize(historySize), estimates(curve.points) {
+    if (estimates.empty()) {
+        throw std::invalid_argument("A batch policy needs a latency curve with at least one point.");
+    }
+    if (budgetMs <= 0.0 || maxBatch < 0 || smoothing <= 0.0 || smoothing > 1.0) {
+        throw std::invalid_argument("Invalid batch policy settings: the budget must be positive and the smoothing in (0, 1].");
+    }
+
+    std::sort(estimates.begin(), estimates.end(), [](const LatencyPoint& a, const LatencyPoint& b) { return a.batch < b.batch; });
+    if (this->maxBatch == 0) this->maxBatch = estimates.back().batch;
+    fitted = LatencyModel::fit(estimates);
+}
+
+// Chooses the size of the next batch.
+int BatchPolicy::decide(int queued, double waitMs) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    BatchDecision decision;
+    decision.queued = std::max(queued, 0);
+    decision.waitMs = std::max(waitMs, 0.0);
+    if (decision.queued > 0) {
+        // The batch must complete within what is left of the budget of the oldest image, when that is still possible
+        int limit = fitted.largestBatch(budgetMs - decision.waitMs, maxBatch);
+        decision.batch        = std::min(decision.queued, limit > 0 ? limit : maxBatch);
+        decision.predictedMs  = fitted.predict(decision.batch);
+        decision.withinBudget = limit > 0;
+    }
+
+    if (historySize > 0) {
+        if (history.size() == historySize) history.pop_front();
+        history.push_back(decision);
+    }
+    return decision.batch;
+}
+
+// Reports the measured latency of a batch, updating the model.
+void BatchPolicy::observe(int batch, double latencyMs) {
+    if (batch < 1 || latencyMs < 0.0) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::lower_bound(estimates.begin(), estimates.end(), batch, [](const LatencyPoint& point, int value) { return point.batch < value; });
+    if (it == estimates.end() || it->batch != batch) {
+        LatencyPoint point;
+        point.batch   = batch;
+        point.latency = static_cast<float>(fitted.predict(batch));
+        it            = estimates.insert(it, point);
+    }
+
+    // A slowdown seen on one batch size usually affects all of them, such as a clock drop or another process on
+    // the device, so the whole curve moves by the smoothed ratio and keeps its shape
+    if (it->latency <= 0.0f) {
+        it->latency = static_cast<float>(latencyMs);
+    } else {
+        double factor = 1.0 + smoothing * (latencyMs / it->latency - 1.0);
+        for (auto& estimate : estimates) estimate.latency = static_cast<float>(estimate.latency * factor);
+    }
+    fitted = LatencyModel::fit(estimates);
+}
+
+// Gets the latency model used by the decisions.
+LatencyModel BatchPolicy::model() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return fitted;
+}
+
+// Gets the recent decisions, oldest first.
+std::vector<BatchDecision> BatchPolicy::decisions() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::vector<BatchDecision>(history.begin(), history.end());
+}
+
+// Writes the budget, the current estimates, the model and the recent decisions as a JSON document.
+void BatchPolicy::writeJson(std::ostream& os) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    JsonFormat format(os);
+    os << "{\"budget_ms\":" << budgetMs << ",\"max_batch\":" << maxBatch << ",\"smoothing\":" << smoothing << ",\"model\":";
+    writeJsonModel(os, fitted);
+    os << ",\"estimates\":[";
+    for (size_t i = 0; i < estimates.size(); ++i) {
+        os << (i > 0 ? "," : "") << "\n{\"batch\":" << estimates[i].batch << ",\"latency_ms\":" << estimates[i].latency << "}";
+    }
+    os << "\n],\"decisions\":[";
+    for (size_t i = 0; i < history.size(); ++i) {
+        const auto& decision = history[i];
+        os << (i > 0 ? "," : "") << "\n{\"queued\":" << decision.queued << ",\"wait_ms\":" << decision.waitMs
+           << ",\"batch\":" << decision.batch << ",\"predicted_ms\":" << decision.predictedMs
+           << ",\"within_budget\":" << (decision.withinBudget ? "true" : "false") << "}";
+    }
+    os << "\n]}\n";
+}
+
+// Writes the JSON document of the policy to a file.
+void BatchPolicy::exportJson(const std::string& filePath) const {
+    exportJsonFile(filePath, [this](std::ostream& os) { writeJson(os); });
+}
+
+}  // namespace deploy
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cmath>
 
 #include "deploy/vision/cudaWarp.hpp"
 
@@ -72,10 +73,32 @@ __global__ void gpuBilinearWarpAffine(uint8_t* input, int inputWidth, int inputH
     output[index + 2 * outputArea] = c2;
 }
 
+// One grid row per image, threads stride over the valid items of the image
+__global__ void gpuTransformDetections(float* data, const int* numDets, int maxDets, int itemsPerDet, int stride,
+                                       int coords, bool clip, const TransformMatrix* transforms) {
+    const int             image = blockIdx.y;
+    const int             count = min(numDets[image], maxDets) * itemsPerDet;
+    const TransformMatrix m     = transforms[image];
+    float*                base  = data + static_cast<int64_t>(image) * maxDets * itemsPerDet * stride;
+
+    for (int item = blockDim.x * blockIdx.x + threadIdx.x; item < count; item += blockDim.x * gridDim.x) {
+        float* values = base + static_cast<int64_t>(item) * stride;
+        for (int j = 0; j < coords; ++j) {
+            // Same arithmetic as TransformMatrix::transformBoxes: the letterbox matrix only scales and translates
+            bool  x = j % 2 == 0;
+            float v = values[j] * (x ? m.matrix[0].x : m.matrix[1].y) + (x ? m.matrix[0].z : m.matrix[1].z);
+            if (clip) v = fminf(fmaxf(v, 0.0f), static_cast<float>(x ? m.lastWidth : m.lastHeight));
+            values[j] = v;
+        }
+    }
+}
+
 void TransformMatrix::update(int fromWidth, int fromHeight, int toWidth, int toHeight) {
-    if (fromWidth == lastWidth && fromHeight == lastHeight) return;
-    lastWidth  = fromWidth;
-    lastHeight = fromHeight;
+    if (fromWidth == lastWidth && fromHeight == lastHeight && toWidth == lastToWidth && toHeight == lastToHeight) return;
+    lastWidth    = fromWidth;
+    lastHeight   = fromHeight;
+    lastToWidth  = toWidth;
+    lastToHeight = toHeight;
 
     double scale  = std::min(static_cast<double>(toWidth) / fromWidth, static_cast<double>(toHeight) / fromHeight);
     double offset = 0.5 * scale - 0.5;
@@ -111,4 +134,66 @@ void cudaWarpAffine(uint8_t* input, uint32_t inputWidth, uint32_t inputHeight,
     );
 }
 
+void cudaTransformDetections(float* data, const int* numDets, int batch, int maxDets, int itemsPerDet, int stride,
+                             int coords, bool clip, const TransformMatrix* transforms, cudaStream_t stream) {
+    if (batch <= 0 || maxDets <= 0) return;
+
+    // Enough blocks for every slot, the valid count is only known on the device
+    const dim3 blockDim(256);
+    const dim3 gridDim(std::min(iDivUp(maxDets * itemsPerDet, blockDim.x), 64), batch);
+    gpuTransformDetections<<<gridDim, blockDim, 0, stream>>>(data, numDets, maxDets, itemsPerDet, stride, coords, clip, transforms);
+}
+
+void cpuWarpAffine(const uint8_t* input, uint32_t inputWidth, uint32_t inputHeight,
+                   float* output, uint32_t outputWidth, uint32_t outputHeight,
+                   const float3 matrix[2]) {
+    const int    width         = static_cast<int>(inputWidth);
+    const int    height        = static_cast<int>(inputHeight);
+    const int    inputLineSize = width * 3;
+    const int    outputArea    = outputWidth * outputHeight;
+    const float3 m0            = matrix[0];
+    const float3 m1            = matrix[1];
+
+    for (int y = 0; y < static_cast<int>(outputHeight); ++y) {
+        for (int x = 0; x < static_cast<int>(outputWidth); ++x) {
+            // Same arithmetic as gpuBilinearWarpAffine
+            float inputX = m0.x * x + m0.y * y + m0.z;
+            float inputY = m1.x * x + m1.y * y + m1.z;
+
+            float c0 = 0.0f, c1 = 0.0f, c2 = 0.0f;
+
+            if (inputX > -1 && inputX < width && inputY > -1 && inputY < height) {
+                int lowX  = static_cast<int>(std::floor(inputX));
+                int lowY  = static_cast<int>(std::floor(inputY));
+                int highX = lowX + 1;
+                int highY = lowY + 1;
+
+                lowX  = std::max(0, std::min(lowX, width - 1));
+                highX = std::max(0, std::min(highX, width - 1));
+                lowY  = std::max(0, std::min(lowY, height - 1));
+                highY = std::max(0, std::min(highY, height - 1));
+
+                float lx = inputX - lowX;
+                float ly = inputY - lowY;
+                float hx = 1.0f - lx;
+                float hy = 1.0f - ly;
+
+                const uint8_t* v1 = input + lowY * inputLineSize + lowX * 3;
+                const uint8_t* v2 = input + lowY * inputLineSize + highX * 3;
+                const uint8_t* v3 = input + highY * inputLineSize + lowX * 3;
+                const uint8_t* v4 = input + highY * inputLineSize + highX * 3;
+
+                c0 = hy * (hx * v1[0] + lx * v2[0]) + ly * (hx * v3[0] + lx * v4[0]);
+                c1 = hy * (hx * v1[1] + lx * v2[1]) + ly * (hx * v3[1] + lx * v4[1]);
+                c2 = hy * (hx * v1[2] + lx * v2[2]) + ly * (hx * v3[2] + lx * v4[2]);
+            }
+
+            int index                      = y * outputWidth + x;
+            output[index                 ] = c0 * 0.00392156862f;
+            output[index + outputArea    ] = c1 * 0.00392156862f;
+            output[index + 2 * outputArea] = c2 * 0.00392156862f;
+        }
+    }
+}
+
 }  // namespace deploy
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cmath>
+
+#include "deploy/utils/simd.hpp"
+#include "deploy/vision/decode.hpp"
+
+namespace deploy {
+
+namespace {
+
+using simd::kLanes;
+
+// Keeps the highest class score of each anchor (the first class on ties, like argmax). Class rows are contiguous,
+// so each pass over a row compares kLanes anchors per instruction.
+void reduceClasses(const float* scores, int numClasses, int numAnchors, float* best, float* bestClass) {
+    std::copy(scores, scores + numAnchors, best);
+    std::fill(bestClass, bestClass + numAnchors, 0.0f);
+
+    for (int c = 1; c < numClasses; ++c) {
+        const float*      row   = scores + static_cast<size_t>(c) * numAnchors;
+        const simd::Float label = simd::set1(static_cast<float>(c));
+        int               a     = 0;
+        for (; a + kLanes <= numAnchors; a += kLanes) {
+            simd::Float score   = simd::load(row + a);
+            simd::Float current = simd::load(best + a);
+            simd::Float higher  = simd::greater(score, current);
+            simd::store(best + a, simd::select(higher, score, current));
+            simd::store(bestClass + a, simd::select(higher, label, simd::load(bestClass + a)));
+        }
+        for (; a < numAnchors; ++a) {
+            if (row[a] > best[a]) {
+                best[a]      = row[a];
+                bestClass[a] = static_cast<float>(c);
+            }
+        }
+    }
+}
+
+// Collects the anchors whose best score reaches the threshold, most vectors have no candidate at all
+void selectCandidates(const float* best, int numAnchors, float threshold, std::vector<int>& candidates) {
+    candidates.clear();
+    const simd::Float limit = simd::set1(threshold);
+    int               a     = 0;
+    for (; a + kLanes <= numAnchors; a += kLanes) {
+        int mask = simd::moveMask(simd::greaterEqual(simd::load(best + a), limit));
+        for (int lane = 0; mask != 0; ++lane, mask >>= 1) {
+            if (mask & 1) candidates.push_back(a + lane);
+        }
+    }
+    for (; a < numAnchors; ++a) {
+        if (best[a] >= threshold) candidates.push_back(a);
+    }
+}
+
+float boxIoU(const float* a, const float* b) {
+    float width  = std::min(a[2], b[2]) - std::max(a[0], b[0]);
+    float height = std::min(a[3], b[3]) - std::max(a[1], b[1]);
+    if (width <= 0.0f || height <= 0.0f) return 0.0f;
+    float inter = width * height;
+    float areaA = (a[2] - a[0]) * (a[3] - a[1]);
+    float areaB = (b[2] - b[0]) * (b[3] - b[1]);
+    return inter / (areaA + areaB - inter);
+}
+
+// Covariance of the Gaussian fitted to a rotated box: a and b on the diagonal, c off the diagonal
+void boxCovariance(float width, float height, float theta, float* covariance) {
+    float a = width * width / 12.0f, b = height * height / 12.0f;
+    float cos = std::cos(theta), sin = std::sin(theta);
+    covariance[0] = a * cos * cos + b * sin * sin;
+    covariance[1] = a * sin * sin + b * cos * cos;
+    covariance[2] = (a - b) * cos * sin;
+}
+
+// ProbIoU between two rotated boxes given by their centers and covariances, as used by YOLO OBB for NMS
+float probIoU(float x1, float y1, const float* c1, float x2, float y2, const float* c2) {
+    constexpr float eps = 1e-7f;
+    float a = c1[0] + c2[0], b = c1[1] + c2[1], c = c1[2] + c2[2];
+    float det = a * b - c * c;
+    float t1  = (a * (y1 - y2) * (y1 - y2) + b * (x1 - x2) * (x1 - x2)) / (det + eps) * 0.25f;
+    float t2  = (c * (x2 - x1) * (y1 - y2)) / (det + eps) * 0.5f;
+    float d1  = std::max(c1[0] * c1[1] - c1[2] * c1[2], 0.0f);
+    float d2  = std::max(c2[0] * c2[1] - c2[2] * c2[2], 0.0f);
+    float t3  = 0.5f * std::log(det / (4.0f * std::sqrt(d1 * d2) + eps) + eps);
+    float bd  = std::min(std::max(t1 + t2 + t3, eps), 100.0f);
+    return 1.0f - std::sqrt(1.0f - std::exp(-bd) + eps);
+}
+
+}  // namespace
+
+int decodeRawHead(const float* output, const RawHead& head, RawDecodeWorkspace& workspace) {
+    const int    numAnchors = head.numAnchors;
+    const float* scores     = output + 4 * static_cast<size_t>(numAnchors);
+    const float* angles     = scores + static_cast<size_t>(head.numClasses) * numAnchors;
+
+    workspace.boxes.clear();
+    workspace.scores.clear();
+    workspace.classes.clear();
+    workspace.covariances.clear();
+    if (head.numClasses <= 0 || numAnchors <= 0 || head.maxDets <= 0) return 0;
+
+    workspace.bestScores.resize(numAnchors);
+    workspace.bestClasses.resize(numAnchors);
+    float* best      = workspace.bestScores.data();
+    float* bestClass = workspace.bestClasses.data();
+    reduceClasses(scores, head.numClasses, numAnchors, best, bestClass);
+
+    auto& candidates = workspace.candidates;
+    selectCandidates(best, numAnchors, head.scoreThreshold, candidates);
+    if (!head.classScoreThresholds.empty()) {
+        const auto& thresholds = head.classScoreThresholds;
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                        [&](int a) { return best[a] < thresholds[static_cast<int>(bestClass[a])]; }),
+                         candidates.end());
+    }
+
+    // Highest scores first, ties in anchor order so that the result does not depend on the sort
+    auto higher = [best](int a, int b) { return best[a] > best[b] || (best[a] == best[b] && a < b); };
+    if (head.maxCandidates > 0 && static_cast<int>(candidates.size()) > head.maxCandidates) {
+        std::nth_element(candidates.begin(), candidates.begin() + head.maxCandidates, candidates.end(), higher);
+        candidates.resize(head.maxCandidates);
+    }
+
+    // Greedy NMS per class: a candidate is kept unless it overlaps a kept box of its class too much. Candidates
+    // are popped from a heap, since NMS usually stops at maxDets long before all of them are ordered.
+    auto lower = [&higher](int a, int b) { return higher(b, a); };
+    std::make_heap(candidates.begin(), candidates.end(), lower);
+
+    const int stride = head.rotated ? 5 : 4;
+    while (!candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), lower);
+        int anchor = candidates.back();
+        candidates.pop_back();
+
+        float cx = output[anchor], cy = output[numAnchors + anchor];
+        float w = output[2 * numAnchors + anchor], h = output[3 * numAnchors + anchor];
+        float box[5] = {cx - w * 0.5f, cy - h * 0.5f, cx + w * 0.5f, cy + h * 0.5f, head.rotated ? angles[anchor] : 0.0f};
+        int   label  = static_cast<int>(bestClass[anchor]);
+
+        float covariance[3];
+        if (head.rotated) boxCovariance(w, h, box[4], covariance);
+
+        bool suppressed = false;
+        for (size_t k = 0; k < workspace.classes.size() && !suppressed; ++k) {
+            if (workspace.classes[k] != label) continue;
+            const float* other = workspace.boxes.data() + k * stride;
+            float        iou;
+            if (head.rotated) {
+                iou = probIoU(cx, cy, covariance, (other[0] + other[2]) * 0.5f, (other[1] + other[3]) * 0.5f,
+                              workspace.covariances.data() + k * 3);
+            } else {
+                iou = boxIoU(box, other);
+            }
+            suppressed = iou >= head.iouThreshold;
+        }
+        if (suppressed) continue;
+
+        workspace.boxes.insert(workspace.boxes.end(), box, box + stride);
+        workspace.scores.push_back(best[anchor]);
+        workspace.classes.push_back(label);
+        if (head.rotated) workspace.covariances.insert(workspace.covariances.end(), covariance, covariance + 3);
+        if (static_cast<int>(workspace.classes.size()) == head.maxDets) break;
+    }
+    return static_cast<int>(workspace.classes.size());
+}
+
+}  // namespace deploy
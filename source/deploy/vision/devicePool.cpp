@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include "deploy/vision/devicePool.hpp"
+
+namespace deploy {
+
+// Constructor to initialize DevicePool with a model file loaded on each listed device.
+template <typename T>
+DevicePool<T>::DevicePool(const std::string& file, const std::vector<int>& devices, int instances, bool cudaGraph, bool cudaMem) : setDevice(true) {
+    auto factory = [&](int device) -> std::unique_ptr<BaseTemplate<T>> {
+        if (cudaGraph) return std::make_unique<DeployCGTemplate<T>>(file, cudaMem, device);
+        return std::make_unique<DeployTemplate<T>>(file, cudaMem, device);
+    };
+    start(factory, devices, instances);
+}
+
+// Constructor to initialize DevicePool with models created by a factory.
+template <typename T>
+DevicePool<T>::DevicePool(Factory factory, const std::vector<int>& devices, int instances, bool setDevice) : setDevice(setDevice) {
+    start(factory, devices, instances);
+}
+
+// Completes the batches already submitted, then stops the serving threads and releases the models.
+template <typename T>
+DevicePool<T>::~DevicePool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Creates the models and starts the serving threads.
+template <typename T>
+void DevicePool<T>::start(const Factory& factory, const std::vector<int>& deviceIds, int count) {
+    if (deviceIds.empty() || count < 1) {
+        throw std::runtime_error("A device pool needs at least one device and one instance per device.");
+    }
+    for (size_t i = 0; i < deviceIds.size(); ++i) {
+        if (std::find(deviceIds.begin(), deviceIds.begin() + i, deviceIds[i]) != deviceIds.begin() + i) {
+            throw std::runtime_error("Device " + std::to_string(deviceIds[i]) + " is listed more than once.");
+        }
+    }
+
+    devices = std::vector<Device>(deviceIds.size());
+    for (size_t d = 0; d < deviceIds.size(); ++d) {
+        devices[d].load.device    = deviceIds[d];
+        devices[d].load.instances = count;
+        for (int i = 0; i < count; ++i) {
+            Instance instance;
+            instance.model  = factory(deviceIds[d]);
+            instance.device = static_cast<int>(d);
+            if (!instance.model) {
+                throw std::runtime_error("The model factory returned no model for device " + std::to_string(deviceIds[d]) + ".");
+            }
+            instances.push_back(std::move(instance));
+        }
+    }
+
+    maxBatch = std::min_element(instances.begin(), instances.end(), [](const Instance& a, const Instance& b) { return a.model->batch < b.model->batch; })->model->batch;
+
+    // The threads start once every model exists, so that a failing factory leaves nothing running
+    for (size_t i = 0; i < instances.size(); ++i) {
+        workers.emplace_back(&DevicePool::serve, this, static_cast<int>(i));
+    }
+}
+
+// Submits a batch and returns without waiting for it.
+template <typename T>
+std::future<std::vector<T>> DevicePool<T>::submit(const std::vector<Image>& images) {
+    int numImages = images.size();
+    if (numImages < 1 || numImages > maxBatch) {
+        throw std::runtime_error("Number of images (" + std::to_string(numImages) + ") must be between 1 and " + std::to_string(maxBatch) + " inclusive.");
+    }
+
+    auto job    = std::make_unique<Job>();
+    job->images = images;
+    auto future = job->promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Queue on the device expected to complete the batch first
+        int    target = 0;
+        double best   = expectedTime(0, numImages);
+        for (int d = 1; d < static_cast<int>(devices.size()); ++d) {
+            double time = expectedTime(d, numImages);
+            if (time < best) {
+                target = d;
+                best   = time;
+            }
+        }
+        devices[target].queue.push_back(std::move(job));
+        devices[target].load.queued += numImages;
+    }
+
+    // Idle threads of the other devices may steal the batch
+    available.notify_all();
+    return future;
+}
+
+// Performs inference on a batch on the device expected to complete it first, and waits for it.
+template <typename T>
+std::vector<T> DevicePool<T>::predict(const std::vector<Image>& images) {
+    return submit(images).get();
+}
+
+// Gets the current load of each device, in the order they were listed.
+template <typename T>
+std::vector<DeviceLoad> DevicePool<T>::loads() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<DeviceLoad>     result;
+    result.reserve(devices.size());
+    for (const auto& device : devices) {
+        result.push_back(device.load);
+    }
+    return result;
+}
+
+// Main loop of the thread serving an instance.
+template <typename T>
+void DevicePool<T>::serve(int index) {
+    auto& instance = instances[index];
+    auto& load     = devices[instance.device].load;
+    if (setDevice) {
+        CUDA(cudaSetDevice(load.device));
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        auto job = take(instance.device);
+        if (!job) {
+            bool empty = std::all_of(devices.begin(), devices.end(), [](const Device& device) { return device.queue.empty(); });
+            if (stopping && empty) return;
+            available.wait(lock);
+            continue;
+        }
+
+        int numImages = job->images.size();
+        load.running += numImages;
+        lock.unlock();
+
+        auto               start = std::chrono::steady_clock::now();
+        std::vector<T>     results;
+        std::exception_ptr error;
+        try {
+            instance.model->predictInto(job->images, results);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        lock.lock();
+        load.running -= numImages;
+        load.completed++;
+        double perImage = ms / numImages;
+        load.msPerImage = load.msPerImage > 0.0 ? (1.0 - kLatencyWeight) * load.msPerImage + kLatencyWeight * perImage : perImage;
+
+        // The estimates changed, batches may now be worth stealing, and a stopping pool may be drained
+        available.notify_all();
+
+        // Completed once the loads count the batch, so that a caller reading them after its future sees it
+        if (error) {
+            job->promise.set_exception(error);
+        } else {
+            job->promise.set_value(std::move(results));
+        }
+    }
+}
+
+// Takes the next batch for a device: the head of its queue, or a batch stolen from another device.
+template <typename T>
+std::unique_ptr<typename DevicePool<T>::Job> DevicePool<T>::take(int device) {
+    auto& own = devices[device];
+    if (!own.queue.empty()) {
+        auto job = std::move(own.queue.front());
+        own.queue.pop_front();
+        own.load.queued -= static_cast<int>(job->images.size());
+        return job;
+    }
+
+    // The last batch of the busiest device completes once everything before it has
+    int    victim     = -1;
+    double victimTime = 0.0;
+    for (int d = 0; d < static_cast<int>(devices.size()); ++d) {
+        if (d == device || devices[d].queue.empty()) continue;
+        double time = expectedTime(d, 0);
+        if (time > victimTime) {
+            victim     = d;
+            victimTime = time;
+        }
+    }
+    if (victim < 0) return nullptr;
+
+    // This thread is idle, so it completes the batch after its own latency only
+    auto& queue     = devices[victim].queue;
+    int   numImages = static_cast<int>(queue.back()->images.size());
+    if (latency(device) * numImages >= victimTime) return nullptr;
+
+    auto job = std::move(queue.back());
+    queue.pop_back();
+    devices[victim].load.queued -= numImages;
+    own.load.stolen++;
+    return job;
+}
+
+// Gets the latency per image expected on a device, from its measurements or those of the others.
+template <typename T>
+double DevicePool<T>::latency(int device) const {
+    if (devices[device].load.msPerImage > 0.0) return devices[device].load.msPerImage;
+
+    // Devices not measured yet are assumed to be average, which sends them work to measure
+    double sum   = 0.0;
+    int    count = 0;
+    for (const auto& other : devices) {
+        if (other.load.msPerImage > 0.0) {
+            sum += other.load.msPerImage;
+            count++;
+        }
+    }
+    return count > 0 ? sum / count : 1.0;
+}
+
+// Gets the time a device is expected to need before it completes some more images.
+template <typename T>
+double DevicePool<T>::expectedTime(int device, int images) const {
+    const auto& load = devices[device].load;
+    return (load.queued + load.running + images) * latency(device) / load.instances;
+}
+
+}  // namespace deploy
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#include "deploy/utils/utils.hpp"
+#include "deploy/vision/executor.hpp"
+
+namespace deploy {
+
+// Constructor to initialize MultiModelExecutor with an optional CUDA memory flag and device index.
+MultiModelExecutor::MultiModelExecutor(bool cudaMem, int device) : cudaMem(cudaMem) {
+    CUDA(cudaSetDevice(device));
+    CUDA(cudaStreamCreate(&stream));
+}
+
+// Destructor for releasing the streams, events and buffers of the executor.
+MultiModelExecutor::~MultiModelExecutor() {
+    for (auto& model : models) {
+        CUDA(cudaStreamDestroy(model.stream));
+    }
+    for (auto& input : inputs) {
+        CUDA(cudaEventDestroy(input.ready));
+    }
+    CUDA(cudaStreamDestroy(stream));
+}
+
+// Adds a model, sharing the input of the models of the same input size.
+void MultiModelExecutor::addModel(int width, int height, int batch, Enqueue enqueue, std::function<bool()> wait) {
+    auto it = std::find_if(inputs.begin(), inputs.end(), [&](const Input& input) { return input.width == width && input.height == height; });
+    if (it == inputs.end()) {
+        inputs.emplace_back();
+        it         = inputs.end() - 1;
+        it->width  = width;
+        it->height = height;
+        CUDA(cudaEventCreateWithFlags(&it->ready, cudaEventDisableTiming));
+    }
+
+    Model model;
+    model.enqueue = std::move(enqueue);
+    model.wait    = std::move(wait);
+    model.batch   = batch;
+    model.input   = static_cast<int>(it - inputs.begin());
+    CUDA(cudaStreamCreate(&model.stream));
+    models.push_back(std::move(model));
+}
+
+// Runs every model on a batch of images and post-processes their results.
+bool MultiModelExecutor::run(const std::vector<Image>& images) {
+    int numImages = images.size();
+    int maxImages = 0;
+    if (!models.empty()) {
+        maxImages = std::min_element(models.begin(), models.end(), [](const Model& a, const Model& b) { return a.batch < b.batch; })->batch;
+    }
+    if (numImages < 1 || numImages > maxImages) {
+        std::cerr << "Error: Number of images (" << numImages << ") must be between 1 and " << maxImages << " inclusive." << std::endl;
+        return false;
+    }
+
+    // Upload each image once. The staging buffers are refilled from the host, the previous uploads must be done
+    std::vector<uint8_t*> imageDevices(numImages);
+    if (cudaMem) {
+        for (int i = 0; i < numImages; ++i) {
+            imageDevices[i] = static_cast<uint8_t*>(images[i].rgbPtr);
+        }
+    } else {
+        CUDA(cudaStreamSynchronize(stream));
+        if (static_cast<int>(imageTensors.size()) < numImages) imageTensors.resize(numImages);
+        for (int i = 0; i < numImages; ++i) {
+            int64_t imageSize = 3 * images[i].width * images[i].height;
+            void*   imageHost = imageTensors[i].host(imageSize);
+            void*   imageDev  = imageTensors[i].device(imageSize);
+            std::memcpy(imageHost, images[i].rgbPtr, imageSize * sizeof(uint8_t));
+            CUDA(cudaMemcpyAsync(imageDev, imageHost, imageSize * sizeof(uint8_t), cudaMemcpyHostToDevice, stream));
+            imageDevices[i] = static_cast<uint8_t*>(imageDev);
+        }
+    }
+
+    // Letterbox the batch once per input size
+    for (auto& input : inputs) {
+        int64_t inputSize = 3 * input.height * input.width;
+        float*  tensor    = static_cast<float*>(input.tensor.device(numImages * inputSize * sizeof(float)));
+        input.transforms.resize(numImages);
+        for (int i = 0; i < numImages; ++i) {
+            input.transforms[i].update(images[i].width, images[i].height, input.width, input.height);
+            cudaWarpAffine(imageDevices[i], images[i].width, images[i].height, tensor + i * inputSize, input.width, input.height, input.transforms[i].matrix, stream);
+        }
+        CUDA(cudaEventRecord(input.ready, stream));
+    }
+
+    // Run the models concurrently, each one joining its input
+    std::vector<bool> enqueued(models.size(), false);
+    for (size_t m = 0; m < models.size(); ++m) {
+        auto& model = models[m];
+        auto& input = inputs[model.input];
+        CUDA(cudaStreamWaitEvent(model.stream, input.ready, 0));
+        enqueued[m] = model.enqueue(numImages, static_cast<const float*>(input.tensor.device()), input.transforms, model.stream);
+    }
+
+    // Post-process each model as it completes, in the order they were added
+    bool success = true;
+    for (size_t m = 0; m < models.size(); ++m) {
+        success = (enqueued[m] && models[m].wait()) && success;
+    }
+    return success;
+}
+
+}  // namespace deploy
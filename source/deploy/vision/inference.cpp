@@ -1,6 +1,12 @@
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <functional>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "deploy/core/types.hpp"
 #include "deploy/utils/utils.hpp"
@@ -8,84 +14,252 @@
 
 namespace deploy {
 
-// Constructor to initialize BaseTemplate with a model file, optional CUDA memory flag, and device index.
-template <typename T>
-BaseTemplate<T>::BaseTemplate(const std::string& file, bool cudaMem, int device) : cudaMem(cudaMem) {
+namespace {
+
+// Name of the NMS thresholds input of engines exported with runtime thresholds
+constexpr const char* kThresholdsTensorName = "nms_thresholds";
+
+// Host function queued after the download of a batch, runs the completion callback of the caller
+void runCompletion(void* callback) {
+    (*static_cast<std::function<void()>*>(callback))();
+}
+
+// Copies the num boxes of an image from the output tensor, boxSize floats each, and maps all of them back to the
+// source image in one pass over the packed buffer
+template <typename B>
+void transformBoxes(const float* boxes, int num, int boxSize, const TransformMatrix& transform, bool clip, std::vector<B>& out) {
+    static_assert(std::is_trivially_copyable<B>::value && sizeof(B) % sizeof(float) == 0, "boxes must be packed floats");
+    constexpr int stride = sizeof(B) / sizeof(float);
+
+    out.resize(num);
+    float* data = reinterpret_cast<float*>(out.data());
+    if (boxSize == stride) {
+        std::memcpy(data, boxes, static_cast<size_t>(num) * stride * sizeof(float));
+    } else {
+        for (int i = 0; i < num; ++i) {
+            std::memcpy(data + i * stride, boxes + i * boxSize, std::min(stride, boxSize) * sizeof(float));
+        }
+    }
+    transform.transformBoxes(data, num, stride, clip);
+}
+
+}  // namespace
+
+// Loads a serialized engine and creates its execution context on a device.
+std::shared_ptr<EngineContext> loadEngine(const std::string& file, int device) {
     // Set the CUDA device
     CUDA(cudaSetDevice(device));
 
     // Load the engine data from file
     auto data = loadFile(file);
 
-    // Reset engine context
-    engineCtx = std::make_shared<EngineContext>();
-    if (!engineCtx->construct(data.data(), data.size())) {
+    // Construct the engine context
+    auto engine = std::make_shared<EngineContext>();
+    if (!engine->construct(data.data(), data.size())) {
         throw std::runtime_error("Failed to construct engine context.");
     }
+    return engine;
 }
 
-// Processes the inference results for a specific index.
-template <>
-DetResult BaseTemplate<DetResult>::postProcess(const int idx) {
-    int    num     = static_cast<int*>(this->tensorInfos[1].tensor.host())[idx];
-    float* boxes   = static_cast<float*>(this->tensorInfos[2].tensor.host()) + idx * this->tensorInfos[2].dims.d[1] * this->tensorInfos[2].dims.d[2];
-    float* scores  = static_cast<float*>(this->tensorInfos[3].tensor.host()) + idx * this->tensorInfos[3].dims.d[1];
-    int*   classes = static_cast<int*>(this->tensorInfos[4].tensor.host()) + idx * this->tensorInfos[4].dims.d[1];
+// Constructor to initialize BaseTemplate with a model file, optional CUDA memory flag, and device index.
+template <typename T>
+BaseTemplate<T>::BaseTemplate(const std::string& file, bool cudaMem, int device) : BaseTemplate(loadEngine(file, device), cudaMem, device) {
+}
 
-    DetResult result;
-    result.num = num;
+// Constructor to initialize BaseTemplate with an engine loaded beforehand.
+template <typename T>
+BaseTemplate<T>::BaseTemplate(std::shared_ptr<EngineContext> engine, bool cudaMem, int device) : cudaMem(cudaMem), engineCtx(std::move(engine)) {
+    if (!engineCtx || !engineCtx->mEngine || !engineCtx->mContext) {
+        throw std::runtime_error("The engine context is not constructed.");
+    }
 
-    int boxSize = this->tensorInfos[2].dims.d[2];
-    for (int i = 0; i < num; ++i) {
-        float left   = boxes[i * boxSize];
-        float top    = boxes[i * boxSize + 1];
-        float right  = boxes[i * boxSize + 2];
-        float bottom = boxes[i * boxSize + 3];
+    // Set the CUDA device, the model runs on the device the engine was loaded on
+    CUDA(cudaSetDevice(device));
+}
+
+// Gets the latency distribution of each pipeline stage recorded so far.
+template <typename T>
+std::vector<StageStats> BaseTemplate<T>::stats() {
+    return inferStats.summary();
+}
 
-        // Apply affine transformation
-        transforms[idx].transform(left, top, &left, &top);
-        transforms[idx].transform(right, bottom, &right, &bottom);
+// Discards all recorded stage latencies.
+template <typename T>
+void BaseTemplate<T>::resetStats() {
+    inferStats.reset();
+}
+
+// Enables or disables the collection of stage latencies.
+template <typename T>
+void BaseTemplate<T>::setStatsEnabled(bool enabled) {
+    inferStats.setEnabled(enabled);
+}
+
+// Enables or disables the emission of NVTX ranges for each pipeline stage.
+template <typename T>
+void BaseTemplate<T>::setNvtxEnabled(bool enabled) {
+    inferStats.setNvtxEnabled(enabled);
+}
+
+// Post-processes the images of a batch on an internal thread pool instead of the calling thread.
+template <typename T>
+void BaseTemplate<T>::setPostProcessThreads(int threads) {
+    if (threads <= 1) {
+        postProcessExecutor = nullptr;
+        return;
+    }
+    auto pool           = std::make_shared<ThreadPool>(threads - 1);
+    postProcessExecutor = [pool](int count, const std::function<void(int)>& task) { pool->parallelFor(count, task); };
+}
+
+// Post-processes the images of a batch with an executor supplied by the caller.
+template <typename T>
+void BaseTemplate<T>::setPostProcessExecutor(ParallelFor executor) {
+    postProcessExecutor = std::move(executor);
+}
+
+// Attaches a layer profiler to the execution context, or detaches it when null.
+template <typename T>
+void BaseTemplate<T>::setProfiler(std::shared_ptr<LayerProfiler> profiler) {
+    engineCtx->mContext->setProfiler(profiler.get());
+    layerProfiler = std::move(profiler);
+}
+
+// Updates the NMS thresholds of an engine exported with runtime thresholds.
+template <typename T>
+void BaseTemplate<T>::setThresholds(float scoreThreshold, float iouThreshold, int maxBoxes, const std::vector<float>& classScoreThresholds) {
+    // A queued batch still reads the thresholds, on the device with the plugin or in wait with a raw head
+    if (pendingImages > 0) {
+        throw std::runtime_error("The thresholds cannot change while a batch is in flight, call wait first.");
+    }
+
+    // Raw heads are decoded on the host, the thresholds only need to be kept for the next post-processing
+    if (rawHead) {
+        if (!classScoreThresholds.empty() && static_cast<int>(classScoreThresholds.size()) != rawHead->numClasses) {
+            throw std::runtime_error("Expected " + std::to_string(rawHead->numClasses) + " class score thresholds, got " + std::to_string(classScoreThresholds.size()) + ".");
+        }
+        if (scoreThreshold >= 0.0f) rawHead->scoreThreshold = scoreThreshold;
+        if (iouThreshold >= 0.0f) rawHead->iouThreshold = iouThreshold;
+        if (maxBoxes >= 0) rawHead->maxDets = maxBoxes;
+        rawHead->classScoreThresholds = classScoreThresholds;
+        return;
+    }
+
+    if (!thresholdsInfo) {
+        throw std::runtime_error("The engine has no runtime thresholds input, export it with --runtime_thresholds.");
+    }
+
+    // Layout of the thresholds input: iou, score, max boxes, then one score threshold per class
+    size_t numClasses = thresholdsInfo->dims.d[0] - 3;
+    if (!classScoreThresholds.empty() && classScoreThresholds.size() != numClasses) {
+        throw std::runtime_error("Expected " + std::to_string(numClasses) + " class score thresholds, got " + std::to_string(classScoreThresholds.size()) + ".");
+    }
+
+    // The last batch may still run on the stream of a caller (predictDevice or a waited batch of another stream),
+    // the copy is ordered after it so that the batch keeps the thresholds it was launched with
+    CUDA(cudaStreamWaitEvent(inferStream, doneEvent, 0));
+
+    float* thresholds = static_cast<float*>(thresholdsInfo->tensor.host());
+    thresholds[0]     = iouThreshold;
+    thresholds[1]     = scoreThreshold;
+    thresholds[2]     = static_cast<float>(maxBoxes);
+    if (classScoreThresholds.empty()) {
+        std::fill_n(thresholds + 3, numClasses, 0.0f);
+    } else {
+        std::copy(classScoreThresholds.begin(), classScoreThresholds.end(), thresholds + 3);
+    }
+
+    // The plugin reads the thresholds from device memory, which also keeps captured CUDA graphs up to date
+    CUDA(cudaMemcpyAsync(thresholdsInfo->tensor.device(), thresholds, thresholdsInfo->bytes, cudaMemcpyHostToDevice, inferStream));
+    CUDA(cudaStreamSynchronize(inferStream));
+}
+
+// Switches to the host decode when the engine outputs the raw head instead of the NMS plugin outputs.
+template <typename T>
+void BaseTemplate<T>::setupRawHead() {
+    rawHead.reset();
+    decodeWorkspaces.clear();
+    if (tensorInfos.size() != 2 || tensorInfos[1].input || tensorInfos[1].dims.nbDims != 3) return;
+
+    const auto& dims = tensorInfos[1].dims;
+    if (!std::is_same<T, DetResult>::value && !std::is_same<T, OBBResult>::value) {
+        throw std::runtime_error("Raw head outputs are only supported for detection and OBB models, export the engine with the NMS plugin.");
+    }
+    if (tensorInfos[1].bytes != calculateVolume(dims) * static_cast<int64_t>(sizeof(float)) || dims.d[1] > dims.d[2]) {
+        throw std::runtime_error("Unsupported raw head output, expected float32 [batch, channels, anchors].");
+    }
 
-        result.boxes.emplace_back(Box{left, top, right, bottom});
-        result.scores.emplace_back(scores[i]);
-        result.classes.emplace_back(classes[i]);
+    // Channels: 4 box values, the class scores, then the angle of rotated boxes
+    auto head        = std::make_shared<RawHead>();
+    head->rotated    = std::is_same<T, OBBResult>::value;
+    head->numClasses = static_cast<int>(dims.d[1]) - 4 - (head->rotated ? 1 : 0);
+    head->numAnchors = static_cast<int>(dims.d[2]);
+    if (head->numClasses <= 0) {
+        throw std::runtime_error("Raw head output has " + std::to_string(dims.d[1]) + " channels, too few for its boxes.");
     }
 
-    return result;
+    rawHead = std::move(head);
+    decodeWorkspaces.resize(batch);
 }
 
+// Decodes the raw head output of an image and maps the kept boxes back to the source image.
+template <typename T>
+template <typename B>
+void BaseTemplate<T>::decodeRawOutput(int idx, std::vector<B>& boxes, std::vector<float>& scores, std::vector<int>& classes, bool clip) {
+    const float* output    = static_cast<const float*>(tensorInfos[1].tensor.host()) + static_cast<size_t>(idx) * tensorInfos[1].dims.d[1] * tensorInfos[1].dims.d[2];
+    auto&        workspace = decodeWorkspaces[idx];
+    int          num       = decodeRawHead(output, *rawHead, workspace);
+
+    scores.assign(workspace.scores.begin(), workspace.scores.end());
+    classes.assign(workspace.classes.begin(), workspace.classes.end());
+    transformBoxes(workspace.boxes.data(), num, rawHead->rotated ? 5 : 4, transforms[idx], clip, boxes);
+}
+
+// Processes the inference results for a specific index.
 template <>
-OBBResult BaseTemplate<OBBResult>::postProcess(const int idx) {
+void BaseTemplate<DetResult>::postProcess(const int idx, DetResult& result) {
+    if (rawHead) {
+        decodeRawOutput(idx, result.boxes, result.scores, result.classes, true);
+        result.num = static_cast<int>(result.classes.size());
+        return;
+    }
+
     int    num     = static_cast<int*>(this->tensorInfos[1].tensor.host())[idx];
     float* boxes   = static_cast<float*>(this->tensorInfos[2].tensor.host()) + idx * this->tensorInfos[2].dims.d[1] * this->tensorInfos[2].dims.d[2];
     float* scores  = static_cast<float*>(this->tensorInfos[3].tensor.host()) + idx * this->tensorInfos[3].dims.d[1];
     int*   classes = static_cast<int*>(this->tensorInfos[4].tensor.host()) + idx * this->tensorInfos[4].dims.d[1];
 
-    OBBResult result;
     result.num = num;
+    result.scores.assign(scores, scores + num);
+    result.classes.assign(classes, classes + num);
 
-    int boxSize = this->tensorInfos[2].dims.d[2];
-    for (int i = 0; i < num; ++i) {
-        float left   = boxes[i * boxSize];
-        float top    = boxes[i * boxSize + 1];
-        float right  = boxes[i * boxSize + 2];
-        float bottom = boxes[i * boxSize + 3];
-        float theta  = boxes[i * boxSize + 4];
-
-        // Apply affine transformation
-        transforms[idx].transform(left, top, &left, &top);
-        transforms[idx].transform(right, bottom, &right, &bottom);
+    // Map the boxes back to the source image, clipped to its bounds
+    transformBoxes(boxes, num, this->tensorInfos[2].dims.d[2], transforms[idx], true, result.boxes);
+}
 
-        result.boxes.emplace_back(RotatedBox{left, top, right, bottom, theta});
-        result.scores.emplace_back(scores[i]);
-        result.classes.emplace_back(classes[i]);
+template <>
+void BaseTemplate<OBBResult>::postProcess(const int idx, OBBResult& result) {
+    if (rawHead) {
+        decodeRawOutput(idx, result.boxes, result.scores, result.classes, false);
+        result.num = static_cast<int>(result.classes.size());
+        return;
     }
 
-    return result;
+    int    num     = static_cast<int*>(this->tensorInfos[1].tensor.host())[idx];
+    float* boxes   = static_cast<float*>(this->tensorInfos[2].tensor.host()) + idx * this->tensorInfos[2].dims.d[1] * this->tensorInfos[2].dims.d[2];
+    float* scores  = static_cast<float*>(this->tensorInfos[3].tensor.host()) + idx * this->tensorInfos[3].dims.d[1];
+    int*   classes = static_cast<int*>(this->tensorInfos[4].tensor.host()) + idx * this->tensorInfos[4].dims.d[1];
+
+    result.num = num;
+    result.scores.assign(scores, scores + num);
+    result.classes.assign(classes, classes + num);
+
+    // Map the boxes back to the source image
+    transformBoxes(boxes, num, this->tensorInfos[2].dims.d[2], transforms[idx], false, result.boxes);
 }
 
 template <>
-SegResult BaseTemplate<SegResult>::postProcess(const int idx) {
+void BaseTemplate<SegResult>::postProcess(const int idx, SegResult& result) {
     int maskHeight = this->tensorInfos[5].dims.d[2];
     int maskWidth  = this->tensorInfos[5].dims.d[3];
 
@@ -95,25 +269,19 @@ SegResult BaseTemplate<SegResult>::postProcess(const int idx) {
     int*     classes = static_cast<int*>(this->tensorInfos[4].tensor.host()) + idx * this->tensorInfos[4].dims.d[1];
     uint8_t* masks   = static_cast<uint8_t*>(this->tensorInfos[5].tensor.host()) + idx * this->tensorInfos[5].dims.d[1] * maskHeight * maskWidth;
 
-    SegResult result;
     result.num = num;
+    result.scores.assign(scores, scores + num);
+    result.classes.assign(classes, classes + num);
+    result.masks.resize(num);
 
-    int boxSize = this->tensorInfos[2].dims.d[2];
+    // Map the boxes back to the source image, clipped to its bounds
+    transformBoxes(boxes, num, this->tensorInfos[2].dims.d[2], transforms[idx], true, result.boxes);
     for (int i = 0; i < num; ++i) {
-        // Apply affine transformation
-        float left   = boxes[i * boxSize];
-        float top    = boxes[i * boxSize + 1];
-        float right  = boxes[i * boxSize + 2];
-        float bottom = boxes[i * boxSize + 3];
-
-        transforms[idx].transform(left, top, &left, &top);
-        transforms[idx].transform(right, bottom, &right, &bottom);
-
-        result.boxes.emplace_back(Box{left, top, right, bottom});
-        result.scores.emplace_back(scores[i]);
-        result.classes.emplace_back(classes[i]);
-
-        Mask mask(maskWidth - 2 * transforms[idx].dw, maskHeight - 2 * transforms[idx].dh);
+        // Reuse the pixel buffer of the mask left at this position by the previous result
+        Mask& mask  = result.masks[i];
+        mask.width  = maskWidth - 2 * transforms[idx].dw;
+        mask.height = maskHeight - 2 * transforms[idx].dh;
+        mask.data.resize(mask.width * mask.height);
 
         // Crop the mask's edge area, applying offset to adjust the position
         int startIdx = i * maskHeight * maskWidth;
@@ -122,15 +290,11 @@ SegResult BaseTemplate<SegResult>::postProcess(const int idx) {
             std::memcpy(&mask.data[y * mask.width], masks + srcIndex, mask.width);
             srcIndex += maskWidth;
         }
-
-        result.masks.emplace_back(std::move(mask));
     }
-
-    return result;
 }
 
 template <>
-PoseResult BaseTemplate<PoseResult>::postProcess(const int idx) {
+void BaseTemplate<PoseResult>::postProcess(const int idx, PoseResult& result) {
     int nkpt = this->tensorInfos[5].dims.d[2];
     int ndim = this->tensorInfos[5].dims.d[3];
 
@@ -140,40 +304,139 @@ PoseResult BaseTemplate<PoseResult>::postProcess(const int idx) {
     int*   classes = static_cast<int*>(this->tensorInfos[4].tensor.host()) + idx * this->tensorInfos[4].dims.d[1];
     float* kpts    = static_cast<float*>(this->tensorInfos[5].tensor.host()) + idx * this->tensorInfos[5].dims.d[1] * nkpt * ndim;
 
-    PoseResult result;
-    result.num = num;
-
-    int boxSize = this->tensorInfos[2].dims.d[2];
-    for (int i = 0; i < num; ++i) {
-        // Apply affine transformation
-        float left   = boxes[i * boxSize];
-        float top    = boxes[i * boxSize + 1];
-        float right  = boxes[i * boxSize + 2];
-        float bottom = boxes[i * boxSize + 3];
+    result.num  = num;
+    result.nkpt = nkpt;
+    result.ndim = ndim;
+    result.scores.assign(scores, scores + num);
+    result.classes.assign(classes, classes + num);
 
-        transforms[idx].transform(left, top, &left, &top);
-        transforms[idx].transform(right, bottom, &right, &bottom);
+    // The key points of the valid detections are contiguous in the output tensor: copy them at once, then map
+    // them back to the source image in place
+    result.kpts.assign(kpts, kpts + static_cast<size_t>(num) * nkpt * ndim);
+    transforms[idx].transformPoints(result.kpts.data(), num * nkpt, ndim);
 
-        result.boxes.emplace_back(Box{left, top, right, bottom});
-        result.scores.emplace_back(scores[i]);
-        result.classes.emplace_back(classes[i]);
+    // Map the boxes back to the source image, clipped to its bounds
+    transformBoxes(boxes, num, this->tensorInfos[2].dims.d[2], transforms[idx], true, result.boxes);
+}
 
-        std::vector<KeyPoint> keypoints;
-        for (int j = 0; j < nkpt; ++j) {
-            float x = kpts[i * nkpt * ndim + j * ndim];
-            float y = kpts[i * nkpt * ndim + j * ndim + 1];
-            transforms[idx].transform(x, y, &x, &y);
-            keypoints.emplace_back((ndim == 2) ? KeyPoint(x, y) : KeyPoint(x, y, kpts[i * nkpt * ndim + j * ndim + 2]));
+// Post-processes the images of a batch, in parallel when an executor is set. Each task only reads the output
+// slices of its own image and writes its own result.
+template <typename T>
+void BaseTemplate<T>::postProcessBatch(int count, std::vector<T>& results) {
+    results.resize(count);
+    auto task = [this, &results](int idx) {
+        CpuTimer timer;
+        timer.start();
+        this->postProcess(idx, results[idx]);
+        timer.stop();
+        this->inferStats.record(Stage::kPostProcess, timer.milliseconds());
+    };
+
+    if (postProcessExecutor && count > 1) {
+        postProcessExecutor(count, task);
+    } else {
+        for (int i = 0; i < count; ++i) {
+            task(i);
         }
-        result.kpts.emplace_back(std::move(keypoints));
     }
+}
 
-    return result;
+// Performs inference on a batch of input images, ordered after the work already queued on a stream.
+template <typename T>
+std::vector<T> BaseTemplate<T>::predict(const std::vector<Image>& images, cudaStream_t stream) {
+    std::vector<T> results;
+    if (this->enqueue(images, stream)) this->wait(results);
+    return results;
+}
+
+// Asynchronous inference needs an implementation that can queue the whole pipeline on a stream.
+template <typename T>
+bool BaseTemplate<T>::enqueue(const std::vector<Image>& images, cudaStream_t stream, std::function<void()> onComplete) {
+    throw std::runtime_error("Asynchronous inference is not supported by this model.");
+}
+
+// External inputs need an implementation that can bind the input of the engine to any buffer.
+template <typename T>
+bool BaseTemplate<T>::enqueueInput(int count, const float* input, const std::vector<TransformMatrix>& transforms, cudaStream_t stream, std::function<void()> onComplete) {
+    throw std::runtime_error("Preprocessed inputs are not supported by this model.");
+}
+
+// Waits for the batch queued by enqueue and post-processes it.
+template <typename T>
+bool BaseTemplate<T>::wait(std::vector<T>& results) {
+    if (pendingImages == 0) {
+        results.clear();
+        return false;
+    }
+
+    CUDA(cudaEventSynchronize(doneEvent));
+    int count     = pendingImages;
+    pendingImages = 0;
+    completion    = nullptr;
+
+    // Every event of the frame has completed at this point, so resolving it never blocks
+    inferStats.collect();
+
+    NvtxRange range(stageName(Stage::kPostProcess), inferStats.nvtxEnabled());
+    postProcessBatch(count, results);
+    return true;
+}
+
+// Marks a batch as in flight once its outputs are queued for download on a stream.
+template <typename T>
+void BaseTemplate<T>::finishEnqueue(int count, cudaStream_t stream, std::function<void()> onComplete) {
+    // The callback runs before doneEvent completes, so wait never returns while it still uses the stored function
+    completion = std::move(onComplete);
+    if (completion) {
+        CUDA(cudaLaunchHostFunc(stream, runCompletion, &completion));
+    }
+    CUDA(cudaEventRecord(doneEvent, stream));
+    pendingImages = count;
+}
+
+// Device-resident results need an implementation that controls where the engine writes its outputs.
+template <typename T>
+bool BaseTemplate<T>::predictDevice(const std::vector<Image>& images, DeviceDetections& detections, bool mapToSource) {
+    throw std::runtime_error("Device-resident results are not supported by this model.");
+}
+
+// Describes the output buffers of a batch as a DeviceDetections view.
+template <typename T>
+void BaseTemplate<T>::describeOutputs(int count, const std::vector<void*>& buffers, DeviceDetections& detections) const {
+    if (rawHead) {
+        throw std::runtime_error("Device-resident results need an engine exported with the NMS plugin.");
+    }
+
+    detections.batch   = count;
+    detections.maxDets = tensorInfos[2].dims.d[1];
+    detections.boxSize = tensorInfos[2].dims.d[2];
+    detections.numDets = static_cast<const int*>(buffers[1]);
+    detections.boxes   = static_cast<float*>(buffers[2]);
+    detections.scores  = static_cast<const float*>(buffers[3]);
+    detections.classes = static_cast<const int*>(buffers[4]);
+    detections.transforms.assign(transforms.begin(), transforms.begin() + count);
+
+    detections.masks = nullptr;
+    detections.kpts  = nullptr;
+    if (std::is_same<T, SegResult>::value) {
+        detections.masks      = static_cast<const uint8_t*>(buffers[5]);
+        detections.maskHeight = tensorInfos[5].dims.d[2];
+        detections.maskWidth  = tensorInfos[5].dims.d[3];
+    } else if (std::is_same<T, PoseResult>::value) {
+        detections.kpts = static_cast<float*>(buffers[5]);
+        detections.nkpt = tensorInfos[5].dims.d[2];
+        detections.ndim = tensorInfos[5].dims.d[3];
+    }
 }
 
 // Constructor to initialize DeployTemplate with a model file, optional CUDA memory flag, and device index.
 template <typename T>
-DeployTemplate<T>::DeployTemplate(const std::string& file, bool cudaMem, int device) : BaseTemplate<T>(file, cudaMem, device) {
+DeployTemplate<T>::DeployTemplate(const std::string& file, bool cudaMem, int device) : DeployTemplate(loadEngine(file, device), cudaMem, device) {
+}
+
+// Constructor to initialize DeployTemplate with an engine loaded beforehand.
+template <typename T>
+DeployTemplate<T>::DeployTemplate(std::shared_ptr<EngineContext> engine, bool cudaMem, int device) : BaseTemplate<T>(std::move(engine), cudaMem, device) {
     // Setup tensors based on the engine context
     this->setupTensors();
 
@@ -199,14 +462,32 @@ void DeployTemplate<T>::allocate() {
         CUDA(cudaStreamCreate(&stream));
     }
 
+    // Create the events that fork the preprocessing from the stream of a batch and join it back
+    CUDA(cudaEventCreateWithFlags(&this->doneEvent, cudaEventDisableTiming));
+    CUDA(cudaEventCreateWithFlags(&this->forkEvent, cudaEventDisableTiming));
+    this->inputEvents.resize(this->batch);
+    for (auto& event : this->inputEvents) {
+        CUDA(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    }
+
     // Allocate transforms and image tensors
     this->transforms.resize(this->batch, TransformMatrix());
     if (!this->cudaMem) this->imageTensors.resize(this->batch, Tensor());
+
+    // Allocate the runtime thresholds, starting from the exported ones
+    if (this->thresholdsInfo) {
+        this->thresholdsInfo->tensor.host(this->thresholdsInfo->bytes);
+        this->thresholdsInfo->tensor.device(this->thresholdsInfo->bytes);
+        this->setThresholds(-1.0f, -1.0f, -1);
+    }
 }
 
 // Releases resources that were allocated for inference.
 template <typename T>
 void DeployTemplate<T>::release() {
+    // Release the ring of output buffers while the infer stream still exists
+    this->releaseSlots();
+
     // Release infer stream
     if (this->inferStream != nullptr) {
         CUDA(cudaStreamDestroy(this->inferStream));
@@ -221,9 +502,24 @@ void DeployTemplate<T>::release() {
     }
     this->inputStreams.clear();
 
+    // Release events
+    for (cudaEvent_t* event : {&this->doneEvent, &this->forkEvent}) {
+        if (*event != nullptr) {
+            CUDA(cudaEventDestroy(*event));
+            *event = nullptr;
+        }
+    }
+    for (auto& event : this->inputEvents) {
+        if (event != nullptr) {
+            CUDA(cudaEventDestroy(event));
+        }
+    }
+    this->inputEvents.clear();
+
     // Release other resources
     this->transforms.clear();
     this->tensorInfos.clear();
+    this->thresholdsInfo.reset();
     this->engineCtx.reset();
     if (!this->cudaMem) this->imageTensors.clear();
 }
@@ -240,42 +536,93 @@ void DeployTemplate<T>::setupTensors() {
         bool        input  = (this->engineCtx->mEngine->getTensorIOMode(name) == nvinfer1::TensorIOMode::kINPUT);
         size_t      typesz = getDataTypeSize(dtype);
 
+        // The runtime thresholds input is not batched, keep it apart from the image input
+        if (input && std::strcmp(name, kThresholdsTensorName) == 0) {
+            this->thresholdsInfo = std::make_shared<TensorInfo>(name, dims, input, typesz, calculateVolume(dims) * typesz);
+            continue;
+        }
+
         if (input) {
-            this->dynamic = std::any_of(dims.d, dims.d + dims.nbDims, [](int val) { return val == -1; });
-            if (this->dynamic) dims = this->engineCtx->mEngine->getProfileShape(name, 0, nvinfer1::OptProfileSelector::kMAX);
+            this->dynamic     = std::any_of(dims.d, dims.d + dims.nbDims, [](int val) { return val == -1; });
+            this->dynamicSize = dims.d[2] == -1 || dims.d[3] == -1;
+            if (this->dynamic) {
+                // The full input size is the largest shape of all the optimization profiles
+                this->profiles.resize(this->engineCtx->mEngine->getNbOptimizationProfiles());
+                for (size_t p = 0; p < this->profiles.size(); ++p) {
+                    auto& range = this->profiles[p];
+                    range.min   = this->engineCtx->mEngine->getProfileShape(name, p, nvinfer1::OptProfileSelector::kMIN);
+                    range.max   = this->engineCtx->mEngine->getProfileShape(name, p, nvinfer1::OptProfileSelector::kMAX);
+                    for (int d = 0; d < dims.nbDims; ++d) {
+                        dims.d[d] = p == 0 ? range.max.d[d] : std::max(dims.d[d], range.max.d[d]);
+                    }
+                }
+            }
             this->batch  = dims.d[0];
             this->height = dims.d[2];
             this->width  = dims.d[3];
-        } else if (!input && this->dynamic) {
-            dims.d[0] = this->batch;
+            this->rect   = this->dynamicSize;
         }
 
         int64_t bytes = calculateVolume(dims) * typesz;
         this->tensorInfos.emplace_back(name, dims, input, typesz, bytes);
     }
+
+    // The output shapes of a dynamic engine may follow the input size, resolve them at the largest input of the
+    // default profile
+    if (this->dynamic) {
+        auto& context = this->engineCtx->mContext;
+        for (auto& tensorInfo : this->tensorInfos) {
+            if (tensorInfo.input) context->setInputShape(tensorInfo.name.data(), this->profiles[0].max);
+        }
+        if (this->thresholdsInfo) context->setInputShape(this->thresholdsInfo->name.data(), this->thresholdsInfo->dims);
+        for (auto& tensorInfo : this->tensorInfos) {
+            if (tensorInfo.input) continue;
+            tensorInfo.dims      = context->getTensorShape(tensorInfo.name.data());
+            tensorInfo.dims.d[0] = this->batch;
+            tensorInfo.update();
+        }
+    }
+    this->setupRawHead();
 }
 
 // Preprocesses a single image in the batch before inference.
 template <typename T>
 void DeployTemplate<T>::preProcess(const int idx, const Image& image, cudaStream_t stream) {
-    this->transforms[idx].update(image.width, image.height, this->width, this->height);
+    this->transforms[idx].update(image.width, image.height, this->batchWidth, this->batchHeight);
 
-    int64_t inputSize   = 3 * this->height * this->width;
+    int64_t inputSize   = 3 * this->batchHeight * this->batchWidth;
     float*  inputDevice = static_cast<float*>(this->tensorInfos[0].tensor.device()) + idx * inputSize;
 
+    bool  nvtx        = this->inferStats.nvtxEnabled();
     void* imageDevice = nullptr;
+    int   warpStart   = -1;
     if (this->cudaMem) {
         imageDevice = image.rgbPtr;
+        warpStart   = this->inferStats.mark(stream);
     } else {
         int64_t imageSize = 3 * image.width * image.height;
         imageDevice       = this->imageTensors[idx].device(imageSize);
         void* imageHost   = this->imageTensors[idx].host(imageSize);
 
-        std::memcpy(imageHost, image.rgbPtr, imageSize * sizeof(uint8_t));
+        {
+            NvtxRange range(stageName(Stage::kStaging), nvtx);
+            CpuTimer  timer;
+            timer.start();
+            std::memcpy(imageHost, image.rgbPtr, imageSize * sizeof(uint8_t));
+            timer.stop();
+            this->inferStats.record(Stage::kStaging, timer.milliseconds());
+        }
+
+        NvtxRange range(stageName(Stage::kH2D), nvtx);
+        int       uploadStart = this->inferStats.mark(stream);
         CUDA(cudaMemcpyAsync(imageDevice, imageHost, imageSize * sizeof(uint8_t), cudaMemcpyHostToDevice, stream));
+        warpStart = this->inferStats.mark(stream);
+        this->inferStats.span(Stage::kH2D, uploadStart, warpStart);
     }
 
-    cudaWarpAffine(static_cast<uint8_t*>(imageDevice), image.width, image.height, inputDevice, this->width, this->height, this->transforms[idx].matrix, stream);
+    NvtxRange range(stageName(Stage::kWarp), nvtx);
+    cudaWarpAffine(static_cast<uint8_t*>(imageDevice), image.width, image.height, inputDevice, this->batchWidth, this->batchHeight, this->transforms[idx].matrix, stream);
+    this->inferStats.span(Stage::kWarp, warpStart, this->inferStats.mark(stream));
 }
 
 // Performs inference on a single input image.
@@ -285,63 +632,350 @@ T DeployTemplate<T>::predict(const Image& image) {
     if (results.empty()) {
         return T();
     }
-    return results[0];
+    return std::move(results[0]);
 }
 
 // Performs inference on a batch of input images.
 template <typename T>
 std::vector<T> DeployTemplate<T>::predict(const std::vector<Image>& images) {
     std::vector<T> results;
-    int            numImages = images.size();
+    this->predictInto(images, results);
+    return results;
+}
+
+// Performs inference on a batch of input images, writing the results into an existing vector.
+template <typename T>
+bool DeployTemplate<T>::predictInto(const std::vector<Image>& images, std::vector<T>& results) {
+    if (!this->enqueue(images, this->inferStream)) {
+        results.clear();
+        return false;
+    }
+    return this->wait(results);
+}
+
+// Queues the inference of a batch on a stream of the caller and returns without waiting for it.
+template <typename T>
+bool DeployTemplate<T>::enqueue(const std::vector<Image>& images, cudaStream_t stream, std::function<void()> onComplete) {
+    if (this->pendingImages > 0) {
+        std::cerr << "Error: The previous batch must be waited for before enqueuing another one." << std::endl;
+        return false;
+    }
+    if (!this->launch(images, nullptr, stream)) {
+        return false;
+    }
+
+    this->download(images.size(), stream, std::move(onComplete));
+    return true;
+}
+
+// Queues the inference of a batch preprocessed by the caller on a stream, and returns without waiting for it.
+template <typename T>
+bool DeployTemplate<T>::enqueueInput(int count, const float* input, const std::vector<TransformMatrix>& transforms, cudaStream_t stream, std::function<void()> onComplete) {
+    if (this->pendingImages > 0) {
+        std::cerr << "Error: The previous batch must be waited for before enqueuing another one." << std::endl;
+        return false;
+    }
+    if (count < 1 || count > this->batch || static_cast<int>(transforms.size()) < count || input == nullptr) {
+        std::cerr << "Error: Number of images (" << count << ") must be between 1 and " << this->batch << " inclusive, with one transform each." << std::endl;
+        return false;
+    }
+
+    // The outputs are shared by all batches, order this one after the previous, which may have run on another stream
+    CUDA(cudaStreamWaitEvent(stream, this->doneEvent, 0));
+
+    // The caller letterboxes to the full input size, which is within the largest profile
+    int height = this->height, width = this->width;
+    if (!this->selectProfile(count, height, width, stream)) {
+        return false;
+    }
+    std::copy_n(transforms.begin(), count, this->transforms.begin());
+    this->bindTensors(count, height, width, nullptr, input);
+    if (!this->execute(stream)) {
+        return false;
+    }
+
+    this->download(count, stream, std::move(onComplete));
+    return true;
+}
+
+// Performs inference on a batch of input images and leaves the outputs on the device.
+template <typename T>
+bool DeployTemplate<T>::predictDevice(const std::vector<Image>& images, DeviceDetections& detections, bool mapToSource) {
+    if (this->deviceSlots.empty()) {
+        this->deviceSlots.resize(this->deviceRingSize);
+        for (auto& slot : this->deviceSlots) {
+            slot.outputs.resize(this->tensorInfos.size(), Tensor());
+            CUDA(cudaEventCreateWithFlags(&slot.ready, cudaEventDisableTiming));
+        }
+    }
+
+    if (this->pendingImages > 0) {
+        std::cerr << "Error: The previous batch must be waited for before enqueuing another one." << std::endl;
+        detections = DeviceDetections();
+        return false;
+    }
+
+    // The slot was handed out deviceRingSize calls ago, its batch must be complete before the buffers are reused
+    int         slotIdx = this->nextSlot;
+    DeviceSlot& slot    = this->deviceSlots[slotIdx];
+    CUDA(cudaEventSynchronize(slot.ready));
+
+    if (!this->launch(images, &slot, this->inferStream)) {
+        detections = DeviceDetections();
+        return false;
+    }
+    this->nextSlot = (slotIdx + 1) % this->deviceRingSize;
+
+    int                numImages = images.size();
+    std::vector<void*> buffers(this->tensorInfos.size(), nullptr);
+    for (size_t i = 0; i < this->tensorInfos.size(); ++i) {
+        if (!this->tensorInfos[i].input) buffers[i] = slot.outputs[i].device();
+    }
+    this->describeOutputs(numImages, buffers, detections);
+    detections.sourceCoordinates = mapToSource;
+    detections.device            = true;
+    detections.ready             = slot.ready;
+    detections.slot              = slotIdx;
+
+    if (mapToSource) {
+        int64_t bytes          = numImages * sizeof(TransformMatrix);
+        auto*   hostTransforms = static_cast<TransformMatrix*>(slot.transforms.host(bytes));
+        auto*   devTransforms  = static_cast<TransformMatrix*>(slot.transforms.device(bytes));
+        std::copy_n(this->transforms.begin(), numImages, hostTransforms);
+        CUDA(cudaMemcpyAsync(devTransforms, hostTransforms, bytes, cudaMemcpyHostToDevice, this->inferStream));
+
+        // Rotated boxes are not clipped, their corners are not their extents
+        cudaTransformDetections(detections.boxes, detections.numDets, numImages, detections.maxDets, 1, detections.boxSize, 4,
+                                detections.boxSize == 4, devTransforms, this->inferStream);
+        if (detections.kpts != nullptr) {
+            cudaTransformDetections(detections.kpts, detections.numDets, numImages, detections.maxDets, detections.nkpt, detections.ndim, 2,
+                                    false, devTransforms, this->inferStream);
+        }
+    }
+
+    CUDA(cudaEventRecord(slot.ready, this->inferStream));
+    CUDA(cudaEventRecord(this->doneEvent, this->inferStream));
+    this->inferStats.commit();
+    this->inferStats.collect();
+
+    return true;
+}
+
+// Sets the number of output buffer sets cycled through by predictDevice.
+template <typename T>
+void DeployTemplate<T>::setDeviceRingSize(int size) {
+    if (size < 1) {
+        throw std::invalid_argument("The ring of output buffers needs at least one slot.");
+    }
+    this->releaseSlots();
+    this->deviceRingSize = size;
+}
+
+// Enables or disables rectangular inputs on engines with a dynamic input height and width.
+template <typename T>
+void DeployTemplate<T>::setRectInference(bool enabled, int stride) {
+    if (stride < 1) {
+        throw std::invalid_argument("The stride of rectangular inputs must be positive.");
+    }
+    this->rect       = enabled && this->dynamicSize;
+    this->rectStride = stride;
+}
+
+// Waits for the batches still using the ring of output buffers, then frees it.
+template <typename T>
+void DeployTemplate<T>::releaseSlots() {
+    for (auto& slot : this->deviceSlots) {
+        if (slot.ready != nullptr) {
+            CUDA(cudaEventSynchronize(slot.ready));
+            CUDA(cudaEventDestroy(slot.ready));
+        }
+    }
+    this->deviceSlots.clear();
+    this->nextSlot = 0;
+}
+
+// Preprocesses a batch and enqueues the engine on a stream.
+template <typename T>
+bool DeployTemplate<T>::launch(const std::vector<Image>& images, DeviceSlot* slot, cudaStream_t stream) {
+    int numImages = images.size();
     if (numImages < 1 || numImages > this->batch) {
         std::cerr << "Error: Number of images (" << numImages << ") must be between 1 and " << this->batch << " inclusive." << std::endl;
-        return results;
+        return false;
     }
 
-    for (auto& tensorInfo : this->tensorInfos) {
-        tensorInfo.dims.d[0] = numImages;
-        if (this->dynamic) tensorInfo.update();
-        if (!tensorInfo.input) tensorInfo.tensor.host(tensorInfo.bytes);
+    // Scale the images as the full input size would, then pad them only up to the next multiple of the stride
+    this->batchWidth  = this->width;
+    this->batchHeight = this->height;
+    if (this->rect) {
+        auto align = [this](double size) {
+            return (static_cast<int>(std::lround(size)) + this->rectStride - 1) / this->rectStride * this->rectStride;
+        };
+        this->batchWidth = this->batchHeight = 0;
+        for (const auto& image : images) {
+            double scale      = std::min(static_cast<double>(this->width) / image.width, static_cast<double>(this->height) / image.height);
+            this->batchWidth  = std::max(this->batchWidth, std::min(align(image.width * scale), this->width));
+            this->batchHeight = std::max(this->batchHeight, std::min(align(image.height * scale), this->height));
+        }
+    }
 
-        this->engineCtx->mContext->setTensorAddress(tensorInfo.name.data(), tensorInfo.tensor.device(tensorInfo.bytes));
-        if (tensorInfo.input && this->dynamic) {
-            this->engineCtx->mContext->setInputShape(tensorInfo.name.data(), tensorInfo.dims);
+    // The input tensor and the execution context are shared by all batches, order this one after the previous,
+    // which may have run on another stream
+    CUDA(cudaStreamWaitEvent(stream, this->doneEvent, 0));
+    if (!this->selectProfile(numImages, this->batchHeight, this->batchWidth, stream)) {
+        return false;
+    }
+    this->bindTensors(numImages, this->batchHeight, this->batchWidth, slot, nullptr);
+
+    // The staging buffer of an image is refilled from the host, its previous upload must be done
+    if (!this->cudaMem) {
+        for (int i = 0; i < numImages; ++i) {
+            CUDA(cudaEventSynchronize(this->inputEvents[i]));
         }
     }
 
+    // Fork the per-image preprocessing from the stream and join it back with events, so the host never waits
     if (numImages > 1) {
-        for (size_t i = 0; i < numImages; ++i) {
+        CUDA(cudaEventRecord(this->forkEvent, stream));
+        for (int i = 0; i < numImages; ++i) {
+            CUDA(cudaStreamWaitEvent(this->inputStreams[i], this->forkEvent, 0));
             this->preProcess(i, images[i], this->inputStreams[i]);
+            CUDA(cudaEventRecord(this->inputEvents[i], this->inputStreams[i]));
+            CUDA(cudaStreamWaitEvent(stream, this->inputEvents[i], 0));
         }
+    } else {
+        this->preProcess(0, images[0], stream);
+        CUDA(cudaEventRecord(this->inputEvents[0], stream));
+    }
 
-        for (auto& stream : this->inputStreams) {
-            CUDA(cudaStreamSynchronize(stream));
+    return this->execute(stream);
+}
+
+// Selects the optimization profile of a batch, and raises its input size to the minimum of the profile.
+template <typename T>
+bool DeployTemplate<T>::selectProfile(int count, int& height, int& width, cudaStream_t stream) {
+    if (!this->dynamic) return true;
+
+    // The profile with the smallest maximum has its kernels tuned closest to the batch
+    int     selected = -1;
+    int64_t smallest = 0;
+    for (size_t p = 0; p < this->profiles.size(); ++p) {
+        const auto& range = this->profiles[p];
+        if (count < range.min.d[0] || count > range.max.d[0] || height > range.max.d[2] || width > range.max.d[3]) continue;
+        int64_t volume = calculateVolume(range.max);
+        if (selected < 0 || volume < smallest) {
+            selected = static_cast<int>(p);
+            smallest = volume;
         }
-    } else {
-        this->preProcess(0, images[0], this->inferStream);
+    }
+    if (selected < 0) {
+        std::cerr << "Error: No optimization profile accepts " << count << " images of " << width << "x" << height << "." << std::endl;
+        return false;
     }
 
-    if (!this->engineCtx->mContext->enqueueV3(this->inferStream)) return {};
+    height = std::max(height, static_cast<int>(this->profiles[selected].min.d[2]));
+    width  = std::max(width, static_cast<int>(this->profiles[selected].min.d[3]));
+    if (selected != this->profile) {
+        if (!this->engineCtx->mContext->setOptimizationProfileAsync(selected, stream)) {
+            std::cerr << "Error: Failed to select optimization profile " << selected << "." << std::endl;
+            return false;
+        }
+        this->profile = selected;
+    }
+    return true;
+}
+
+// Binds the tensors of the engine for a batch, and reads back the output shapes of dynamic engines.
+template <typename T>
+void DeployTemplate<T>::bindTensors(int count, int height, int width, DeviceSlot* slot, const float* input) {
+    auto& context = this->engineCtx->mContext;
 
+    // The input shape of a dynamic engine is set first, its output shapes follow from it
     for (auto& tensorInfo : this->tensorInfos) {
-        if (!tensorInfo.input) {
-            CUDA(cudaMemcpyAsync(tensorInfo.tensor.host(), tensorInfo.tensor.device(), tensorInfo.bytes, cudaMemcpyDeviceToHost, this->inferStream));
+        if (!tensorInfo.input) continue;
+        tensorInfo.dims.d[0] = count;
+        if (this->dynamic) {
+            tensorInfo.dims.d[2] = height;
+            tensorInfo.dims.d[3] = width;
+            tensorInfo.update();
+            context->setInputShape(tensorInfo.name.data(), tensorInfo.dims);
+        }
+    }
+    if (this->thresholdsInfo && this->dynamic) {
+        context->setInputShape(this->thresholdsInfo->name.data(), this->thresholdsInfo->dims);
+    }
+    for (auto& tensorInfo : this->tensorInfos) {
+        if (tensorInfo.input) continue;
+        if (this->dynamic) {
+            tensorInfo.dims = context->getTensorShape(tensorInfo.name.data());
+            tensorInfo.update();
+        } else {
+            tensorInfo.dims.d[0] = count;
         }
     }
+    if (this->rawHead) this->rawHead->numAnchors = static_cast<int>(this->tensorInfos[1].dims.d[2]);
+
+    for (size_t i = 0; i < this->tensorInfos.size(); ++i) {
+        auto& tensorInfo = this->tensorInfos[i];
+
+        // Outputs go to the ring slot when they stay on the device, otherwise they are copied back to the host
+        void* address = nullptr;
+        if (tensorInfo.input && input != nullptr) {
+            address = const_cast<float*>(input);
+        } else if (!tensorInfo.input && slot != nullptr) {
+            address = slot->outputs[i].device(tensorInfo.bytes);
+        } else {
+            if (!tensorInfo.input) tensorInfo.tensor.host(tensorInfo.bytes);
+            address = tensorInfo.tensor.device(tensorInfo.bytes);
+        }
 
-    CUDA(cudaStreamSynchronize(this->inferStream));
+        context->setTensorAddress(tensorInfo.name.data(), address);
+    }
+    if (this->thresholdsInfo) {
+        context->setTensorAddress(this->thresholdsInfo->name.data(), this->thresholdsInfo->tensor.device());
+    }
+}
+
+// Enqueues the engine on a stream once its tensors are bound.
+template <typename T>
+bool DeployTemplate<T>::execute(cudaStream_t stream) {
+    int inferStart = this->inferStats.mark(stream);
+    {
+        NvtxRange range(stageName(Stage::kEnqueue), this->inferStats.nvtxEnabled());
+        if (!this->engineCtx->mContext->enqueueV3(stream)) {
+            this->inferStats.commit();
+            return false;
+        }
+    }
+    this->inferStats.span(Stage::kEnqueue, inferStart, this->inferStats.mark(stream));
+    return true;
+}
 
-    results.reserve(numImages);
-    for (int i = 0; i < numImages; ++i) {
-        results.emplace_back(this->postProcess(i));
+// Queues the copy of the outputs back to the host after the engine, then marks the batch as in flight.
+template <typename T>
+void DeployTemplate<T>::download(int count, cudaStream_t stream, std::function<void()> onComplete) {
+    int copyStart = this->inferStats.mark(stream);
+    {
+        NvtxRange range(stageName(Stage::kD2H), this->inferStats.nvtxEnabled());
+        for (auto& tensorInfo : this->tensorInfos) {
+            if (!tensorInfo.input) {
+                CUDA(cudaMemcpyAsync(tensorInfo.tensor.host(), tensorInfo.tensor.device(), tensorInfo.bytes, cudaMemcpyDeviceToHost, stream));
+            }
+        }
+        this->inferStats.span(Stage::kD2H, copyStart, this->inferStats.mark(stream));
     }
+    this->inferStats.commit();
 
-    return results;
+    this->finishEnqueue(count, stream, std::move(onComplete));
 }
 
 // Constructor to initialize DeployCGTemplate with a model file, optional CUDA memory flag, and device index.
 template <typename T>
-DeployCGTemplate<T>::DeployCGTemplate(const std::string& file, bool cudaMem, int device) : BaseTemplate<T>(file, cudaMem, device) {
+DeployCGTemplate<T>::DeployCGTemplate(const std::string& file, bool cudaMem, int device) : DeployCGTemplate(loadEngine(file, device), cudaMem, device) {
+}
+
+// Constructor to initialize DeployCGTemplate with an engine loaded beforehand.
+template <typename T>
+DeployCGTemplate<T>::DeployCGTemplate(std::shared_ptr<EngineContext> engine, bool cudaMem, int device) : BaseTemplate<T>(std::move(engine), cudaMem, device) {
     // Setup tensors based on the engine context
     this->setupTensors();
 
@@ -371,6 +1005,7 @@ template <typename T>
 void DeployCGTemplate<T>::allocate() {
     // Create the main inference stream
     CUDA(cudaStreamCreate(&this->inferStream));
+    CUDA(cudaEventCreateWithFlags(&this->doneEvent, cudaEventDisableTiming));
 
     // Create resources for batched inputs
     if (this->batch > 1) {
@@ -403,6 +1038,13 @@ void DeployCGTemplate<T>::allocate() {
     for (size_t i = 0; i < this->batch; i++) {
         this->transforms[i].update(this->width, this->height, this->width, this->height);
     }
+
+    // Allocate the runtime thresholds, starting from the exported ones
+    if (this->thresholdsInfo) {
+        this->thresholdsInfo->tensor.host(this->thresholdsInfo->bytes);
+        this->thresholdsInfo->tensor.device(this->thresholdsInfo->bytes);
+        this->setThresholds(-1.0f, -1.0f, -1);
+    }
 }
 
 // Releases resources that were allocated for inference.
@@ -425,6 +1067,10 @@ void DeployCGTemplate<T>::release() {
         CUDA(cudaStreamDestroy(this->inferStream));
         this->inferStream = nullptr;
     }
+    if (this->doneEvent != nullptr) {
+        CUDA(cudaEventDestroy(this->doneEvent));
+        this->doneEvent = nullptr;
+    }
 
     // Release resources for batched inputs
     if (this->batch > 1) {
@@ -449,6 +1095,7 @@ void DeployCGTemplate<T>::release() {
     this->kernelsParams.clear();
     this->imageSize.clear();
     this->tensorInfos.clear();
+    this->thresholdsInfo.reset();
     this->transforms.clear();
     this->engineCtx.reset();
     this->imageTensor.reset();
@@ -466,6 +1113,12 @@ void DeployCGTemplate<T>::setupTensors() {
         bool        input  = (this->engineCtx->mEngine->getTensorIOMode(name) == nvinfer1::TensorIOMode::kINPUT);
         size_t      typesz = getDataTypeSize(dtype);
 
+        // The runtime thresholds input is not batched, keep it apart from the image input
+        if (input && std::strcmp(name, kThresholdsTensorName) == 0) {
+            this->thresholdsInfo = std::make_shared<TensorInfo>(name, dims, input, typesz, calculateVolume(dims) * typesz);
+            continue;
+        }
+
         // Validate dimensions for input tensors
         if (input) {
             if (std::any_of(dims.d, dims.d + dims.nbDims, [](int val) { return val == -1; })) {
@@ -480,6 +1133,7 @@ void DeployCGTemplate<T>::setupTensors() {
         int64_t bytes = calculateVolume(dims) * typesz;
         this->tensorInfos.emplace_back(name, dims, input, typesz, bytes);
     }
+    this->setupRawHead();
 }
 
 // Creates the CUDA graph for inference execution.
@@ -492,6 +1146,9 @@ void DeployCGTemplate<T>::createGraph() {
             tensorInfo.tensor.host(tensorInfo.bytes);
         }
     }
+    if (this->thresholdsInfo) {
+        this->engineCtx->mContext->setTensorAddress(this->thresholdsInfo->name.data(), this->thresholdsInfo->tensor.device());
+    }
 
     // Perform an initial inference to ensure everything is set up correctly
     if (!this->engineCtx->mContext->enqueueV3(this->inferStream)) {
@@ -500,7 +1157,8 @@ void DeployCGTemplate<T>::createGraph() {
     CUDA(cudaStreamSynchronize(this->inferStream));
 
     // Begin capturing the CUDA graph
-    CUDA(cudaStreamBeginCapture(this->inferStream, cudaStreamCaptureModeGlobal));
+    // Thread-local capture, so that models serving on other threads are not affected while this one is built
+    CUDA(cudaStreamBeginCapture(this->inferStream, cudaStreamCaptureModeThreadLocal));
 
     // Copy image data to device memory if CUDA memory optimization is not enabled
     if (!this->cudaMem) {
@@ -563,6 +1221,14 @@ void DeployCGTemplate<T>::getGraphNodes() {
     }
 }
 
+// Layer profiling is not supported with CUDA graphs.
+template <typename T>
+void DeployCGTemplate<T>::setProfiler(std::shared_ptr<LayerProfiler> profiler) {
+    if (profiler) {
+        throw std::runtime_error("Layer profiling is not supported with CUDA graphs, use DeployTemplate instead.");
+    }
+}
+
 // Performs inference on a single input image.
 template <typename T>
 T DeployCGTemplate<T>::predict(const Image& image) {
@@ -570,16 +1236,37 @@ T DeployCGTemplate<T>::predict(const Image& image) {
     if (results.empty()) {
         return T();
     }
-    return results[0];
+    return std::move(results[0]);
 }
 
 // Performs inference on a batch of input images.
 template <typename T>
 std::vector<T> DeployCGTemplate<T>::predict(const std::vector<Image>& images) {
     std::vector<T> results;
+    this->predictInto(images, results);
+    return results;
+}
+
+// Performs inference on a batch of input images, writing the results into an existing vector.
+template <typename T>
+bool DeployCGTemplate<T>::predictInto(const std::vector<Image>& images, std::vector<T>& results) {
+    if (!this->enqueue(images, this->inferStream)) {
+        results.clear();
+        return false;
+    }
+    return this->wait(results);
+}
+
+// Queues the CUDA graph of a batch on a stream of the caller and returns without waiting for it.
+template <typename T>
+bool DeployCGTemplate<T>::enqueue(const std::vector<Image>& images, cudaStream_t stream, std::function<void()> onComplete) {
+    if (this->pendingImages > 0) {
+        std::cerr << "Error: The previous batch must be waited for before enqueuing another one." << std::endl;
+        return false;
+    }
     if (images.size() != this->batch) {
         std::cerr << "Error: Batch size mismatch. Expected " << this->batch << " images, but got " << images.size() << " images." << std::endl;
-        return results;
+        return false;
     }
 
     // Update graph nodes for each image in the batch
@@ -606,9 +1293,14 @@ std::vector<T> DeployCGTemplate<T>::predict(const std::vector<Image>& images) {
         void* device = this->imageTensor->device(totalSize * sizeof(uint8_t));
 
         // Copy each image data to a contiguous region in host memory
-        void* hostPtr = host;
+        NvtxRange range(stageName(Stage::kStaging), this->inferStats.nvtxEnabled());
+        void*     hostPtr = host;
         for (int i = 0; i < this->batch; i++) {
+            CpuTimer timer;
+            timer.start();
             std::memcpy(hostPtr, images[i].rgbPtr, this->imageSize[i] * sizeof(uint8_t));
+            timer.stop();
+            this->inferStats.record(Stage::kStaging, timer.milliseconds());
             hostPtr = static_cast<void*>(static_cast<uint8_t*>(hostPtr) + this->imageSize[i]);
         }
 
@@ -629,18 +1321,17 @@ std::vector<T> DeployCGTemplate<T>::predict(const std::vector<Image>& images) {
         }
     }
 
-    // Launch the CUDA graph
-    CUDA(cudaGraphLaunch(this->inferGraphExec, this->inferStream));
-
-    // Synchronize the stream to ensure all operations are completed
-    CUDA(cudaStreamSynchronize(this->inferStream));
-
-    results.reserve(this->batch);
-    for (int i = 0; i < this->batch; ++i) {
-        results.emplace_back(this->postProcess(i));
+    // Launch the CUDA graph, launches of the same graph are ordered even across streams
+    {
+        NvtxRange range(stageName(Stage::kGraph), this->inferStats.nvtxEnabled());
+        int       graphStart = this->inferStats.mark(stream);
+        CUDA(cudaGraphLaunch(this->inferGraphExec, stream));
+        this->inferStats.span(Stage::kGraph, graphStart, this->inferStats.mark(stream));
+        this->inferStats.commit();
     }
 
-    return results;
+    this->finishEnqueue(this->batch, stream, std::move(onComplete));
+    return true;
 }
 
 }  // namespace deploy
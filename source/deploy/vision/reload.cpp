@@ -0,0 +1,187 @@
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "deploy/vision/reload.hpp"
+
+namespace deploy {
+
+namespace {
+
+bool sameDims(const nvinfer1::Dims& a, const nvinfer1::Dims& b) {
+    if (a.nbDims != b.nbDims) return false;
+    for (int i = 0; i < a.nbDims; ++i) {
+        if (a.d[i] != b.d[i]) return false;
+    }
+    return true;
+}
+
+// Checks that a new engine can replace the current one: callers see the same inputs and outputs, and the same
+// input shapes are accepted
+void checkCompatible(const nvinfer1::ICudaEngine& current, const nvinfer1::ICudaEngine& next) {
+    int count = current.getNbIOTensors();
+    if (next.getNbIOTensors() != count) {
+        throw std::runtime_error("The new engine has " + std::to_string(next.getNbIOTensors()) + " inputs and outputs, expected " + std::to_string(count) + ".");
+    }
+    int profiles = current.getNbOptimizationProfiles();
+    if (next.getNbOptimizationProfiles() != profiles) {
+        throw std::runtime_error("The new engine has " + std::to_string(next.getNbOptimizationProfiles()) + " optimization profiles, expected " + std::to_string(profiles) + ".");
+    }
+
+    for (int i = 0; i < count; ++i) {
+        const char* name     = current.getIOTensorName(i);
+        const char* nextName = next.getIOTensorName(i);
+        if (std::strcmp(name, nextName) != 0 || current.getTensorIOMode(name) != next.getTensorIOMode(nextName) ||
+            current.getTensorDataType(name) != next.getTensorDataType(nextName) ||
+            !sameDims(current.getTensorShape(name), next.getTensorShape(nextName))) {
+            throw std::runtime_error("Tensor " + std::string(nextName) + " of the new engine does not match " + std::string(name) + " of the current engine.");
+        }
+        if (current.getTensorIOMode(name) != nvinfer1::TensorIOMode::kINPUT) continue;
+
+        // The model sizes its buffers and selects profiles from these shapes, so they must not change either
+        for (int p = 0; p < profiles; ++p) {
+            for (auto selector : {nvinfer1::OptProfileSelector::kMIN, nvinfer1::OptProfileSelector::kOPT, nvinfer1::OptProfileSelector::kMAX}) {
+                if (!sameDims(current.getProfileShape(name, p, selector), next.getProfileShape(name, p, selector))) {
+                    throw std::runtime_error("Optimization profile " + std::to_string(p) + " of input " + std::string(name) + " differs in the new engine.");
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+// Constructor to initialize ReloadableTemplate with a model file, the kind of model, optional CUDA memory flag, and device index.
+template <typename T>
+ReloadableTemplate<T>::ReloadableTemplate(const std::string& file, bool cudaGraph, bool cudaMem, int device)
+    : cudaGraph(cudaGraph), cudaMem(cudaMem), device(device) {
+    current = build(loadEngine(file, device), file);
+}
+
+// Waits for the reload in progress, if any, then releases the model.
+template <typename T>
+ReloadableTemplate<T>::~ReloadableTemplate() {
+    std::lock_guard<std::mutex> lock(reloadMutex);
+    if (reloader.joinable()) reloader.join();
+}
+
+// Performs inference on a single input image with the current model.
+template <typename T>
+T ReloadableTemplate<T>::predict(const Image& image) {
+    auto                        serving = acquire();
+    std::lock_guard<std::mutex> lock(serving->mutex);
+    return serving->model->predict(image);
+}
+
+// Performs inference on a batch of input images with the current model.
+template <typename T>
+std::vector<T> ReloadableTemplate<T>::predict(const std::vector<Image>& images) {
+    auto                        serving = acquire();
+    std::lock_guard<std::mutex> lock(serving->mutex);
+    return serving->model->predict(images);
+}
+
+// Performs inference on a batch of input images with the current model, writing the results into an existing vector.
+template <typename T>
+bool ReloadableTemplate<T>::predictInto(const std::vector<Image>& images, std::vector<T>& results) {
+    auto                        serving = acquire();
+    std::lock_guard<std::mutex> lock(serving->mutex);
+    return serving->model->predictInto(images, results);
+}
+
+// Applies settings to the current model, and to every model built by later reloads.
+template <typename T>
+void ReloadableTemplate<T>::configure(std::function<void(BaseTemplate<T>&)> setting) {
+    std::shared_ptr<Serving> serving;
+    {
+        std::lock_guard<std::mutex> lock(currentMutex);
+        settings.push_back(setting);
+        serving = current;
+    }
+
+    // A reload switching in the meantime has replayed the setting on its model already
+    std::lock_guard<std::mutex> lock(serving->mutex);
+    setting(*serving->model);
+}
+
+// Replaces the engine in the background, without interrupting the calls being served.
+template <typename T>
+std::future<void> ReloadableTemplate<T>::reload(const std::string& file) {
+    std::lock_guard<std::mutex> lock(reloadMutex);
+    if (reloader.joinable()) reloader.join();
+
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future  = promise->get_future();
+    reloader     = std::thread([this, file, promise]() {
+        try {
+            // Check the engine before paying for the allocations and the CUDA graph capture
+            auto engine = loadEngine(file, device);
+            checkCompatible(*acquire()->engine->mEngine, *engine->mEngine);
+            auto next = build(std::move(engine), file);
+
+            size_t replayed = 0;
+            for (;;) {
+                std::vector<std::function<void(BaseTemplate<T>&)>> pending;
+                {
+                    std::lock_guard<std::mutex> lock(currentMutex);
+                    pending.assign(settings.begin() + replayed, settings.end());
+                }
+                if (pending.empty()) break;
+                for (auto& setting : pending) setting(*next->model);
+                replayed += pending.size();
+            }
+
+            // Switch the new calls, replaying the settings recorded since, which are cheap
+            std::shared_ptr<Serving> previous;
+            {
+                std::lock_guard<std::mutex> lock(currentMutex);
+                for (size_t i = replayed; i < settings.size(); ++i) settings[i](*next->model);
+                previous = std::move(current);
+                current  = std::move(next);
+            }
+
+            // Retire the previous model once the calls running on it have returned
+            { std::lock_guard<std::mutex> drain(previous->mutex); }
+            previous.reset();
+            promise->set_value();
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+// Gets the path of the model file currently serving.
+template <typename T>
+std::string ReloadableTemplate<T>::file() const {
+    return acquire()->file;
+}
+
+// Gets the number of images processed per batch by the current model.
+template <typename T>
+int ReloadableTemplate<T>::batch() const {
+    return acquire()->model->batch;
+}
+
+// Builds the model of an engine, without the recorded settings.
+template <typename T>
+std::shared_ptr<typename ReloadableTemplate<T>::Serving> ReloadableTemplate<T>::build(std::shared_ptr<EngineContext> engine, const std::string& file) {
+    auto serving    = std::make_shared<Serving>();
+    serving->engine = engine;
+    serving->file   = file;
+    if (cudaGraph) {
+        serving->model = std::make_unique<DeployCGTemplate<T>>(std::move(engine), cudaMem, device);
+    } else {
+        serving->model = std::make_unique<DeployTemplate<T>>(std::move(engine), cudaMem, device);
+    }
+    return serving;
+}
+
+// Gets the model receiving the new calls.
+template <typename T>
+std::shared_ptr<typename ReloadableTemplate<T>::Serving> ReloadableTemplate<T>::acquire() const {
+    std::lock_guard<std::mutex> lock(currentMutex);
+    return current;
+}
+
+}  // namespace deploy
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "deploy/utils/simd.hpp"
+#include "deploy/vision/cudaWarp.hpp"
+
+// Host-side bulk coordinate transforms. They live outside cudaWarp.cu so the SIMD intrinsics are only seen by
+// the host compiler.
+namespace deploy {
+
+namespace {
+
+using simd::kLanes;
+
+// Longest item handled by the vector loop, in floats (boxes, rotated boxes and key points are 2 to 5)
+constexpr int kMaxStride = 8;
+
+// Scale, offset and clipping range of each float of an item: the first `coords` floats alternate between x and
+// y, the others pass through unchanged.
+struct Lane {
+    float scale  = 1.0f;
+    float offset = 0.0f;
+    float lo     = -std::numeric_limits<float>::infinity();
+    float hi     = std::numeric_limits<float>::infinity();
+};
+
+Lane makeLane(const TransformMatrix& m, int position, int coords, bool clip) {
+    Lane lane;
+    if (position < coords) {
+        bool x      = position % 2 == 0;
+        lane.scale  = x ? m.matrix[0].x : m.matrix[1].y;
+        lane.offset = x ? m.matrix[0].z : m.matrix[1].z;
+        if (clip) {
+            lane.lo = 0.0f;
+            lane.hi = static_cast<float>(x ? m.lastWidth : m.lastHeight);
+        }
+    }
+    return lane;
+}
+
+// Maps `count` items of `stride` floats in place. The letterbox matrix only scales and translates, so every float
+// is mapped on its own, and kLanes items (kLanes * stride floats) always line up with `stride` whole vectors whose
+// lanes repeat the same per-float coefficients.
+void transformInterleaved(const TransformMatrix& m, float* data, int count, int stride, int coords, bool clip) {
+    if (kLanes > 1 && stride <= kMaxStride && count >= kLanes) {
+        alignas(32) float scale[kMaxStride * kLanes], offset[kMaxStride * kLanes];
+        alignas(32) float lo[kMaxStride * kLanes], hi[kMaxStride * kLanes];
+        const int         blockSize = kLanes * stride;
+        for (int j = 0; j < blockSize; ++j) {
+            Lane lane = makeLane(m, j % stride, coords, clip);
+            scale[j]  = lane.scale;
+            offset[j] = lane.offset;
+            lo[j]     = lane.lo;
+            hi[j]     = lane.hi;
+        }
+
+        const int blocks = count / kLanes;
+        for (int b = 0; b < blocks; ++b, data += blockSize) {
+            for (int k = 0; k < blockSize; k += kLanes) {
+                simd::Float v = simd::add(simd::mul(simd::load(data + k), simd::load(scale + k)), simd::load(offset + k));
+                if (clip) v = simd::min(simd::max(v, simd::load(lo + k)), simd::load(hi + k));
+                simd::store(data + k, v);
+            }
+        }
+        count -= blocks * kLanes;
+    }
+
+    // Scalar fallback, and the items left over by the vector loop
+    Lane lanes[4];
+    coords = std::min(coords, stride);
+    for (int j = 0; j < coords; ++j) {
+        lanes[j] = makeLane(m, j, coords, clip);
+    }
+    for (int i = 0; i < count; ++i, data += stride) {
+        for (int j = 0; j < coords; ++j) {
+            float v = data[j] * lanes[j].scale + lanes[j].offset;
+            data[j] = clip ? std::min(std::max(v, lanes[j].lo), lanes[j].hi) : v;
+        }
+    }
+}
+
+}  // namespace
+
+void TransformMatrix::transformPoints(float* points, int count, int stride) const {
+    transformInterleaved(*this, points, count, stride, 2, false);
+}
+
+void TransformMatrix::transformBoxes(float* boxes, int count, int stride, bool clip) const {
+    transformInterleaved(*this, boxes, count, stride, 4, clip);
+}
+
+void cpuTransformDetections(float* data, const int* numDets, int batch, int maxDets, int itemsPerDet, int stride, int coords,
+                            bool clip, const TransformMatrix* transforms) {
+    for (int image = 0; image < batch; ++image) {
+        float* base  = data + static_cast<int64_t>(image) * maxDets * itemsPerDet * stride;
+        int    count = std::min(numDets[image], maxDets) * itemsPerDet;
+        transformInterleaved(transforms[image], base, count, stride, coords, clip);
+    }
+}
+
+}  // namespace deploy
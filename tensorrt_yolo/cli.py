@@ -52,6 +52,16 @@ def trtyolo():
 @click.option('--conf_thres', default=0.25, help='Confidence threshold for object detection. Defaults to 0.25.', type=float)
 @click.option('--opset_version', default=11, help='ONNX opset version. Defaults to 11.', type=int)
 @click.option('-s', '--simplify', is_flag=True, help='Whether to simplify the exported ONNX. Defaults is False.')
+@click.option(
+    '--runtime_thresholds',
+    is_flag=True,
+    help='Add an nms_thresholds input to change the NMS thresholds at inference time. Detect, Segment and Pose PyTorch models only.',
+)
+@click.option(
+    '--fused_decode',
+    is_flag=True,
+    help='Let the NMS plugin decode the raw DFL head outputs. YOLOv8, YOLO11 and Ultralytics Detect, Segment and Pose models only.',
+)
 def export(
     model_dir,
     model_filename,
@@ -67,6 +77,8 @@ def export(
     conf_thres,
     opset_version,
     simplify,
+    runtime_thresholds,
+    fused_decode,
 ):
     """Export models for TensorRT-YOLO.
 
@@ -76,6 +88,10 @@ def export(
     from .export import paddle_export, torch_export
 
     if model_dir and model_filename and params_filename:
+        if runtime_thresholds:
+            logger.warning("Runtime thresholds are not supported for PP-YOLOE models, exporting with fixed thresholds.")
+        if fused_decode:
+            logger.warning("Fused decode is not supported for PP-YOLOE models, exporting with decoded boxes.")
         paddle_export(
             model_dir=model_dir,
             model_filename=model_filename,
@@ -101,6 +117,8 @@ def export(
             opset_version=opset_version,
             simplify=simplify,
             repo_dir=repo_dir,
+            runtime_thresholds=runtime_thresholds,
+            fused_decode=fused_decode,
         )
     else:
         logger.error("Please provide correct export parameters.")
@@ -113,7 +131,8 @@ def export(
 @click.option('-o', '--output', help='Output directory for inference results.', type=str)
 @click.option('-l', '--labels', help='Labels file for inference.', type=str)
 @click.option('--cudaGraph', help='Optimize inference using CUDA Graphs, compatible with static models only.', is_flag=True)
-def infer(engine, mode, input, output, labels, cudagraph):
+@click.option('--profile', help='Profile each engine layer and save a Chrome trace JSON to this path. Not compatible with --cudaGraph.', type=str)
+def infer(engine, mode, input, output, labels, cudagraph, profile):
     """Perform inference with TensorRT-YOLO.
 
     This command performs inference using TensorRT-YOLO with the specified engine file and input source.
@@ -126,6 +145,10 @@ def infer(engine, mode, input, output, labels, cudagraph):
         logger.error("Please provide a labels file using -l or --labels.")
         sys.exit(1)
 
+    if profile and cudagraph:
+        logger.error("Layer profiling is not supported with CUDA Graphs, please remove --cudaGraph.")
+        sys.exit(1)
+
     if output:
         from .infer import generate_labels_with_colors
 
@@ -138,6 +161,7 @@ def infer(engine, mode, input, output, labels, cudagraph):
 
     from .infer import (
         CpuTimer,
+        DeferredGpuTimer,
         DeployCGDet,
         DeployCGOBB,
         DeployCGPose,
@@ -146,7 +170,7 @@ def infer(engine, mode, input, output, labels, cudagraph):
         DeployOBB,
         DeployPose,
         DeploySeg,
-        GpuTimer,
+        LayerProfiler,
         image_batches,
         visualize,
     )
@@ -169,11 +193,15 @@ def infer(engine, mode, input, output, labels, cudagraph):
         else DeployDet(engine)
     )
 
+    if profile:
+        profiler = LayerProfiler()
+        model.set_profiler(profiler)
+
     batchs = image_batches(input, model.batch, cudagraph)
 
     if len(batchs) > 2:
         cpu_timer = CpuTimer()
-        gpu_timer = GpuTimer()
+        gpu_timer = DeferredGpuTimer()
 
     logger.info(f"Infering data in {input}")
     for batch in track(batchs, description="[cyan]Processing batches", total=len(batchs)):
@@ -197,9 +225,17 @@ def infer(engine, mode, input, output, labels, cudagraph):
     logger.success("Finished Inference.")
 
     if len(batchs) > 2:
+        gpu_timer.flush()
+        gpu_summary = gpu_timer.summary()
         logger.success(
             "Benchmark results include time for H2D and D2H memory copies, preprocessing, and postprocessing.\n"
             f"    CPU Average Latency: {cpu_timer.milliseconds() / len(batchs):.3f} ms\n"
-            f"    GPU Average Latency: {gpu_timer.milliseconds() / len(batchs):.3f} ms\n"
+            f"    GPU Average Latency: {gpu_summary.mean:.3f} ms (p50 {gpu_summary.p50:.3f} ms, p99 {gpu_summary.p99:.3f} ms)\n"
             "    Finished Inference."
         )
+
+    if profile:
+        model.set_profiler(None)
+        profiler.export_chrome_trace(profile)
+        logger.success(f"Per-layer timings over {profiler.runs()} runs:\n{profiler.table()}")
+        logger.success(f"Chrome trace saved to {profile}")
@@ -80,6 +80,26 @@ DYNAMIC_AXES = {
     "Pose": {**DEFAULT_DYNAMIC_AXES, "det_kpts": {0: "batch"}},
 }
 
+# Heads whose NMS plugin can take the thresholds as an input, see the runtime_thresholds export option
+RUNTIME_THRESHOLDS_HEADS = ["Detect", "Segment", "Pose"]
+
+# DFL heads whose boxes can be decoded by the NMS plugin, see the fused_decode export option
+FUSED_DECODE_HEADS = [UltralyticsDetect, UltralyticsSegment, UltralyticsPose]
+
+
+class RuntimeThresholdsModel(torch.nn.Module):
+    """Wraps a YOLO model to add the `nms_thresholds` input, which the head passes on to its NMS plugin."""
+
+    def __init__(self, model: torch.nn.Module, head: torch.nn.Module) -> None:
+        super().__init__()
+        self.model = model
+        self.head = head
+
+    def forward(self, images: torch.Tensor, nms_thresholds: torch.Tensor):
+        self.head.nms_thresholds = nms_thresholds
+        return self.model(images)
+
+
 YOLO_EXPORT_INFO = {
     'yolov6': "https://github.com/meituan/YOLOv6/tree/main/deploy/ONNX#tensorrt-backend-tensorrt-version-800",
     'yolov7': "https://github.com/WongKinYiu/yolov7#export",
@@ -180,6 +200,8 @@ def torch_export(
     opset_version: Optional[int] = 11,
     simplify: Optional[bool] = True,
     repo_dir: Optional[str] = None,
+    runtime_thresholds: Optional[bool] = False,
+    fused_decode: Optional[bool] = False,
 ) -> None:
     """
     Export YOLO model to ONNX format using Torch.
@@ -196,6 +218,10 @@ def torch_export(
         opset_version (Optional[int], optional): ONNX opset version. Defaults to 11.
         simplify (Optional[bool], optional): Whether to simplify the exported ONNX. Defaults to True.
         repo_dir (Optional[str], optional): Directory containing the local repository (if using torch.hub.load). Defaults to None.
+        runtime_thresholds (Optional[bool], optional): Whether to add an `nms_thresholds` input to change the NMS thresholds
+            at inference time. Defaults to False.
+        fused_decode (Optional[bool], optional): Whether to let the NMS plugin decode the raw DFL head outputs, only for the
+            candidates above the score threshold. Defaults to False.
     """
     logger.info("Starting export with Pytorch.")
     model = load_model(version, weights, repo_dir)
@@ -208,6 +234,15 @@ def torch_export(
     if model is None:
         return
 
+    # Fused decode: the NMS plugin takes the raw DFL and class logits instead of the decoded boxes and scores
+    for m in model.modules():
+        if m.__class__ in FUSED_DECODE_HEADS:
+            m.__class__.fused_decode = fused_decode
+            break
+    else:
+        if fused_decode:
+            logger.warning(f"Fused decode is not supported for {version} {head_name} models, exporting with decoded boxes.")
+
     imgsz = check_imgsz(imgsz, stride=model.stride, min_dim=2)
 
     im = torch.zeros(batch, 3, *imgsz).to(torch.device("cpu"))
@@ -218,16 +253,27 @@ def torch_export(
     model.float()
     preds = model(im)  # Warm-up run
 
+    # Runtime thresholds: [iou, score, max_boxes, score per class], negative values keep the exported thresholds
+    args, input_names = im, ['images']
+    if runtime_thresholds:
+        if head_name in RUNTIME_THRESHOLDS_HEADS:
+            head = next(m for m in model.modules() if m.__class__ in HEADS[head_name].values())
+            nms_thresholds = torch.tensor([-1.0, -1.0, -1.0] + [0.0] * head.nc)
+            model = RuntimeThresholdsModel(model, head)
+            args, input_names = (im, nms_thresholds), ['images', 'nms_thresholds']
+        else:
+            logger.warning(f"Runtime thresholds are not supported for {head_name} models, exporting with fixed thresholds.")
+
     output_path = Path(output)
     output_path.mkdir(parents=True, exist_ok=True)
     onnx_filepath = output_path / (Path(weights).stem + ".onnx")
 
     torch.onnx.export(
         model=model,
-        args=im,
+        args=args,
         f=str(onnx_filepath),
         opset_version=opset_version,
-        input_names=['images'],
+        input_names=input_names,
         output_names=OUTPUT_NAMES[head_name],
         dynamic_axes=DYNAMIC_AXES[head_name] if dynamic else None,
     )
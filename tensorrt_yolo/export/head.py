@@ -24,7 +24,7 @@
 # ==============================================================================
 import copy
 import math
-from typing import Tuple
+from typing import Optional, Tuple
 
 import torch
 import torch.nn.functional as F
@@ -162,6 +162,8 @@ class EfficientIdxNMS_TRT(torch.autograd.Function):
         score_activation: int = 0,
         class_agnostic: int = 1,
         plugin_version: str = '1',
+        nms_thresholds: Optional[Tensor] = None,
+        anchors: Optional[Tensor] = None,
     ) -> Tuple[Tensor, Tensor, Tensor, Tensor, Tensor]:
         batch_size, num_boxes, num_classes = scores.shape
         num_dets = torch.randint(0, max_output_boxes, (batch_size, 1), dtype=torch.int32)
@@ -185,11 +187,19 @@ class EfficientIdxNMS_TRT(torch.autograd.Function):
         score_activation: int = 0,
         class_agnostic: int = 1,
         plugin_version: str = '1',
+        nms_thresholds: Optional[Value] = None,
+        anchors: Optional[Value] = None,
     ) -> Tuple[Value, Value, Value, Value, Value]:
+        # The anchors input enables the box decoder, with box_coding=2 the boxes are raw DFL distributions.
+        # The runtime thresholds input replaces the threshold attributes wherever it holds non-negative values.
+        inputs = [boxes, scores]
+        if anchors is not None:
+            inputs.append(anchors)
+        if nms_thresholds is not None:
+            inputs.append(nms_thresholds)
         return g.op(
             'TRT::EfficientIdxNMS_TRT',
-            boxes,
-            scores,
+            *inputs,
             outputs=5,
             box_coding_i=box_coding,
             iou_threshold_f=iou_threshold,
@@ -199,9 +209,83 @@ class EfficientIdxNMS_TRT(torch.autograd.Function):
             score_activation_i=score_activation,
             class_agnostic_i=class_agnostic,
             plugin_version_s=plugin_version,
+            runtime_thresholds_i=int(nms_thresholds is not None),
         )
 
 
+class EfficientTopK_TRT(torch.autograd.Function):
+    """Score threshold and TopK block for NMS-free YOLO models for TensorRT."""
+
+    @staticmethod
+    def forward(
+        ctx,
+        boxes,
+        scores,
+        score_threshold: float = 0.25,
+        max_output_boxes: int = 100,
+        box_coding: int = 0,
+        score_activation: int = 0,
+        plugin_version: str = '1',
+    ) -> Tuple[Tensor, Tensor, Tensor, Tensor]:
+        batch_size, num_boxes, num_classes = scores.shape
+        num_dets = torch.randint(0, max_output_boxes, (batch_size, 1), dtype=torch.int32)
+        det_boxes = torch.randn(batch_size, max_output_boxes, 4, dtype=torch.float32)
+        det_scores = torch.randn(batch_size, max_output_boxes, dtype=torch.float32)
+        det_classes = torch.randint(0, num_classes, (batch_size, max_output_boxes), dtype=torch.int32)
+
+        return num_dets, det_boxes, det_scores, det_classes
+
+    @staticmethod
+    def symbolic(
+        g,
+        boxes,
+        scores,
+        score_threshold: float = 0.25,
+        max_output_boxes: int = 100,
+        box_coding: int = 0,
+        score_activation: int = 0,
+        plugin_version: str = '1',
+    ) -> Tuple[Value, Value, Value, Value]:
+        return g.op(
+            'TRT::EfficientTopK_TRT',
+            boxes,
+            scores,
+            outputs=4,
+            score_threshold_f=score_threshold,
+            max_output_boxes_i=max_output_boxes,
+            box_coding_i=box_coding,
+            score_activation_i=score_activation,
+            plugin_version_s=plugin_version,
+        )
+
+
+def runtime_thresholds(head: nn.Module) -> Optional[Tensor]:
+    """Returns the NMS thresholds input set on the head by runtime thresholds exports, None otherwise."""
+    return getattr(head, "nms_thresholds", None)
+
+
+def fused_decode_inputs(head: nn.Module, x) -> Tuple[Tensor, Tensor, Tensor]:
+    """
+    Returns the NMS inputs of an Ultralytics DFL head whose boxes are decoded by EfficientIdxNMS_TRT (box_coding=2).
+
+    The plugin decodes the DFL distributions and applies the sigmoid only to the candidates above the score
+    threshold, so the decoded boxes and class probabilities of every anchor are never materialized.
+
+    Returns:
+        (Tensor, Tensor, Tensor): Raw DFL logits (bs, 4 * reg_max, anchors), class logits (bs, anchors, nc) and
+            anchors (1, anchors, 3) holding the anchor point and stride, in grid cell units.
+    """
+    shape = x[0].shape  # BCHW
+    x_cat = torch.cat([xi.view(shape[0], head.no, -1) for xi in x], 2)
+    if head.dynamic or head.shape != shape:
+        head.anchors, head.strides = (x.transpose(0, 1) for x in make_anchors(x, head.stride, 0.5))
+        head.shape = shape
+
+    box, cls = x_cat.split((head.reg_max * 4, head.nc), 1)
+    anchors = torch.cat((head.anchors, head.strides), 0).transpose(0, 1).unsqueeze(0)
+    return box, cls.transpose(1, 2), anchors
+
+
 """
 ===============================================================================
         YOLOv3 and YOLOv5 Model head for detection and segmentation models
@@ -252,6 +336,23 @@ class YOLODetect(nn.Module):
         boxes, conf = z[..., :4], z[..., 4:]
         scores = conf[..., 0:1] * conf[..., 1:]
 
+        # EfficientNMS_TRT has no thresholds input, runtime thresholds use EfficientIdxNMS_TRT without the indices
+        nms_thresholds = runtime_thresholds(self)
+        if nms_thresholds is not None:
+            return EfficientIdxNMS_TRT.apply(
+                boxes,
+                scores,
+                self.iou_thres,
+                self.conf_thres,
+                self.max_det,
+                1,
+                -1,
+                0,
+                1,
+                '1',
+                nms_thresholds,
+            )[:4]
+
         return EfficientNMS_TRT.apply(boxes, scores, self.iou_thres, self.conf_thres, self.max_det)
 
     def _make_grid(self, nx=20, ny=20, i=0, torch_1_10=check_version(torch.__version__, "1.10.0")):
@@ -317,6 +418,12 @@ class YOLOSegment(YOLODetect):
             self.iou_thres,
             self.conf_thres,
             self.max_det,
+            1,
+            -1,
+            0,
+            1,
+            '1',
+            runtime_thresholds(self),
         )
 
         # Retrieve the corresponding masks using batch and detection indices.
@@ -349,6 +456,7 @@ class UltralyticsDetect(Detect):
     max_det = 100
     iou_thres = 0.45
     conf_thres = 0.25
+    fused_decode = False
 
     def forward(self, x):
         """Concatenates and returns predicted bounding boxes and class probabilities."""
@@ -357,7 +465,41 @@ class UltralyticsDetect(Detect):
 
         for i in range(self.nl):
             x[i] = torch.cat((self.cv2[i](x[i]), self.cv3[i](x[i])), 1)
+
+        # EfficientNMS_TRT has no anchors or thresholds input, these exports use EfficientIdxNMS_TRT without the indices
+        nms_thresholds = runtime_thresholds(self)
+        if self.fused_decode:
+            box, cls, anchors = fused_decode_inputs(self, x)
+            return EfficientIdxNMS_TRT.apply(
+                box,
+                cls,
+                self.iou_thres,
+                self.conf_thres,
+                self.max_det,
+                2,
+                -1,
+                1,
+                1,
+                '1',
+                nms_thresholds,
+                anchors,
+            )[:4]
+
         dbox, cls = self._inference(x)
+        if nms_thresholds is not None:
+            return EfficientIdxNMS_TRT.apply(
+                dbox.transpose(1, 2),
+                cls.transpose(1, 2),
+                self.iou_thres,
+                self.conf_thres,
+                self.max_det,
+                1,
+                -1,
+                0,
+                1,
+                '1',
+                nms_thresholds,
+            )[:4]
 
         # Using transpose for compatibility with EfficientNMS_TRT
         return EfficientNMS_TRT.apply(
@@ -374,10 +516,14 @@ class UltralyticsDetect(Detect):
         one2one = [torch.cat((self.one2one_cv2[i](x_detach[i]), self.one2one_cv3[i](x_detach[i])), 1) for i in range(self.nl)]
 
         dbox, cls = self._inference(one2one)
-        y = torch.cat((dbox, cls), 1)
-        det_boxes, det_scores, det_classes = self.postprocess(y.permute(0, 2, 1), self.max_det, self.nc)
-        num_dets = (det_scores >= self.conf_thres).sum(dim=1, keepdim=True).int()
-        return num_dets, det_boxes, det_scores, det_classes
+        # One-to-one heads need no NMS, only the score threshold and the top max_det scores of each image. End-to-end
+        # heads decode boxes as corners.
+        return EfficientTopK_TRT.apply(
+            dbox.transpose(1, 2),
+            cls.transpose(1, 2),
+            self.conf_thres,
+            self.max_det,
+        )
 
     def _inference(self, x):
         """Decode predicted bounding boxes and class probabilities based on multiple-level feature maps."""
@@ -393,35 +539,6 @@ class UltralyticsDetect(Detect):
 
         return dbox, cls.sigmoid()
 
-    @staticmethod
-    def postprocess(preds: torch.Tensor, max_det: int, nc: int = 80):
-        """
-        Post-processes YOLO model predictions.
-
-        Args:
-            preds (torch.Tensor): Raw predictions with shape (batch_size, num_anchors, 4 + nc) with last dimension
-                format [x, y, w, h, class_probs].
-            max_det (int): Maximum detections per image.
-            nc (int, optional): Number of classes. Default: 80.
-
-        Returns:
-            (torch.Tensor, torch.Tensor, torch.Tensor): Processed predictions with shapes:
-                - boxes (torch.Tensor): Shape (batch_size * min(max_det, num_anchors), 4) with last dimension
-                    format [x, y, w, h].
-                - scores (torch.Tensor): Shape (batch_size * min(max_det, anchors),) with values representing
-                    the max class probability for each detection.
-                - class_index (torch.Tensor): Shape (batch_size * min(max_det, anchors),) with values representing
-                    the index of the class with the max probability for each detection.
-        """
-        batch_size, anchors, _ = preds.shape  # i.e. shape(16,8400,84)
-        boxes, scores = preds.split([4, nc], dim=-1)
-        index = scores.amax(dim=-1).topk(min(max_det, anchors))[1].unsqueeze(-1)
-        boxes = boxes.gather(dim=1, index=index.repeat(1, 1, 4))
-        scores = scores.gather(dim=1, index=index.repeat(1, 1, nc))
-        scores, index = scores.flatten(1).topk(min(max_det, anchors))
-        i = torch.arange(batch_size)[..., None]  # batch indices
-        return boxes[i, index // nc], scores, (index % nc).to(torch.int32)
-
 
 class UltralyticsOBB(OBB):
     """Ultralytics OBB detection head for detection with rotation models."""
@@ -469,6 +586,7 @@ class UltralyticsSegment(Segment):
     max_det = 100
     iou_thres = 0.45
     conf_thres = 0.25
+    fused_decode = False
 
     def forward(self, x):
         """Return model outputs and mask coefficients if training, otherwise return outputs and mask coefficients."""
@@ -478,15 +596,29 @@ class UltralyticsSegment(Segment):
 
         # Detect forward
         x = [torch.cat((self.cv2[i](x[i]), self.cv3[i](x[i])), 1) for i in range(self.nl)]
-        dbox, cls = self._inference(x)
+        if self.fused_decode:
+            # The plugin decodes the DFL boxes and applies the sigmoid to the candidates above the score threshold only
+            boxes, scores, anchors = fused_decode_inputs(self, x)
+            box_coding, score_activation = 2, 1
+        else:
+            ## Using transpose for compatibility with EfficientIdxNMS_TRT
+            dbox, cls = self._inference(x)
+            boxes, scores, anchors = dbox.transpose(1, 2), cls.transpose(1, 2), None
+            box_coding, score_activation = 1, 0
 
-        ## Using transpose for compatibility with EfficientIdxNMS_TRT
         num_dets, det_boxes, det_scores, det_classes, det_indices = EfficientIdxNMS_TRT.apply(
-            dbox.transpose(1, 2),
-            cls.transpose(1, 2),
+            boxes,
+            scores,
             self.iou_thres,
             self.conf_thres,
             self.max_det,
+            box_coding,
+            -1,
+            score_activation,
+            1,
+            '1',
+            runtime_thresholds(self),
+            anchors,
         )
 
         # Retrieve the corresponding masks using batch and detection indices.
@@ -526,6 +658,7 @@ class UltralyticsPose(Pose):
     max_det = 100
     iou_thres = 0.45
     conf_thres = 0.25
+    fused_decode = False
 
     def forward(self, x):
         """Perform forward pass through YOLO model and return predictions."""
@@ -534,15 +667,29 @@ class UltralyticsPose(Pose):
 
         # Detect forward
         x = [torch.cat((self.cv2[i](x[i]), self.cv3[i](x[i])), 1) for i in range(self.nl)]
-        dbox, cls = self._inference(x)
+        if self.fused_decode:
+            # The plugin decodes the DFL boxes and applies the sigmoid to the candidates above the score threshold only
+            boxes, scores, anchors = fused_decode_inputs(self, x)
+            box_coding, score_activation = 2, 1
+        else:
+            ## Using transpose for compatibility with EfficientIdxNMS_TRT
+            dbox, cls = self._inference(x)
+            boxes, scores, anchors = dbox.transpose(1, 2), cls.transpose(1, 2), None
+            box_coding, score_activation = 1, 0
 
-        ## Using transpose for compatibility with EfficientIdxNMS_TRT
         num_dets, det_boxes, det_scores, det_classes, det_indices = EfficientIdxNMS_TRT.apply(
-            dbox.transpose(1, 2),
-            cls.transpose(1, 2),
+            boxes,
+            scores,
             self.iou_thres,
             self.conf_thres,
             self.max_det,
+            box_coding,
+            -1,
+            score_activation,
+            1,
+            '1',
+            runtime_thresholds(self),
+            anchors,
         )
 
         batch_indices = (
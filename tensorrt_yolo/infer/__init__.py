@@ -1,6 +1,7 @@
 from .inference import DeployCGDet, DeployCGOBB, DeployCGPose, DeployCGSeg, DeployDet, DeployOBB, DeployPose, DeploySeg
+from .profiler import LayerProfiler
 from .result import Box, DetResult, KeyPoint, OBBResult, PoseResult, RotatedBox, SegResult
-from .timer import CpuTimer, GpuTimer
+from .timer import CpuTimer, DeferredGpuTimer, GpuTimer
 from .utils import generate_labels_with_colors, image_batches, visualize
 
 __all__ = [
@@ -12,6 +13,7 @@ __all__ = [
     "DeployOBB",
     "DeployPose",
     "DeploySeg",
+    "LayerProfiler",
     "Box",
     "DetResult",
     "KeyPoint",
@@ -20,6 +22,7 @@ __all__ = [
     "RotatedBox",
     "SegResult",
     "CpuTimer",
+    "DeferredGpuTimer",
     "GpuTimer",
     "generate_labels_with_colors",
     "image_batches",
@@ -23,9 +23,10 @@
 # Desc    :   Classes for deploying YOLO models, including
 #             detection, OBB, segmentation and pose estimation.
 # ==============================================================================
-from typing import Any, List, Union
+from typing import Any, List, Optional, Union
 
 from .. import c_lib_wrap as C
+from .profiler import LayerProfiler
 from .result import DetResult, OBBResult, PoseResult, SegResult
 
 __all__ = ["DeployDet", "DeployCGDet", "DeployOBB", "DeployCGOBB", "DeploySeg", "DeployCGSeg", "DeployPose", "DeployCGPose"]
@@ -69,6 +70,87 @@ class BaseDeploy:
         """
         return self._model.predict(images)
 
+    def stats(self) -> List[Any]:
+        """
+        Get the latency distribution of each pipeline stage recorded so far.
+
+        Device stages are resolved lazily from CUDA events, so the most recent batch may not be included yet.
+
+        Returns:
+            List[Any]: StageStats objects with the stage name and its count, min, mean, max, p50, p90, p99 and p999 latencies in milliseconds.
+        """
+        return self._model.stats()
+
+    def reset_stats(self) -> None:
+        """
+        Discard all recorded stage latencies.
+        """
+        self._model.reset_stats()
+
+    def set_stats_enabled(self, enabled: bool) -> None:
+        """
+        Enable or disable the collection of stage latencies. Enabled by default.
+
+        Args:
+            enabled (bool): True to collect stage latencies.
+        """
+        self._model.set_stats_enabled(enabled)
+
+    def set_nvtx_enabled(self, enabled: bool) -> None:
+        """
+        Enable or disable the emission of NVTX ranges for each pipeline stage. Disabled by default.
+
+        Args:
+            enabled (bool): True to emit NVTX ranges.
+        """
+        self._model.set_nvtx_enabled(enabled)
+
+    def set_profiler(self, profiler: Optional[LayerProfiler]) -> None:
+        """
+        Attach a layer profiler to the execution context, or detach it with None.
+
+        TensorRT reports per-layer execution times after each inference, which slows inference down,
+        so the profiler should only be attached while profiling. Not supported by CUDA graph models.
+
+        Args:
+            profiler (Optional[LayerProfiler]): The layer profiler, or None to detach.
+        """
+        self._model.set_profiler(profiler._profiler if profiler is not None else None)
+
+    def set_postprocess_threads(self, threads: int) -> None:
+        """
+        Post-process the images of a batch on an internal thread pool instead of the calling thread.
+
+        Results keep the order of the batch. Worth enabling for segmentation and pose models with large batches,
+        where decoding the outputs on the host can take longer than the inference itself.
+
+        Args:
+            threads (int): Total number of threads, counting the calling thread. 1 or less post-processes serially.
+        """
+        self._model.set_postprocess_threads(threads)
+
+    def set_thresholds(
+        self,
+        score_threshold: float = -1.0,
+        iou_threshold: float = -1.0,
+        max_boxes: int = -1,
+        class_score_thresholds: Optional[List[float]] = None,
+    ) -> None:
+        """
+        Update the NMS thresholds of an engine exported with `--runtime_thresholds`, without rebuilding it.
+
+        Negative values keep the thresholds the engine was exported with. The number of boxes can only be
+        lowered, since the outputs are sized for the exported value.
+
+        Args:
+            score_threshold (float): Score threshold.
+            iou_threshold (float): IoU threshold.
+            max_boxes (int): Maximum number of detections per image.
+            class_score_thresholds (Optional[List[float]]): Score threshold of each class, applied when higher
+                than score_threshold. Defaults to None.
+        """
+        self._model.set_thresholds(score_threshold, iou_threshold, max_boxes, class_score_thresholds or [])
+
 
 class DeployDet(BaseDeploy):
     def __init__(self, engine_file: str, cuda_memory: bool = False, device: int = 0) -> None:
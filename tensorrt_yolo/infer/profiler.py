@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+# -*-coding:utf-8 -*-
+# ==============================================================================
+# Copyright (c) 2024 laugh12321 Authors. All Rights Reserved.
+#
+# Licensed under the GNU General Public License v3.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.gnu.org/licenses/gpl-3.0.html
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+# File    :   profiler.py
+# Version :   5.0.0
+# Author  :   laugh12321
+# Contact :   laugh12321@vip.qq.com
+# Date    :   2024/07/05 13:39:01
+# Desc    :   Python bindings for the TensorRT per-layer profiler using Pybind11.
+# ==============================================================================
+from typing import List
+
+from .. import c_lib_wrap as C
+
+__all__ = ["LayerProfiler"]
+
+
+class LayerProfiler:
+    """
+    Class to interface with the LayerProfiler implemented in C++.
+
+    Attach it to a non CUDA graph model with `set_profiler` to accumulate per-layer execution times.
+    A new run starts whenever a layer is reported again, the first `max_trace_runs` runs are kept
+    for the Chrome trace export while the aggregated timings cover every run.
+    """
+
+    def __init__(self, max_trace_runs: int = 100) -> None:
+        """
+        Initialize the LayerProfiler.
+
+        Args:
+            max_trace_runs (int, optional): Maximum number of runs kept for the Chrome trace export. Defaults to 100.
+        """
+        self._profiler = C.inference.LayerProfiler(max_trace_runs)
+
+    def report_layer_time(self, layer_name: str, ms: float) -> None:
+        """
+        Record the execution time of a layer, as TensorRT does after each inference.
+
+        Args:
+            layer_name (str): Name of the layer.
+            ms (float): Execution time in milliseconds.
+        """
+        self._profiler.report_layer_time(layer_name, ms)
+
+    def reset(self) -> None:
+        """
+        Discard all recorded runs.
+        """
+        self._profiler.reset()
+
+    def runs(self) -> int:
+        """
+        Get the number of runs recorded so far.
+
+        Returns:
+            int: Number of runs.
+        """
+        return self._profiler.runs()
+
+    def layers(self) -> List[C.inference.LayerTiming]:
+        """
+        Get the aggregated layer timings, sorted by total time in descending order.
+
+        Returns:
+            List[C.inference.LayerTiming]: Per-layer name, count, total, mean, min and max in milliseconds.
+        """
+        return self._profiler.layers()
+
+    def table(self) -> str:
+        """
+        Get the aggregated layer timings as a text table sorted by total time.
+
+        Returns:
+            str: The formatted table.
+        """
+        return self._profiler.table()
+
+    def chrome_trace(self) -> str:
+        """
+        Get the recorded runs as a Chrome trace_event JSON document.
+
+        Returns:
+            str: JSON document loadable in chrome://tracing or Perfetto.
+        """
+        return self._profiler.chrome_trace()
+
+    def export_chrome_trace(self, file: str) -> None:
+        """
+        Write the recorded runs as a Chrome trace_event JSON document.
+
+        Args:
+            file (str): Path of the JSON file to write.
+        """
+        self._profiler.export_chrome_trace(file)
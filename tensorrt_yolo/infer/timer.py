@@ -20,11 +20,11 @@
 # Author  :   laugh12321
 # Contact :   laugh12321@vip.qq.com
 # Date    :   2024/07/05 13:39:01
-# Desc    :   Python bindings for CpuTimer and GpuTimer using Pybind11.
+# Desc    :   Python bindings for CpuTimer, GpuTimer and DeferredGpuTimer using Pybind11.
 # ==============================================================================
 from .. import c_lib_wrap as C
 
-__all__ = ["CpuTimer", "GpuTimer"]
+__all__ = ["CpuTimer", "GpuTimer", "DeferredGpuTimer"]
 
 
 class CpuTimer:
@@ -132,3 +132,96 @@ class GpuTimer:
             float: Elapsed time in microseconds.
         """
         return self._timer.microseconds()
+
+
+class DeferredGpuTimer:
+    """
+    Class to interface with the DeferredGpuTimer implemented in C++.
+
+    Unlike GpuTimer, stopping the timer does not wait for the GPU. Elapsed times are resolved
+    lazily once the recorded events have completed, so call `collect` or `flush` before reading them.
+    """
+
+    def __init__(self, capacity: int = 64) -> None:
+        """
+        Initialize the DeferredGpuTimer.
+
+        Args:
+            capacity (int, optional): Number of start/stop pairs that may be in flight. Defaults to 64.
+        """
+        self._timer = C.timer.DeferredGpuTimer(capacity)
+
+    def start(self) -> None:
+        """
+        Start a new timing pair.
+        """
+        self._timer.start()
+
+    def stop(self) -> None:
+        """
+        Stop the current timing pair without waiting for the GPU.
+        """
+        self._timer.stop()
+
+    def reset(self) -> None:
+        """
+        Discard pending pairs and all aggregated samples.
+        """
+        self._timer.reset()
+
+    def collect(self) -> None:
+        """
+        Resolve every pending pair whose events have completed, without blocking.
+        """
+        self._timer.collect()
+
+    def flush(self) -> None:
+        """
+        Wait for and resolve every pending pair.
+        """
+        self._timer.flush()
+
+    def pending(self) -> int:
+        """
+        Get the number of pairs recorded but not resolved yet.
+
+        Returns:
+            int: Number of pending pairs.
+        """
+        return self._timer.pending()
+
+    def summary(self) -> C.timer.LatencySummary:
+        """
+        Get the distribution of the resolved elapsed times.
+
+        Returns:
+            LatencySummary: Count, total, min, mean, max, p50, p90, p99 and p999 in milliseconds.
+        """
+        return self._timer.summary()
+
+    def seconds(self) -> float:
+        """
+        Get the accumulated time of the resolved pairs in seconds.
+
+        Returns:
+            float: Elapsed time in seconds.
+        """
+        return self._timer.seconds()
+
+    def milliseconds(self) -> float:
+        """
+        Get the accumulated time of the resolved pairs in milliseconds.
+
+        Returns:
+            float: Elapsed time in milliseconds.
+        """
+        return self._timer.milliseconds()
+
+    def microseconds(self) -> float:
+        """
+        Get the accumulated time of the resolved pairs in microseconds.
+
+        Returns:
+            float: Elapsed time in microseconds.
+        """
+        return self._timer.microseconds()
@@ -231,30 +231,32 @@ def visualize(
 
         # keypoint
         if isinstance(result, PoseResult):
-            nkpt = len(result.kpts[i])
+            kpts = result.kpts[i]  # (nkpt, ndim) view of the key points, ndim is 2 (x, y) or 3 (x, y, conf)
+            nkpt = result.nkpt
             is_pose = nkpt == 17
             kpt_line = is_pose  # `kpt_line=True` for now only supports human pose plotting
-            for kpt in result.kpts[i]:
-                if kpt.x % width != 0 and kpt.y % height != 0:
-                    if kpt.conf is not None and kpt.conf < conf_thres:
+            for kpt in kpts:
+                x, y = kpt[0], kpt[1]
+                if x % width != 0 and y % height != 0:
+                    if result.ndim == 3 and kpt[2] < conf_thres:
                         continue
-                    cv2.circle(img, (int(kpt.x), int(kpt.y)), radius, color, -1, lineType=cv2.LINE_AA)
+                    cv2.circle(img, (int(x), int(y)), radius, color, -1, lineType=cv2.LINE_AA)
 
             if kpt_line:
                 for sk in skeleton:
-                    kpt1 = result.kpts[i][sk[0] - 1]
-                    kpt2 = result.kpts[i][sk[1] - 1]
+                    kpt1 = kpts[sk[0] - 1]
+                    kpt2 = kpts[sk[1] - 1]
 
-                    if kpt1.conf < conf_thres or kpt2.conf < conf_thres:
+                    if result.ndim == 3 and (kpt1[2] < conf_thres or kpt2[2] < conf_thres):
                         continue
-                    if kpt1.x % width == 0 or kpt1.y % height == 0 or kpt1.x < 0 or kpt1.y < 0:
+                    if kpt1[0] % width == 0 or kpt1[1] % height == 0 or kpt1[0] < 0 or kpt1[1] < 0:
                         continue
-                    if kpt2.x % width == 0 or kpt2.y % height == 0 or kpt2.x < 0 or kpt2.y < 0:
+                    if kpt2[0] % width == 0 or kpt2[1] % height == 0 or kpt2[0] < 0 or kpt2[1] < 0:
                         continue
                     cv2.line(
                         img,
-                        (int(kpt1.x), int(kpt1.y)),
-                        (int(kpt2.x), int(kpt2.y)),
+                        (int(kpt1[0]), int(kpt1[1])),
+                        (int(kpt2[0]), int(kpt2[1])),
                         color,
                         thickness=int(np.ceil(lw / 2)),
                         lineType=cv2.LINE_AA,
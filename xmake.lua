@@ -58,6 +58,11 @@ function common_config(target)
 
     -- 添加TensorRT链接目录和链接库
     configure_tensorrt(target)
+
+    -- 后处理线程池使用 std::thread
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
 end
 
 includes("plugin/xmake.lua")